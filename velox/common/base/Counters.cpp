@@ -437,6 +437,35 @@ void registerVeloxMetrics() {
       99,
       100);
 
+  // The number of proactive arbitration runs which reclaim memory ahead of
+  // demand when the arbitrator's free capacity falls below its watermark.
+  DEFINE_METRIC(
+      kMetricArbitratorProactiveArbitrationCount,
+      facebook::velox::StatType::COUNT);
+
+  // The reclaimed bytes distribution of a proactive arbitration run in range of
+  // [0, 32GB] with 64 buckets. It is configured to report the reclaimed bytes
+  // at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorProactiveArbitrationBytes,
+      512L << 20,
+      0,
+      32L << 30,
+      50,
+      90,
+      99,
+      100);
+
+  // The bytes evicted from the cache by the arbitrator to make room for the
+  // query memory.
+  DEFINE_METRIC(
+      kMetricArbitratorCacheShrinkBytes, facebook::velox::StatType::SUM);
+
+  // Tracks the average of the cache target size in bytes set by the arbitrator
+  // from the query memory demand and the cache hit ratio.
+  DEFINE_METRIC(
+      kMetricArbitratorCacheTargetBytes, facebook::velox::StatType::AVG);
+
   // The number of times that an arbitration operation wait for global
   // arbitration to free up memory.
   DEFINE_METRIC(
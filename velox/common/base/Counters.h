@@ -104,6 +104,18 @@ constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationBytes{
 constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationTimeMs{
     "velox.arbitrator_global_arbitration_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorProactiveArbitrationCount{
+    "velox.arbitrator_proactive_arbitration_count"};
+
+constexpr folly::StringPiece kMetricArbitratorProactiveArbitrationBytes{
+    "velox.arbitrator_proactive_arbitration_bytes"};
+
+constexpr folly::StringPiece kMetricArbitratorCacheShrinkBytes{
+    "velox.arbitrator_cache_shrink_bytes"};
+
+constexpr folly::StringPiece kMetricArbitratorCacheTargetBytes{
+    "velox.arbitrator_cache_target_bytes"};
+
 constexpr folly::StringPiece kMetricArbitratorGlobalArbitrationWaitCount{
     "velox.arbitrator_global_arbitration_wait_count"};
 
@@ -47,6 +47,22 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  SelectivityInfo& operator+=(const SelectivityInfo& other) {
+    numIn_ += other.numIn_;
+    numOut_ += other.numOut_;
+    timeClocks_ += other.timeClocks_;
+    return *this;
+  }
+
+  /// Returns what was accumulated in 'this' after it was equal to 'earlier'.
+  SelectivityInfo operator-(const SelectivityInfo& earlier) const {
+    SelectivityInfo delta;
+    delta.numIn_ = numIn_ - earlier.numIn_;
+    delta.numOut_ = numOut_ - earlier.numOut_;
+    delta.timeClocks_ = timeClocks_ - earlier.timeClocks_;
+    return delta;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -23,6 +23,10 @@
 #include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
+namespace facebook::velox::memory {
+class MemoryPool;
+}
+
 namespace facebook::velox::common {
 
 #define VELOX_SPILL_LIMIT_EXCEEDED(errorMessage)                    \
@@ -72,7 +76,9 @@ struct SpillConfig {
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
       std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _asyncIoEnabled = false,
+      bool _rowFormatEnabled = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -89,6 +95,13 @@ struct SpillConfig {
     return prefixSortConfig.has_value();
   }
 
+  /// Returns the executor to write spill files asynchronously and read ahead
+  /// spilled batches. Returns nullptr if async spill io is disabled or there
+  /// is no spill executor.
+  folly::Executor* asyncIoExecutor() const {
+    return asyncIoEnabled ? executor : nullptr;
+  }
+
   /// A callback function that returns the spill directory path. Implementations
   /// can use it to ensure the path exists before returning.
   GetSpillDirectoryPathCB getSpillDirPathCb;
@@ -157,5 +170,25 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true and 'executor' is set, spill files are written asynchronously on
+  /// 'executor' which overlaps the serialization of the next write buffer with
+  /// the write of the previous one. The spill readers also read and
+  /// deserialize the next batch of each spill file ahead on 'executor'.
+  bool asyncIoEnabled{false};
+
+  /// If true, the spillers which restore the spilled rows into a RowContainer
+  /// spill them in the RowContainer's serialized row layout (see
+  /// RowContainer::extractSerializedRows()) instead of extracting them into
+  /// columns. The restore then copies each row back into the RowContainer
+  /// without decoding and re-storing the columns. This currently applies to
+  /// the hash join build table spilling.
+  bool rowFormatEnabled{false};
+
+  /// The thread-safe memory pool that the batches read ahead on
+  /// asyncIoExecutor() are allocated from. Set by the operator to a leaf pool
+  /// under its plan node pool, so that the batches are charged to the query.
+  /// The spill readers do not read ahead if it is not set.
+  memory::MemoryPool* readAheadPool{nullptr}; // Not owned.
 };
 } // namespace facebook::velox::common
@@ -349,6 +349,11 @@ void updateGlobalSpillDeserializationTimeNs(uint64_t timeNs) {
   localSpillStats().wlock()->spillDeserializationTimeNanos += timeNs;
 }
 
+void updateGlobalSpillWriteTimeNs(uint64_t timeNs) {
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricSpillWriteTimeMs, timeNs / 1'000'000);
+  localSpillStats().wlock()->spillWriteTimeNanos += timeNs;
+}
+
 SpillStats globalSpillStats() {
   SpillStats gSpillStats;
   for (auto& spillStats : allSpillStats()) {
@@ -167,6 +167,10 @@ void updateGlobalMaxSpillLevelExceededCount(
 /// Increments the spill read deserialization time.
 void updateGlobalSpillDeserializationTimeNs(uint64_t timeNs);
 
+/// Increments the spill write time of the asynchronous disk writes which are
+/// not accounted by updateGlobalSpillWriteStats().
+void updateGlobalSpillWriteTimeNs(uint64_t timeNs);
+
 /// Gets the cumulative global spill stats.
 SpillStats globalSpillStats();
 } // namespace facebook::velox::common
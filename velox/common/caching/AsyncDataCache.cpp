@@ -19,6 +19,8 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/caching/SsdFile.h"
 
+#include <folly/ScopeGuard.h>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/StatsReporter.h"
@@ -39,6 +41,16 @@ namespace facebook::velox::cache {
 using memory::MachinePageCount;
 using memory::MemoryAllocator;
 
+namespace {
+// Admission frequency of an allocation which is not for a new cache entry.
+constexpr int32_t kNoAdmissionCandidate = -1;
+
+// The access frequency of the key of the new cache entry which this thread is
+// allocating memory for. The allocation evicts from the cache on the same
+// thread, where the frequency decides on the TinyLFU admission.
+thread_local int32_t admissionCandidateFrequency{kNoAdmissionCandidate};
+} // namespace
+
 AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
   accessStats_.reset();
 }
@@ -167,6 +179,7 @@ CachePin CacheShard::findOrCreate(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
+  int32_t admissionFrequency{kNoAdmissionCandidate};
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
@@ -183,6 +196,9 @@ CachePin CacheShard::findOrCreate(
 
       if (foundEntry->size() >= size) {
         foundEntry->touch();
+        // The first use of a prefetched entry is not a reuse.
+        recordAccessLocked(
+            key, foundEntry->isPrefetch() ? nullptr : foundEntry);
         // The entry is in a readable state. Add a pin.
         if (foundEntry->isPrefetch()) {
           foundEntry->isFirstUse_ = true;
@@ -212,10 +228,13 @@ CachePin CacheShard::findOrCreate(
       entryMap_.erase(it);
     }
 
+    admissionFrequency = recordAccessLocked(key, nullptr);
     auto newEntry = getFreeEntry();
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    newEntry->isProtected_ = false;
+    newEntry->lowReuse_ = false;
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -231,7 +250,60 @@ CachePin CacheShard::findOrCreate(
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
   }
-  return initEntry(key, entryToInit);
+  return initEntry(key, entryToInit, admissionFrequency);
+}
+
+int32_t CacheShard::recordAccessLocked(
+    RawFileCacheKey key,
+    AsyncDataCacheEntry* entry) {
+  if (sketch_ == nullptr) {
+    return kNoAdmissionCandidate;
+  }
+  const auto hash = std::hash<RawFileCacheKey>()(key);
+  sketch_->ensureCapacity(entries_.size());
+  sketch_->record(hash);
+  const auto frequency = sketch_->estimate(hash);
+  if (entry == nullptr || entry->isProtected_) {
+    return frequency;
+  }
+  // A hit on an entry in probation promotes it unless the reader expects
+  // little reuse of it. Such entries must earn their place by being accessed
+  // repeatedly.
+  if (entry->lowReuse_ && frequency < kLowReusePromoteFrequency) {
+    return frequency;
+  }
+  entry->isProtected_ = true;
+  protectedBytes_ += entry->size_;
+  ++numPromote_;
+  return frequency;
+}
+
+void CacheShard::demoteLocked(AsyncDataCacheEntry* entry) {
+  if (!entry->isProtected_) {
+    return;
+  }
+  entry->isProtected_ = false;
+  VELOX_CHECK_GE(protectedBytes_, entry->size_);
+  protectedBytes_ -= entry->size_;
+}
+
+bool CacheShard::losesToCandidateLocked(
+    const AsyncDataCacheEntry* entry,
+    int32_t candidateFrequency) const {
+  VELOX_CHECK_NOT_NULL(sketch_);
+  VELOX_CHECK(!entry->isProtected_);
+  VELOX_CHECK_NE(candidateFrequency, kNoAdmissionCandidate);
+  // The victim gives way to the new entry unless its key is accessed more
+  // often. The new entry is already allocated for, so on a tie the victim goes
+  // and the new entry competes as the next victim.
+  return candidateFrequency >=
+      sketch_->estimate(std::hash<RawFileCacheKey>()(RawFileCacheKey{
+          entry->key_.fileNum.id(), entry->key_.offset}));
+}
+
+uint64_t CacheShard::maxProtectedBytes() const {
+  return memory::AllocationTraits::pageBytes(cache_->cachedPages()) /
+      cache_->numShards() * protectedPct_ / 100;
 }
 
 void CacheShard::makeEvictable(RawFileCacheKey key) {
@@ -240,6 +312,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
   if (it == entryMap_.end()) {
     return;
   }
+  demoteLocked(it->second);
   it->second->makeEvictable();
 }
 
@@ -255,14 +328,24 @@ bool CacheShard::exists(RawFileCacheKey key) const {
 
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
-    AsyncDataCacheEntry* entry) {
+    AsyncDataCacheEntry* entry,
+    int32_t admissionFrequency) {
   // The new entry is in the map and is in exclusive mode and is otherwise
   // uninitialized. Other threads may find it and may add a promise or wait for
   // a promise that another one has added. The new entry is otherwise volatile
   // and uninterpretable except for this thread. Non access serializing members
   // can be set outside of 'mutex_'.
-  entry->initialize(
-      FileCacheKey{StringIdLease(fileIds(), key.fileNum), key.offset});
+  {
+    // The eviction to make space for the entry runs on this thread inside
+    // the allocation, where it compares the victims with the new entry.
+    const auto prevFrequency =
+        std::exchange(admissionCandidateFrequency, admissionFrequency);
+    SCOPE_EXIT {
+      admissionCandidateFrequency = prevFrequency;
+    };
+    entry->initialize(
+        FileCacheKey{StringIdLease(fileIds(), key.fileNum), key.offset});
+  }
   cache_->incrementNew(entry->size());
   CachePin pin;
   pin.setEntry(entry);
@@ -340,6 +423,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  demoteLocked(entry);
   if (entry->key_.fileNum.hasValue()) {
     const auto it = entryMap_.find(
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
@@ -375,6 +459,12 @@ uint64_t CacheShard::evict(
   const bool skipSsdSaveable =
       (ssdCache != nullptr) && ssdCache->writeInProgress();
   auto now = accessTime();
+  // The access frequency of the key of the new entry being allocated for, if
+  // any. With TinyLFU, a probation entry is evicted to admit it only if it is
+  // not accessed more often, otherwise the eviction falls back to the score.
+  const auto candidateFrequency = sketch_ == nullptr
+      ? kNoAdmissionCandidate
+      : admissionCandidateFrequency;
   std::vector<memory::Allocation> toFree;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
@@ -405,6 +495,17 @@ uint64_t CacheShard::evict(
       }
 
       ++numChecked;
+      if (candidate->isProtected_ && !evictAllUnpinned) {
+        // The protected segment is retained while it is within its size
+        // limit. Above the limit, the entry goes back to probation where its
+        // score decides on the next pass.
+        if (protectedBytes_ > maxProtectedBytes()) {
+          demoteLocked(candidate);
+          ++numDemote_;
+        }
+        continue;
+      }
+
       if (evictionThreshold_ == kNoThreshold ||
           eventCounter_ > entries_.size() / 4 ||
           numChecked > entries_.size() / 8) {
@@ -417,7 +518,9 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (candidateFrequency != kNoAdmissionCandidate
+                ? losesToCandidateLocked(candidate, candidateFrequency)
+                : (score = candidate->score(now)) >= evictionThreshold_))) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -425,6 +528,7 @@ uint64_t CacheShard::evict(
         if (candidate->ssdSaveable()) {
           ++numSavableEvict_;
         }
+        demoteLocked(candidate);
         largeEvicted += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
@@ -536,6 +640,10 @@ void CacheShard::updateStats(CacheStats& stats) {
       stats.prefetchBytes += entry->size();
     }
 
+    if (entry->isProtected_) {
+      stats.protectedBytes += entry->size();
+    }
+
     ++stats.numEntries;
     stats.tinySize += entry->tinyData_.size();
     stats.tinyPadding += entry->tinyData_.capacity() - entry->tinyData_.size();
@@ -554,9 +662,18 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numPromote += numPromote_;
+  stats.numDemote += numDemote_;
   stats.allocClocks += allocClocks_;
 }
 
+void CacheShard::addLookupStats(uint64_t& numLookups, uint64_t& numHits)
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  numLookups += numHit_ + numNew_;
+  numHits += numHit_;
+}
+
 void CacheShard::appendSsdSaveable(bool saveAll, std::vector<CachePin>& pins) {
   std::lock_guard<std::mutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
@@ -644,6 +761,8 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numStales = numStales - other.numStales;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numPromote = numPromote - other.numPromote;
+  result.numDemote = numDemote - other.numDemote;
   if (ssdStats != nullptr) {
     if (other.ssdStats != nullptr) {
       result.ssdStats =
@@ -669,7 +788,8 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this, opts_.maxWriteRatio, opts_.evictionPolicy, opts_.protectedPct));
   }
 }
 
@@ -868,6 +988,39 @@ uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
   return evictedBytes;
 }
 
+uint64_t AsyncDataCache::shrinkInBackground(uint64_t targetBytes) {
+  VELOX_CHECK_GT(targetBytes, 0);
+  // Saves the SSD savable entries before evicting. The shards skip them while
+  // the write is in progress.
+  if (ssdCache_ != nullptr && ssdSaveable_ > 0 && ssdCache_->startWrite()) {
+    saveToSsd();
+  }
+  uint64_t evictedBytes{0};
+  for (int shard = 0; shard < shards_.size() && evictedBytes < targetBytes;
+       ++shard) {
+    memory::Allocation unused;
+    evictedBytes += shards_[shardCounter_++ & (kShardMask)]->evict(
+        targetBytes - evictedBytes, false, 0, unused);
+    VELOX_CHECK(unused.empty());
+  }
+  if (evictedBytes > 0) {
+    allocator_->unmap(memory::AllocationTraits::numPages(evictedBytes));
+  }
+  VELOX_CACHE_LOG(INFO) << "Freed " << velox::succinctBytes(evictedBytes)
+                        << " cache memory in background with target "
+                        << velox::succinctBytes(targetBytes);
+  return evictedBytes;
+}
+
+std::pair<uint64_t, uint64_t> AsyncDataCache::lookupStats() const {
+  uint64_t numLookups{0};
+  uint64_t numHits{0};
+  for (const auto& shard : shards_) {
+    shard->addLookupStats(numLookups, numHits);
+  }
+  return {numLookups, numHits};
+}
+
 bool AsyncDataCache::canTryAllocate(
     MachinePageCount numPages,
     const memory::Allocation& acquired) const {
@@ -1020,6 +1173,27 @@ std::string CacheStats::toString() const {
   return out.str();
 }
 
+void appendEntryRanges(
+    AsyncDataCacheEntry& entry,
+    std::vector<folly::Range<char*>>& ranges) {
+  auto& data = entry.data();
+  uint64_t offsetInRuns = 0;
+  auto size = entry.size();
+  if (data.numPages() == 0) {
+    ranges.push_back(folly::Range<char*>(entry.tinyData(), size));
+    offsetInRuns = size;
+  } else {
+    for (int i = 0; i < data.numRuns(); ++i) {
+      const auto run = data.runAt(i);
+      const uint64_t bytes = run.numBytes();
+      const uint64_t readSize = std::min(bytes, size - offsetInRuns);
+      ranges.push_back(folly::Range<char*>(run.data<char>(), readSize));
+      offsetInRuns += readSize;
+    }
+  }
+  VELOX_CHECK_EQ(offsetInRuns, size);
+}
+
 CoalesceIoStats readPins(
     const std::vector<CachePin>& pins,
     int32_t maxGap,
@@ -1042,24 +1216,7 @@ CoalesceIoStats readPins(
             1, pins[index].checkedEntry()->data().numRuns());
       },
       [&](const CachePin& pin, std::vector<folly::Range<char*>>& ranges) {
-        auto* entry = pin.checkedEntry();
-        auto& data = entry->data();
-        uint64_t offsetInRuns = 0;
-        auto size = entry->size();
-        if (data.numPages() == 0) {
-          ranges.push_back(
-              folly::Range<char*>(pin.checkedEntry()->tinyData(), size));
-          offsetInRuns = size;
-        } else {
-          for (int i = 0; i < data.numRuns(); ++i) {
-            const auto run = data.runAt(i);
-            const uint64_t bytes = run.numBytes();
-            const uint64_t readSize = std::min(bytes, size - offsetInRuns);
-            ranges.push_back(folly::Range<char*>(run.data<char>(), readSize));
-            offsetInRuns += readSize;
-          }
-        }
-        VELOX_CHECK_EQ(offsetInRuns, size);
+        appendEntryRanges(*pin.checkedEntry(), ranges);
       },
       [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
         // This hack allows us to store the size of the gap in the Range,
@@ -29,6 +29,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -260,6 +261,28 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
+  /// Marks 'this' as having low expected reuse, e.g. a column that the scan
+  /// tracker sees rarely read. With CacheEvictionPolicy::kTinyLfu, such an
+  /// entry stays in the probation segment until its key is frequently
+  /// accessed.
+  void setLowReuse(bool lowReuse) {
+    lowReuse_ = lowReuse;
+  }
+
+  bool lowReuse() const {
+    return lowReuse_;
+  }
+
+  /// True if 'this' is in the protected segment of CacheEvictionPolicy::
+  /// kTinyLfu.
+  bool isProtected() const {
+    return isProtected_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -321,6 +344,14 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // True if the reader expects little reuse of 'this'. Set by the reader and
+  // cleared on initialize().
+  bool lowReuse_{false};
+
+  // True if 'this' is in the protected segment of its shard. Set and cleared
+  // inside the shard mutex.
+  bool isProtected_{false};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -510,6 +541,8 @@ struct CacheStats {
   /// Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
+  /// Total size of entries in the protected segment.
+  int64_t protectedBytes{0};
 
   /// ============= Cumulative stats =============
 
@@ -541,6 +574,11 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of entries promoted from the probation to the protected segment.
+  int64_t numPromote{0};
+  /// Number of entries moved from the protected segment back to probation
+  /// because the protected segment was over its size limit.
+  int64_t numDemote{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
@@ -550,14 +588,40 @@ struct CacheStats {
   std::string toString() const;
 };
 
+/// Policy for choosing which entries AsyncDataCache evicts.
+enum class CacheEvictionPolicy {
+  /// Evicts entries whose score() combining time since last use and use count
+  /// is above a sampled threshold.
+  kScore,
+  /// Segmented LRU with TinyLFU admission. New entries are admitted to a
+  /// probation segment and are promoted to a protected segment when hit.
+  /// When memory is needed for a new entry, a probation entry is evicted only
+  /// if its key has not been accessed more often recently than the new key,
+  /// according to a frequency sketch. A single large scan of cold data thus
+  /// does not push out the working set in the protected segment. Entries
+  /// marked lowReuse() are promoted only when their key is frequently
+  /// accessed.
+  kTinyLfu,
+};
+
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      CacheEvictionPolicy evictionPolicy = CacheEvictionPolicy::kScore,
+      int32_t protectedPct = 80)
+      : cache_(cache),
+        maxWriteRatio_(maxWriteRatio),
+        protectedPct_(protectedPct),
+        sketch_(
+            evictionPolicy == CacheEvictionPolicy::kTinyLfu
+                ? std::make_unique<FrequencySketch>()
+                : nullptr) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -605,6 +669,10 @@ class CacheShard {
   /// Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  /// Adds the number of lookups and hits in 'this' to 'numLookups' and
+  /// 'numHits'. Unlike updateStats(), this doesn't scan the entries.
+  void addLookupStats(uint64_t& numLookups, uint64_t& numHits) const;
+
   /// Appends a batch of non-saved SSD savable entries in 'this' to 'pins'. This
   /// may have to be called several times since this keeps limits on the batch
   /// to write at one time. The savable entries are pinned for read. 'pins'
@@ -630,8 +698,30 @@ class CacheShard {
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
+  // Access count from which an entry marked lowReuse() is promoted.
+  static constexpr int32_t kLowReusePromoteFrequency = 4;
+
   void calibrateThreshold();
 
+  // Records an access to 'key' in 'sketch_' and promotes 'entry' to the
+  // protected segment if warranted. 'entry' is nullptr on miss. Returns the
+  // estimated access frequency of 'key', or a negative value if there is no
+  // sketch.
+  int32_t recordAccessLocked(RawFileCacheKey key, AsyncDataCacheEntry* entry);
+
+  // Moves 'entry' from the protected segment to probation.
+  void demoteLocked(AsyncDataCacheEntry* entry);
+
+  // Returns true if 'entry' in probation is to be evicted to admit a new entry
+  // whose key has 'candidateFrequency', i.e. the key of 'entry' has not been
+  // accessed more often. Only applies with a sketch.
+  bool losesToCandidateLocked(
+      const AsyncDataCacheEntry* entry,
+      int32_t candidateFrequency) const;
+
+  // Returns the maximum size of the protected segment of 'this'.
+  uint64_t maxProtectedBytes() const;
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -640,7 +730,12 @@ class CacheShard {
   // already has the right amount of memory associated with it.
   std::unique_ptr<AsyncDataCacheEntry> getFreeEntry();
 
-  CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
+  // Initializes the new 'entry' for 'key'. 'admissionFrequency' is the
+  // access frequency of 'key' from recordAccessLocked().
+  CachePin initEntry(
+      RawFileCacheKey key,
+      AsyncDataCacheEntry* entry,
+      int32_t admissionFrequency);
 
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
@@ -648,6 +743,10 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
+  // Max percentage of the cached bytes held in the protected segment.
+  const int32_t protectedPct_;
+  // Access frequency of keys if CacheEvictionPolicy::kTinyLfu is used.
+  const std::unique_ptr<FrequencySketch> sketch_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -687,6 +786,12 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Sum of sizes of entries in the protected segment.
+  uint64_t protectedBytes_{0};
+  // Cumulative count of promotions to the protected segment.
+  uint64_t numPromote_{0};
+  // Cumulative count of demotions from the protected segment.
+  uint64_t numDemote_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -700,10 +805,14 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        CacheEvictionPolicy _evictionPolicy = CacheEvictionPolicy::kScore,
+        int32_t _protectedPct = 80)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes){};
+          minSsdSavableBytes(_minSsdSavableBytes),
+          evictionPolicy(_evictionPolicy),
+          protectedPct(_protectedPct){};
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +831,14 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// The policy for choosing entries to evict. See CacheEvictionPolicy.
+    CacheEvictionPolicy evictionPolicy;
+
+    /// With CacheEvictionPolicy::kTinyLfu, the max percentage of cached bytes
+    /// held in the protected segment. Above this, protected entries are moved
+    /// back to probation during eviction.
+    int32_t protectedPct;
   };
 
   AsyncDataCache(
@@ -761,6 +878,17 @@ class AsyncDataCache : public memory::Cache {
 
   uint64_t shrink(uint64_t targetBytes) override;
 
+  /// Evicts up to 'targetBytes' of the cold entries. If there is an SSD cache,
+  /// the pending SSD savable entries are written to SSD first and are not
+  /// evicted while the write is in progress.
+  uint64_t shrinkInBackground(uint64_t targetBytes) override;
+
+  uint64_t cachedBytes() const override {
+    return memory::AllocationTraits::pageBytes(cachedPages_);
+  }
+
+  std::pair<uint64_t, uint64_t> lookupStats() const override;
+
   memory::MemoryAllocator* allocator() const override {
     return allocator_;
   }
@@ -801,6 +929,15 @@ class AsyncDataCache : public memory::Cache {
   /// and ssd cache. Otherwise, only returns the cache stats.
   std::string toString(bool details = true) const;
 
+  /// Returns the number of pages held by cache entries.
+  memory::MachinePageCount cachedPages() const {
+    return cachedPages_;
+  }
+
+  int32_t numShards() const {
+    return shards_.size();
+  }
+
   memory::MachinePageCount incrementCachedPages(int64_t pages) {
     // The counter is unsigned and the increment is signed.
     return cachedPages_.fetch_add(pages) + pages;
@@ -942,6 +1079,12 @@ T percentile(Next next, int32_t numSamples, int percent) {
   return values.empty() ? 0 : values[(values.size() * percent) / 100];
 }
 
+/// Appends the memory ranges that hold the first 'entry.size()' bytes of the
+/// data of 'entry' to 'ranges', e.g. for reading the data with preadv.
+void appendEntryRanges(
+    AsyncDataCacheEntry& entry,
+    std::vector<folly::Range<char*>>& ranges);
+
 /// Utility function for loading multiple pins with coalesced IO. 'pins' is a
 /// vector of CachePins to fill. 'maxGap' is the largest allowed distance in
 /// bytes between the end of one entry and the start of the next. If the gap is
@@ -16,6 +16,7 @@
 
 #include "velox/common/caching/FileIds.h"
 
+#include <fmt/format.h>
 #include <gflags/gflags.h>
 
 namespace facebook::velox {
@@ -23,4 +24,13 @@ StringIdMap& fileIds() {
   static StringIdMap* ids = new StringIdMap();
   return *ids;
 }
+
+std::string fileIdentity(
+    std::string_view path,
+    std::optional<int64_t> modificationTime) {
+  if (!modificationTime.has_value()) {
+    return std::string(path);
+  }
+  return fmt::format("{}@{}", path, modificationTime.value());
+}
 } // namespace facebook::velox
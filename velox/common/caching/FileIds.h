@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 
+#include <optional>
+#include <string>
+#include <string_view>
+
 #include "velox/common/caching/StringIdMap.h"
 
 namespace facebook::velox {
@@ -21,4 +25,13 @@ namespace facebook::velox {
 // Returns a process-wide map of file path to id and id to file path.
 StringIdMap& fileIds();
 
+// Returns the string to identify the version of the file at 'path' modified at
+// 'modificationTime' in fileIds(). This is 'path' itself if the modification
+// time is not known. A file that is rewritten at the same path gets a new
+// identity so that the data cached for the previous version, including the
+// data recovered from an SSD cache checkpoint, is not returned for it.
+std::string fileIdentity(
+    std::string_view path,
+    std::optional<int64_t> modificationTime);
+
 } // namespace facebook::velox
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Seeds for deriving a hash per row from the key hash.
+constexpr uint64_t kRowSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t numItems)
+    : capacity_(bits::nextPowerOfTwo(std::max(numItems, kMinCapacity))) {
+  const auto width = capacity_ * kCountersPerItem;
+  counters_.assign(width * kDepth, 0);
+  mask_ = width - 1;
+  sampleSize_ = 10 * capacity_;
+}
+
+void FrequencySketch::ensureCapacity(uint64_t numItems) {
+  if (numItems <= 2 * capacity_) {
+    return;
+  }
+  FrequencySketch resized(numItems);
+  // The index of a key in a row of 'resized' has the index of the key in the
+  // same row of 'this' in its low bits. Copying each counter to all the
+  // indices with the same low bits keeps the estimates of all keys.
+  const auto width = mask_ + 1;
+  const auto newWidth = resized.mask_ + 1;
+  for (auto row = 0; row < kDepth; ++row) {
+    for (uint64_t i = 0; i < newWidth; ++i) {
+      resized.counters_[row * newWidth + i] =
+          counters_[row * width + (i & mask_)];
+    }
+  }
+  resized.numRecords_ = numRecords_;
+  *this = std::move(resized);
+}
+
+uint64_t FrequencySketch::index(uint64_t hash, int32_t row) const {
+  return row * (mask_ + 1) + (bits::hashMix(hash, kRowSeeds[row]) & mask_);
+}
+
+void FrequencySketch::record(uint64_t hash) {
+  for (auto row = 0; row < kDepth; ++row) {
+    auto& counter = counters_[index(hash, row)];
+    if (counter < kMaxCount) {
+      ++counter;
+    }
+  }
+  if (++numRecords_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    count = std::min<int32_t>(count, counters_[index(hash, row)]);
+  }
+  return count;
+}
+
+void FrequencySketch::age() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numRecords_ /= 2;
+}
+
+} // namespace facebook::velox::cache
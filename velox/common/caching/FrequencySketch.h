@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate access frequency of keys, used for TinyLFU style admission in
+/// AsyncDataCache. A count-min sketch of 'kDepth' rows of saturating counters
+/// indexed by independent hashes of the key. The estimate is the minimum over
+/// the rows. Each row has 8 counters per tracked key so that keys seen once
+/// rarely collide into a higher estimate. After 10 records per tracked key, all
+/// counters are halved so that the estimate reflects recent history and old
+/// popularity fades out.
+class FrequencySketch {
+ public:
+  /// Largest count kept by a counter.
+  static constexpr int32_t kMaxCount = 15;
+
+  /// Constructs a sketch for tracking about 'numItems' distinct keys.
+  explicit FrequencySketch(uint64_t numItems = 0);
+
+  /// Resizes the sketch if 'numItems' is more than twice the number of keys
+  /// the sketch was sized for. Resizing keeps the estimates of all keys.
+  void ensureCapacity(uint64_t numItems);
+
+  /// Records an access to the key with 'hash'.
+  void record(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash',
+  /// at most kMaxCount. The estimate may be higher but is never lower than
+  /// the number of accesses since the last halving.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Number of distinct keys the sketch is sized for.
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  static constexpr uint64_t kMinCapacity = 64;
+  static constexpr uint64_t kCountersPerItem = 8;
+
+  // Returns the index in 'counters_' for 'hash' in 'row'.
+  uint64_t index(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void age();
+
+  uint64_t capacity_{0};
+  // 'kDepth' rows of 'mask_ + 1' counters each.
+  std::vector<uint8_t> counters_;
+  uint64_t mask_{0};
+  // Number of records since the last halving.
+  uint64_t numRecords_{0};
+  // Number of records after which the counters are halved.
+  uint64_t sampleSize_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -67,7 +67,9 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.compressionKind,
+        config.lazyCheckpointRecovery);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
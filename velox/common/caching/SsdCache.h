@@ -41,7 +41,10 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE,
+        bool _lazyCheckpointRecovery = false)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -49,7 +52,9 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind),
+          lazyCheckpointRecovery(_lazyCheckpointRecovery){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -71,15 +76,25 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// The codec to compress the cache entries with on SSD. See
+    /// SsdFile::Config::compressionKind.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
+    /// If true, the shards recover their checkpoints in the background. See
+    /// SsdFile::Config::lazyCheckpointRecovery.
+    bool lazyCheckpointRecovery{false};
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, compression {}, lazy checkpoint recovery {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          common::compressionKindToString(compressionKind),
+          (lazyCheckpointRecovery ? "ENABLED" : "DISABLED"));
     }
   };
 
@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/SsdFile.h"
 
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Crc.h"
@@ -24,6 +26,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/testutil/TestValue.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -37,6 +40,8 @@
 DECLARE_bool(velox_ssd_odirect);
 DECLARE_bool(velox_ssd_verify_write);
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::cache {
 
 namespace {
@@ -67,6 +72,63 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+// Waits for all 'futures' to finish and rethrows the first error. The buffers
+// of an IO can only be released after it finishes.
+void waitForAll(std::vector<folly::SemiFuture<uint64_t>> futures) {
+  std::exception_ptr error;
+  for (auto& future : futures) {
+    try {
+      std::move(future).get();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Returns the data of a cache 'entry' as an IOBuf chain without copying.
+std::unique_ptr<folly::IOBuf> wrapEntry(const AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  }
+  std::unique_ptr<folly::IOBuf> result;
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), size);
+    if (result == nullptr) {
+      result = std::move(buffer);
+    } else {
+      result->prependChain(std::move(buffer));
+    }
+    bytesLeft -= size;
+  }
+  return result;
+}
+
+// Copies the first 'entry.size()' bytes of 'data' into a cache 'entry'.
+void copyToEntry(const folly::IOBuf& data, AsyncDataCacheEntry& entry) {
+  folly::io::Cursor cursor(&data);
+  if (entry.tinyData() != nullptr) {
+    cursor.pull(entry.tinyData(), entry.size());
+    return;
+  }
+  auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    cursor.pull(run.data<char>(), size);
+    bytesLeft -= size;
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -111,7 +173,12 @@ SsdFile::SsdFile(const Config& config)
       checksumEnabled_(config.checksumEnabled),
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
+      lazyCheckpointRecovery_(config.lazyCheckpointRecovery),
       shardId_(config.shardId),
+      codec_(
+          config.compressionKind == common::CompressionKind_NONE
+              ? nullptr
+              : common::compressionKindToCodec(config.compressionKind)),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
@@ -121,6 +188,14 @@ SsdFile::SsdFile(const Config& config)
   fileOptions.bufferIo = !FLAGS_velox_ssd_odirect;
   writeFile_ = fs_->openFileForWrite(fileName_, fileOptions);
   readFile_ = fs_->openFileForRead(fileName_, fileOptions);
+  const auto* localReadFile =
+      dynamic_cast<const LocalReadFile*>(readFile_.get());
+  const auto* localWriteFile =
+      dynamic_cast<const LocalWriteFile*>(writeFile_.get());
+  if (localReadFile != nullptr && localWriteFile != nullptr) {
+    readFd_ = localReadFile->fd();
+    writeFd_ = localWriteFile->fd();
+  }
 
   const uint64_t size = writeFile_->size();
   numRegions_ = std::min<int32_t>(size / kRegionSize, maxRegions_);
@@ -135,6 +210,7 @@ SsdFile::SsdFile(const Config& config)
   regionSizes_.resize(maxRegions_, 0);
   erasedRegionSizes_.resize(maxRegions_, 0);
   regionPins_.resize(maxRegions_, 0);
+  pendingRegions_.resize(maxRegions_, false);
   if (checkpointEnabled()) {
     initializeCheckpoint();
   }
@@ -144,6 +220,14 @@ SsdFile::SsdFile(const Config& config)
   }
 }
 
+SsdFile::~SsdFile() {
+  std::lock_guard<std::mutex> l(recoveryMutex_);
+  if (recoverySource_ != nullptr) {
+    recoveryCancelled_ = true;
+    recoverySource_->close();
+  }
+}
+
 void SsdFile::pinRegion(uint64_t offset) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   pinRegionLocked(offset);
@@ -196,8 +280,15 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  // Indices of the pins whose entries are stored compressed.
+  std::vector<int32_t> compressedIndices;
+  // The offset of the compressed data of each compressed pin in
+  // 'compressedData'.
+  std::vector<uint64_t> compressedOffsets(pins.size(), 0);
+  uint64_t compressedBytes = 0;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto& run = ssdPins[i].run();
+    const auto runSize = run.uncompressedSize();
     auto* entry = pins[i].checkedEntry();
     if (FOLLY_UNLIKELY(runSize < entry->size())) {
       ++stats_.readSsdErrors;
@@ -206,16 +297,33 @@ CoalesceIoStats SsdFile::load(
           succinctBytes(runSize),
           succinctBytes(entry->size()));
     }
-    totalPayloadBytes += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    if (run.compressed()) {
+      compressedIndices.push_back(i);
+      compressedOffsets[i] = compressedBytes;
+      compressedBytes += run.size();
+      totalPayloadBytes += run.size();
+    } else {
+      totalPayloadBytes += entry->size();
+    }
+    regionRead(regionIndex(run.offset()), run.size());
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
 
+  // The compressed entries are read into 'compressedData' and decompressed
+  // into their cache entries after the reads. The others are read directly
+  // into their cache entries. Both are coalesced into the same reads.
+  std::unique_ptr<char[]> compressedData;
+  if (compressedBytes > 0) {
+    compressedData = std::make_unique<char[]>(compressedBytes);
+  }
+  auto* ioUring = this->ioUring();
+  // The coalesced reads to submit together with io_uring.
+  std::vector<std::pair<uint64_t, std::vector<folly::Range<char*>>>> reads;
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  const auto stats = readPins(
+  const auto stats = coalesceIo<CachePin, folly::Range<char*>>(
       pins,
       totalPayloadBytes / pins.size() < 10000 ? 25000 : 50000,
       // Max ranges in one preadv call. Longest gap + longest cache entry are
@@ -223,13 +331,54 @@ CoalesceIoStats SsdFile::load(
       // of 1000 is safe.
       900,
       [&](int32_t index) { return ssdPins[index].run().offset(); },
+      [&](int32_t index) -> uint64_t {
+        const auto& run = ssdPins[index].run();
+        return run.compressed() ? run.size()
+                                : pins[index].checkedEntry()->size();
+      },
+      [&](int32_t index) {
+        return ssdPins[index].run().compressed()
+            ? 1
+            : std::max<int32_t>(
+                  1, pins[index].checkedEntry()->data().numRuns());
+      },
+      [&](const CachePin& pin, std::vector<folly::Range<char*>>& ranges) {
+        const auto index = &pin - pins.data();
+        const auto& run = ssdPins[index].run();
+        if (run.compressed()) {
+          ranges.push_back(folly::Range<char*>(
+              compressedData.get() + compressedOffsets[index], run.size()));
+        } else {
+          appendEntryRanges(*pin.checkedEntry(), ranges);
+        }
+      },
+      [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
+        // Stores the size of the gap in the Range without a buffer, as
+        // readPins() does.
+        ranges.push_back(folly::Range<char*>(
+            nullptr, reinterpret_cast<char*>(static_cast<uint64_t>(size))));
+      },
       [&](const std::vector<CachePin>& /*pins*/,
           int32_t /*begin*/,
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (ioUring != nullptr) {
+          reads.emplace_back(offset, buffers);
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!reads.empty()) {
+    readBatch(*ioUring, reads);
+  }
+  for (const auto index : compressedIndices) {
+    const auto& run = ssdPins[index].run();
+    copyToEntry(
+        *decompress(
+            compressedData.get() + compressedOffsets[index], run.size(), run),
+        *pins[index].checkedEntry());
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -247,8 +396,107 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::readBatch(
+    IoUring& ioUring,
+    const std::vector<std::pair<uint64_t, std::vector<folly::Range<char*>>>>&
+        reads) {
+  process::TraceContext trace("SsdFile::readBatch");
+  // The coalescing gaps are all read into one buffer.
+  size_t maxGapSize = 0;
+  for (const auto& [offset, buffers] : reads) {
+    for (const auto& buffer : buffers) {
+      if (buffer.data() == nullptr) {
+        maxGapSize = std::max(maxGapSize, buffer.size());
+      }
+    }
+  }
+  auto droppedBytes = std::make_unique<char[]>(maxGapSize);
+  std::vector<IoUring::Request> requests;
+  requests.reserve(reads.size());
+  for (const auto& [offset, buffers] : reads) {
+    IoUring::Request request{readFd_, false, offset, {}};
+    request.iovecs.reserve(buffers.size());
+    for (const auto& buffer : buffers) {
+      request.iovecs.push_back(
+          {buffer.data() != nullptr ? buffer.data() : droppedBytes.get(),
+           buffer.size()});
+    }
+    requests.push_back(std::move(request));
+  }
+  try {
+    waitForAll(ioUring.submit(std::move(requests)));
+  } catch (const std::exception& e) {
+    if (IoUring::instance() != nullptr) {
+      throw;
+    }
+    // The ring has failed. The reads are repeated with blocking IO.
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "io_uring failed, reading " << fileName_
+        << " with blocking IO: " << e.what();
+    for (const auto& [offset, buffers] : reads) {
+      read(offset, buffers);
+    }
+  }
+}
+
+std::unique_ptr<folly::IOBuf>
+SsdFile::decompress(const char* data, int32_t size, const SsdRun& run) {
+  VELOX_CHECK(run.compressed());
+  VELOX_CHECK_NOT_NULL(
+      codec_,
+      "IOERR: Compressed SSD cache entry without codec in {}",
+      fileName_);
+  const auto compressed = folly::IOBuf::wrapBufferAsValue(data, size);
+  try {
+    auto uncompressed = codec_->uncompress(&compressed, run.uncompressedSize());
+    VELOX_CHECK_EQ(
+        uncompressed->computeChainDataLength(), run.uncompressedSize());
+    return uncompressed;
+  } catch (const std::exception& e) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt compressed SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+        fileName_,
+        run.offset(),
+        run.size(),
+        e.what());
+  }
+}
+
+std::unique_ptr<folly::IOBuf> SsdFile::maybeCompress(
+    const AsyncDataCacheEntry& entry) {
+  auto it = compressionStats_.find(entry.groupId());
+  if (it == compressionStats_.end()) {
+    if (compressionStats_.size() >= kMaxCompressionStatsGroups) {
+      // Drops an arbitrary group to bound the memory. Its entries are sampled
+      // again if it is written later.
+      compressionStats_.erase(compressionStats_.begin());
+    }
+    it = compressionStats_.emplace(entry.groupId(), CompressionStats{}).first;
+  }
+  auto& groupStats = it->second;
+  if (groupStats.numSamples >= kMinCompressionSamples &&
+      groupStats.compressedBytes * 100 >
+          groupStats.uncompressedBytes * kMaxCompressedSizePct &&
+      ++groupStats.numSkipped < kCompressionSampleInterval) {
+    return nullptr;
+  }
+  groupStats.numSkipped = 0;
+
+  auto compressed = codec_->compress(wrapEntry(entry).get());
+  compressed->coalesce();
+  const auto compressedSize = compressed->length();
+  ++groupStats.numSamples;
+  groupStats.uncompressedBytes += entry.size();
+  groupStats.compressedBytes += std::min<uint64_t>(compressedSize, entry.size());
+  if (compressedSize * 100 > entry.size() * kMaxCompressedSizePct) {
+    return nullptr;
+  }
+  return compressed;
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -263,13 +511,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -340,6 +587,10 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
     tracker_.regionCleared(region);
     regionSizes_[region] = 0;
     erasedRegionSizes_[region] = 0;
+    if (pendingRegions_[region]) {
+      pendingRegions_[region] = false;
+      --numPendingRegions_;
+    }
   }
 }
 
@@ -353,9 +604,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The sizes of the entries on SSD and the compressed data of the entries
+  // that are stored compressed.
+  std::vector<uint32_t> sizes(pins.size());
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    const auto* entry = pins[i].checkedEntry();
+    sizes[i] = entry->size();
+    if (codec_ != nullptr) {
+      compressed[i] = maybeCompress(*entry);
+      if (compressed[i] != nullptr) {
+        sizes[i] = compressed[i]->length();
+      }
+    }
+  }
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -367,18 +633,19 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     uint64_t writeOffset = offset;
     int32_t writeLength = 0;
     std::vector<iovec> writeIovecs;
+    std::vector<PendingWrite> pendingWrites;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto entrySize = sizes[i];
+      const auto numIovecs =
+          compressed[i] != nullptr ? 1 : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
-        if (!write(writeOffset, writeLength, writeIovecs)) {
-          // If write fails, we return without adding the pins to the cache. The
-          // entries are unchanged.
-          return;
-        }
+        pendingWrites.push_back(
+            {static_cast<int64_t>(writeOffset),
+             writeLength,
+             std::move(writeIovecs)});
         writeIovecs.clear();
         available -= writeLength;
         writeOffset += writeLength;
@@ -387,20 +654,31 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressed[i] != nullptr) {
+        writeIovecs.push_back(
+            {compressed[i]->writableData(), compressed[i]->length()});
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
     if (writeLength > 0) {
       VELOX_CHECK(!writeIovecs.empty());
-      if (!write(writeOffset, writeLength, writeIovecs)) {
-        return;
-      }
+      pendingWrites.push_back(
+          {static_cast<int64_t>(writeOffset),
+           writeLength,
+           std::move(writeIovecs)});
       writeIovecs.clear();
       available -= writeLength;
       writeOffset += writeLength;
       writeLength = 0;
     }
+    if (!writeBatch(pendingWrites)) {
+      // If write fails, we return without adding the pins to the cache. The
+      // entries are unchanged.
+      return;
+    }
     VELOX_CHECK_GE(fileSize_, writeOffset);
 
     {
@@ -409,16 +687,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        uint32_t uncompressedSize = 0;
+        if (compressed[i] != nullptr) {
+          uncompressedSize = entry->size();
+          ++stats_.entriesCompressed;
+          stats_.bytesSavedByCompression += uncompressedSize - size;
+          compressed[i].reset();
+        }
+        const SsdRun run(offset, size, checksum, uncompressedSize);
+        entries_[std::move(key)] = run;
         if (FLAGS_velox_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -452,6 +738,45 @@ bool SsdFile::write(
   }
 }
 
+bool SsdFile::writeBatch(const std::vector<PendingWrite>& writes) {
+  const auto writeBlocking = [&]() {
+    for (const auto& write : writes) {
+      if (!this->write(write.offset, write.length, write.iovecs)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto* ioUring = this->ioUring();
+  if (ioUring == nullptr) {
+    return writeBlocking();
+  }
+
+  std::vector<IoUring::Request> requests;
+  requests.reserve(writes.size());
+  for (const auto& write : writes) {
+    requests.push_back(
+        {writeFd_, true, static_cast<uint64_t>(write.offset), write.iovecs});
+  }
+  try {
+    waitForAll(ioUring->submit(std::move(requests)));
+    return true;
+  } catch (const std::exception& e) {
+    if (IoUring::instance() == nullptr) {
+      // The ring has failed. The writes are repeated with blocking IO.
+      VELOX_SSD_CACHE_LOG(WARNING)
+          << "io_uring failed, writing " << fileName_
+          << " with blocking IO: " << e.what();
+      return writeBlocking();
+    }
+    VELOX_SSD_CACHE_LOG(ERROR)
+        << "Failed to write to SSD with io_uring, file name: " << fileName_
+        << ", writes: " << writes.size() << ", error: " << e.what();
+    ++stats_.writeSsdErrors;
+    return false;
+  }
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -465,10 +790,16 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
-  auto testData = std::make_unique<char[]>(entry.size());
+  auto testData = std::make_unique<char[]>(ssdRun.size());
   const auto rc =
-      readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
-  VELOX_CHECK_EQ(rc.size(), entry.size());
+      readFile_->pread(ssdRun.offset(), ssdRun.size(), testData.get());
+  VELOX_CHECK_EQ(rc.size(), ssdRun.size());
+  if (ssdRun.compressed()) {
+    auto uncompressed = decompress(testData.get(), ssdRun.size(), ssdRun);
+    uncompressed->coalesce();
+    testData = std::make_unique<char[]>(entry.size());
+    ::memcpy(testData.get(), uncompressed->data(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -502,8 +833,11 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.entriesRead += stats_.entriesRead;
   stats.bytesRead += stats_.bytesRead;
   stats.checkpointsRead += stats_.checkpointsRead;
+  stats.entriesRecovered += stats_.entriesRecovered;
+  stats.entriesVerifiedAfterRecovery += stats_.entriesVerifiedAfterRecovery;
   stats.entriesCached += entries_.size();
   stats.regionsCached += numRegions_;
+  stats.regionsPendingRecovery += numPendingRegions_;
   for (auto i = 0; i < numRegions_; i++) {
     stats.bytesCached += (regionSizes_[i] - erasedRegionSizes_[i]);
   }
@@ -525,11 +859,15 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
   stats.readSsdCorruptions += stats_.readSsdCorruptions;
   stats.readWithoutChecksumChecks += stats_.readWithoutChecksumChecks;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  std::fill(pendingRegions_.begin(), pendingRegions_.end(), false);
+  numPendingRegions_ = 0;
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
@@ -547,6 +885,9 @@ bool SsdFile::removeFileEntries(
     return true;
   }
 
+  // The entries of the regions pending recovery must be in 'entries_' to be
+  // removed.
+  waitForRecovery();
   std::lock_guard<std::shared_mutex> l(mutex_);
 
   int64_t entriesAgedOut = 0;
@@ -726,6 +1067,9 @@ void SsdFile::flushCheckpointFile() {
 
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
+  if (force) {
+    waitForRecovery();
+  }
   std::lock_guard<std::shared_mutex> l(mutex_);
   if (!needCheckpoint(force)) {
     return;
@@ -755,19 +1099,27 @@ void SsdFile::checkpoint(bool force) {
       truncateFile(checkpointWriteFile_.get());
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t checksumEnabled,
+      // int32_t compressionKind,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {numEntries, size, cachedBytes} per region,
+      // {fileId, offset, SSdRun} triples grouped by region,
       // kEndMarker.
       allocateCheckpointBuffer();
       SCOPE_EXIT {
         freeCheckpointBuffer();
       };
-      const auto version = checkpointVersion();
       appendToCheckpointBuffer(checkpointVersion());
+      const int32_t checksumEnabled = checksumEnabled_;
+      appendToCheckpointBuffer(checksumEnabled);
+      const int32_t compressionKind = codec_ == nullptr
+          ? common::CompressionKind_NONE
+          : common::codecTypeToCompressionKind(codec_->type());
+      appendToCheckpointBuffer(compressionKind);
       appendToCheckpointBuffer(maxRegions_);
       appendToCheckpointBuffer(numRegions_);
 
@@ -786,15 +1138,45 @@ void SsdFile::checkpoint(bool force) {
       }
 
       appendToCheckpointBuffer(kCheckpointMapMarker);
-      for (auto& pair : entries_) {
-        const auto id = pair.first.fileNum.id();
-        appendToCheckpointBuffer(id);
-        appendToCheckpointBuffer(pair.first.offset);
-        const auto offsetAndSize = pair.second.fileBits();
-        appendToCheckpointBuffer(offsetAndSize);
-        if (checksumEnabled_) {
-          const auto checksum = pair.second.checksum();
-          appendToCheckpointBuffer(checksum);
+
+      // The entries are grouped by region so that recovery can install them
+      // region by region. The region size is the end of the last entry and
+      // does not count the erased entries at the end of the region.
+      std::vector<std::vector<const std::pair<const FileCacheKey, SsdRun>*>>
+          regionEntries(numRegions_);
+      std::vector<uint32_t> regionSizes(numRegions_, 0);
+      std::vector<uint32_t> regionCachedBytes(numRegions_, 0);
+      for (const auto& pair : entries_) {
+        const auto& run = pair.second;
+        const auto region = regionIndex(run.offset());
+        regionEntries[region].push_back(&pair);
+        regionSizes[region] = std::max<uint32_t>(
+            regionSizes[region], regionOffset(run.offset()) + run.size());
+        regionCachedBytes[region] += run.size();
+      }
+      for (auto region = 0; region < numRegions_; ++region) {
+        const uint32_t numEntries = regionEntries[region].size();
+        appendToCheckpointBuffer(numEntries);
+        appendToCheckpointBuffer(regionSizes[region]);
+        appendToCheckpointBuffer(regionCachedBytes[region]);
+      }
+      for (const auto& entries : regionEntries) {
+        for (const auto* pair : entries) {
+          const auto id = pair->first.fileNum.id();
+          appendToCheckpointBuffer(id);
+          appendToCheckpointBuffer(pair->first.offset);
+          const auto offsetAndSize = pair->second.fileBits();
+          appendToCheckpointBuffer(offsetAndSize);
+          if (checksumEnabled_) {
+            const auto checksum = pair->second.checksum();
+            appendToCheckpointBuffer(checksum);
+          }
+          if (codec_ != nullptr) {
+            const uint32_t uncompressedSize = pair->second.compressed()
+                ? pair->second.uncompressedSize()
+                : 0;
+            appendToCheckpointBuffer(uncompressedSize);
+          }
         }
       }
 
@@ -863,6 +1245,9 @@ void SsdFile::initializeCheckpoint() {
     readCheckpoint();
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
+    recovery_.reset();
+    std::fill(pendingRegions_.begin(), pendingRegions_.end(), false);
+    numPendingRegions_ = 0;
     try {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
@@ -894,15 +1279,15 @@ uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
 void SsdFile::maybeVerifyChecksum(
     const AsyncDataCacheEntry& entry,
     const SsdRun& ssdRun) {
-  if (!checksumReadVerificationEnabled_) {
+  if (!checksumReadVerificationEnabled_ && !ssdRun.unverified()) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(ssdRun.uncompressedSize(), entry.size());
+  if (ssdRun.uncompressedSize() != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << ssdRun.uncompressedSize() << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -917,6 +1302,25 @@ void SsdFile::maybeVerifyChecksum(
         ssdRun.offset(),
         ssdRun.size());
   }
+  if (ssdRun.unverified()) {
+    markVerified(entry, ssdRun);
+  }
+}
+
+void SsdFile::markVerified(
+    const AsyncDataCacheEntry& entry,
+    const SsdRun& ssdRun) {
+  const FileCacheKey key{
+      entry.key().fileNum, static_cast<uint64_t>(entry.offset())};
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  auto it = entries_.find(key);
+  // The entry may have been evicted or rewritten since it was read.
+  if (it == entries_.end() || it->second.offset() != ssdRun.offset() ||
+      !it->second.unverified()) {
+    return;
+  }
+  it->second.setUnverified(false);
+  ++stats_.entriesVerifiedAfterRecovery;
 }
 
 void SsdFile::disableFileCow() {
@@ -959,10 +1363,18 @@ std::vector<T> readVector(common::FileInputStream* stream, int32_t size) {
 
 void SsdFile::readCheckpoint() {
   const auto checkpointPath = checkpointFilePath();
-  std::unique_ptr<common::FileInputStream> stream;
+  auto recovery = std::make_unique<CheckpointRecovery>();
+  int64_t endMarker{0};
   try {
     auto checkpointReadFile = fs_->openFileForRead(checkpointPath);
-    stream = std::make_unique<common::FileInputStream>(
+    // Check the end marker up front so that an incomplete checkpoint is not
+    // partially recovered before the end of it is read.
+    const auto checkpointSize = checkpointReadFile->size();
+    if (checkpointSize >= sizeof(endMarker)) {
+      checkpointReadFile->pread(
+          checkpointSize - sizeof(endMarker), sizeof(endMarker), &endMarker);
+    }
+    recovery->stream = std::make_unique<common::FileInputStream>(
         std::move(checkpointReadFile),
         1 << 20,
         memory::memoryManager()->cachePool());
@@ -976,11 +1388,37 @@ void SsdFile::readCheckpoint() {
         e.what());
     return;
   }
-
-  const auto versionMagic = readString(stream.get(), 4);
-  const auto checkpoinHasChecksum =
-      isChecksumEnabledOnCheckpointVersion(versionMagic);
-  if (checksumEnabled_ && !checkpoinHasChecksum) {
+  VELOX_CHECK_EQ(
+      endMarker,
+      kCheckpointEndMarker,
+      "Incomplete checkpoint file {}",
+      checkpointPath);
+  auto* stream = recovery->stream.get();
+
+  const auto versionMagic = readString(stream, 4);
+  const auto regionGrouped = isRegionGroupedCheckpointVersion(versionMagic);
+  recovery->hasCompression =
+      regionGrouped || isCompressionEnabledOnCheckpointVersion(versionMagic);
+  recovery->hasChecksum = isChecksumEnabledOnCheckpointVersion(versionMagic);
+  if (recovery->hasCompression) {
+    recovery->hasChecksum = readNumber<int32_t>(stream) != 0;
+    const auto compressionKind =
+        static_cast<common::CompressionKind>(readNumber<int32_t>(stream));
+    recovery->hasCompression =
+        compressionKind != common::CompressionKind_NONE;
+    if (recovery->hasCompression &&
+        (codec_ == nullptr ||
+         common::codecTypeToCompressionKind(codec_->type()) !=
+             compressionKind)) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint was made with compression {}, so skip the checkpoint recovery, checkpoint file {}",
+          shardId_,
+          common::compressionKindToString(compressionKind),
+          checkpointPath);
+      return;
+    }
+  }
+  if (checksumEnabled_ && !recovery->hasChecksum) {
     VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
         "Starting shard {} without checkpoint: checksum is enabled but the checkpoint was made without checksum, so skip the checkpoint recovery, checkpoint file {}",
         shardId_,
@@ -988,23 +1426,34 @@ void SsdFile::readCheckpoint() {
     return;
   }
 
-  const auto maxRegions = readNumber<int32_t>(stream.get());
+  const auto maxRegions = readNumber<int32_t>(stream);
   VELOX_CHECK_EQ(
       maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
-  numRegions_ = readNumber<int32_t>(stream.get());
+  numRegions_ = readNumber<int32_t>(stream);
 
-  const auto scores = readVector<double>(stream.get(), maxRegions_);
-  std::unordered_map<uint64_t, StringIdLease> idMap;
+  const auto scores = readVector<double>(stream, maxRegions_);
   for (;;) {
-    const auto id = readNumber<uint64_t>(stream.get());
+    const auto id = readNumber<uint64_t>(stream);
     if (id == kCheckpointMapMarker) {
       break;
     }
-    const auto length = readNumber<int32_t>(stream.get());
-    const auto name = readString(stream.get(), length);
-    idMap[id] = StringIdLease(fileIds(), id, name);
+    const auto length = readNumber<int32_t>(stream);
+    const auto name = readString(stream, length);
+    // The file keeps its id across restarts unless the id or the name has
+    // been taken in this process before the recovery. The entries of such a
+    // file are dropped instead of the whole checkpoint.
+    try {
+      recovery->idMap[id] = StringIdLease(fileIds(), id, name);
+    } catch (const VeloxException& e) {
+      recovery->droppedFileNums.insert(id);
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Dropping the checkpointed entries of file {} in shard {}: {}",
+          name,
+          shardId_,
+          e.what());
+    }
   }
 
   const auto logPath = evictLogFilePath();
@@ -1022,47 +1471,82 @@ void SsdFile::readCheckpoint() {
     evictedMap.insert(region);
   }
 
-  std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
-  for (;;) {
-    const auto fileNum = readNumber<uint64_t>(stream.get());
-    if (fileNum == kCheckpointEndMarker) {
-      break;
+  if (regionGrouped) {
+    // The region sizes are known from the directory, so that the regions can
+    // be written and evicted before their entries are recovered.
+    recovery->numRegionEntries.resize(numRegions_);
+    for (auto region = 0; region < numRegions_; ++region) {
+      recovery->numRegionEntries[region] = readNumber<uint32_t>(stream);
+      const auto regionSize = readNumber<uint32_t>(stream);
+      const auto regionCachedBytes = readNumber<uint32_t>(stream);
+      VELOX_CHECK_LE(regionSize, kRegionSize);
+      VELOX_CHECK_LE(regionCachedBytes, regionSize);
+      if (evictedMap.find(region) != evictedMap.end()) {
+        continue;
+      }
+      regionSizes_[region] = regionSize;
+      erasedRegionSizes_[region] = regionSize - regionCachedBytes;
+      if (recovery->numRegionEntries[region] > 0) {
+        pendingRegions_[region] = true;
+        ++numPendingRegions_;
+      }
     }
-    const auto offset = readNumber<uint64_t>(stream.get());
-    const auto fileBits = readNumber<uint64_t>(stream.get());
-    uint32_t checksum = 0;
-    if (checkpoinHasChecksum) {
-      checksum = readNumber<uint32_t>(stream.get());
+    recovery_ = std::move(recovery);
+    if (!lazyCheckpointRecovery_ || executor_ == nullptr) {
+      recoverRegions();
     }
-    const auto run = SsdRun(fileBits, checksum);
-    const auto region = regionIndex(run.offset());
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(region) != evictedMap.end()) {
-      continue;
+  } else {
+    std::vector<uint32_t> regionCacheSizes(numRegions_, 0);
+    uint64_t droppedBytes{0};
+    for (;;) {
+      const auto fileNum = readNumber<uint64_t>(stream);
+      if (fileNum == kCheckpointEndMarker) {
+        break;
+      }
+      const auto offset = readNumber<uint64_t>(stream);
+      const auto fileBits = readNumber<uint64_t>(stream);
+      uint32_t checksum = 0;
+      if (recovery->hasChecksum) {
+        checksum = readNumber<uint32_t>(stream);
+      }
+      uint32_t uncompressedSize = 0;
+      if (recovery->hasCompression) {
+        uncompressedSize = readNumber<uint32_t>(stream);
+      }
+      const auto run = SsdRun(fileBits, checksum, uncompressedSize);
+      const auto region = regionIndex(run.offset());
+      // Check that the recovered entry does not fall in an evicted region.
+      if (evictedMap.find(region) != evictedMap.end()) {
+        continue;
+      }
+      regionSizes_[region] = std::max<uint32_t>(
+          regionSizes_[region], regionOffset(run.offset()) + run.size());
+      // The file may have a different id on restore.
+      const auto it = recovery->idMap.find(fileNum);
+      if (it == recovery->idMap.end()) {
+        VELOX_CHECK_EQ(recovery->droppedFileNums.count(fileNum), 1);
+        droppedBytes += run.size();
+        continue;
+      }
+      FileCacheKey key{it->second, offset};
+      entries_[std::move(key)] = run;
+      regionCacheSizes[region] += run.size();
     }
-    // The file may have a different id on restore.
-    const auto it = idMap.find(fileNum);
-    VELOX_CHECK(it != idMap.end());
-    FileCacheKey key{it->second, offset};
-    entries_[std::move(key)] = run;
-    regionCacheSizes[region] += run.size();
-    regionSizes_[region] = std::max<uint32_t>(
-        regionSizes_[region], regionOffset(run.offset()) + run.size());
-  }
-
-  // NOTE: we might erase entries from a region for TTL eviction, so we need to
-  // set the region size to the max offset of the recovered cache entry from the
-  // region. Correspondingly, we substract the cached size from the region size
-  // to get the erased size.
-  for (auto region = 0; region < numRegions_; ++region) {
-    VELOX_CHECK_LE(regionSizes_[region], kRegionSize);
-    VELOX_CHECK_LE(regionCacheSizes[region], regionSizes_[region]);
-    erasedRegionSizes_[region] =
-        regionSizes_[region] - regionCacheSizes[region];
+
+    // NOTE: we might erase entries from a region for TTL eviction, so we need
+    // to set the region size to the max offset of the recovered cache entry
+    // from the region. Correspondingly, we substract the cached size from the
+    // region size to get the erased size.
+    for (auto region = 0; region < numRegions_; ++region) {
+      VELOX_CHECK_LE(regionSizes_[region], kRegionSize);
+      VELOX_CHECK_LE(regionCacheSizes[region], regionSizes_[region]);
+      erasedRegionSizes_[region] =
+          regionSizes_[region] - regionCacheSizes[region];
+    }
+    stats_.entriesRecovered += entries_.size();
   }
 
   ++stats_.checkpointsRead;
-  stats_.entriesRecovered += entries_.size();
 
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
@@ -1079,15 +1563,145 @@ void SsdFile::readCheckpoint() {
     cachedBytes += regionSize;
   }
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, checkpoint file {}",
+      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free and {} pending recovery, with checksum write {}, read verification {}, checkpoint file {}",
       shardId_,
       entries_.size(),
       succinctBytes(cachedBytes),
       numRegions_,
       writableRegions_.size(),
+      numPendingRegions_,
       checksumEnabled_ ? "enabled" : "disabled",
       checksumReadVerificationEnabled_ ? "enabled" : "disabled",
       checkpointFilePath());
+
+  if (numPendingRegions_ > 0) {
+    std::lock_guard<std::mutex> l(recoveryMutex_);
+    recoverySource_ = std::make_shared<AsyncSource<int>>([this]() {
+      recoverRegionsInBackground();
+      return std::make_unique<int>(0);
+    });
+    executor_->add([source = recoverySource_]() { source->prepare(); });
+  } else {
+    recovery_.reset();
+  }
+}
+
+std::vector<std::pair<FileCacheKey, SsdRun>> SsdFile::readCheckpointEntries(
+    CheckpointRecovery& recovery,
+    uint32_t numEntries,
+    uint64_t& droppedBytes) {
+  auto* stream = recovery.stream.get();
+  std::vector<std::pair<FileCacheKey, SsdRun>> entries;
+  entries.reserve(numEntries);
+  for (auto i = 0; i < numEntries; ++i) {
+    const auto fileNum = readNumber<uint64_t>(stream);
+    const auto offset = readNumber<uint64_t>(stream);
+    const auto fileBits = readNumber<uint64_t>(stream);
+    uint32_t checksum = 0;
+    if (recovery.hasChecksum) {
+      checksum = readNumber<uint32_t>(stream);
+    }
+    uint32_t uncompressedSize = 0;
+    if (recovery.hasCompression) {
+      uncompressedSize = readNumber<uint32_t>(stream);
+    }
+    SsdRun run(fileBits, checksum, uncompressedSize);
+    const auto it = recovery.idMap.find(fileNum);
+    if (it == recovery.idMap.end()) {
+      VELOX_CHECK_EQ(recovery.droppedFileNums.count(fileNum), 1);
+      droppedBytes += run.size();
+      continue;
+    }
+    entries.emplace_back(FileCacheKey{it->second, offset}, run);
+  }
+  return entries;
+}
+
+void SsdFile::recoverRegions() {
+  VELOX_CHECK_NOT_NULL(recovery_);
+  // The recovered entries are verified on first read unless every read is
+  // verified anyway.
+  const bool verifyOnFirstRead = lazyCheckpointRecovery_ &&
+      recovery_->hasChecksum && !checksumReadVerificationEnabled_;
+  TestValue::adjust("facebook::velox::cache::SsdFile::recoverRegions", this);
+  for (auto region = 0; region < recovery_->numRegionEntries.size();
+       ++region) {
+    if (recoveryCancelled_) {
+      return;
+    }
+    uint64_t droppedBytes{0};
+    auto entries = readCheckpointEntries(
+        *recovery_, recovery_->numRegionEntries[region], droppedBytes);
+
+    std::lock_guard<std::shared_mutex> l(mutex_);
+    // A region that is evicted or cleared while pending has new content.
+    if (!pendingRegions_[region]) {
+      continue;
+    }
+    uint64_t numRecovered{0};
+    for (auto& [key, run] : entries) {
+      VELOX_CHECK_EQ(regionIndex(run.offset()), region);
+      run.setUnverified(verifyOnFirstRead);
+      // A key written while the region was pending has newer content in
+      // another region. The checkpointed run is then stale and its bytes are
+      // dead space in this region.
+      if (!entries_.try_emplace(std::move(key), run).second) {
+        droppedBytes += run.size();
+        continue;
+      }
+      ++numRecovered;
+    }
+    erasedRegionSizes_[region] += droppedBytes;
+    VELOX_CHECK_LE(erasedRegionSizes_[region], regionSizes_[region]);
+    pendingRegions_[region] = false;
+    --numPendingRegions_;
+    stats_.entriesRecovered += numRecovered;
+  }
+  VELOX_CHECK_EQ(
+      readNumber<int64_t>(recovery_->stream.get()), kCheckpointEndMarker);
+  recovery_.reset();
+}
+
+void SsdFile::recoverRegionsInBackground() {
+  process::TraceContext trace("SsdFile::recoverRegionsInBackground");
+  try {
+    recoverRegions();
+  } catch (const std::exception& e) {
+    ++stats_.readCheckpointErrors;
+    VELOX_SSD_CACHE_LOG(ERROR) << fmt::format(
+        "Error recovering shard {} from checkpoint: {}", shardId_, e.what());
+  }
+  recovery_.reset();
+
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  if (numPendingRegions_ == 0) {
+    VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+        "Finished recovering shard {} from checkpoint with {} entries",
+        shardId_,
+        entries_.size());
+    return;
+  }
+  // The regions that are not recovered are left as erased.
+  VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+      "Dropping {} regions pending recovery in shard {}",
+      numPendingRegions_,
+      shardId_);
+  for (auto region = 0; region < numRegions_; ++region) {
+    if (pendingRegions_[region]) {
+      pendingRegions_[region] = false;
+      erasedRegionSizes_[region] = regionSizes_[region];
+    }
+  }
+  numPendingRegions_ = 0;
+}
+
+void SsdFile::waitForRecovery() {
+  std::lock_guard<std::mutex> l(recoveryMutex_);
+  if (recoverySource_ == nullptr) {
+    return;
+  }
+  recoverySource_->move();
+  recoverySource_.reset();
 }
 
 } // namespace facebook::velox::cache
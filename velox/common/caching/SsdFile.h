@@ -19,11 +19,14 @@
 #include <gflags/gflags.h>
 #include <shared_mutex>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 
 namespace facebook::velox::cache {
 
@@ -38,17 +41,31 @@ class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
-  SsdRun() : fileBits_(0) {}
-
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
+  SsdRun()
+      : fileBits_(0), checksum_(0), uncompressedSize_(0), unverified_(false) {}
+
+  /// Constructs a run of 'size' bytes at 'offset'. If 'uncompressedSize' is
+  /// not 0, the run holds the compressed data of a cache entry of
+  /// 'uncompressedSize' bytes.
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t uncompressedSize = 0)
+      : fileBits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize),
+        unverified_(false) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t uncompressedSize = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize),
+        unverified_(false) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -56,22 +73,37 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
+    unverified_ = other.unverified_;
   }
 
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
+    unverified_ = other.unverified_;
   }
 
   uint64_t offset() const {
     return (fileBits_ >> kSizeBits);
   }
 
+  /// Returns the number of bytes the run takes on SSD.
   uint32_t size() const {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns true if the run holds compressed cache entry data.
+  bool compressed() const {
+    return uncompressedSize_ != 0;
+  }
+
+  /// Returns the size of the cache entry data stored in the run.
+  uint32_t uncompressedSize() const {
+    return compressed() ? uncompressedSize_ : size();
+  }
+
+  /// Returns the checksum computed with crc32 on the uncompressed data.
   uint32_t checksum() const {
     return checksum_;
   }
@@ -81,10 +113,24 @@ class SsdRun {
     return fileBits_;
   }
 
+  /// Returns true if the run was recovered from a checkpoint and its data has
+  /// not yet been verified against 'checksum()'.
+  bool unverified() const {
+    return unverified_;
+  }
+
+  void setUnverified(bool unverified) {
+    unverified_ = unverified;
+  }
+
  private:
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // The size of the uncompressed data if the run is compressed, otherwise 0.
+  // An entry is at most 8MB so the top bit is free for 'unverified_'.
+  uint32_t uncompressedSize_ : 31;
+  uint32_t unverified_ : 1;
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -157,6 +203,9 @@ struct SsdCacheStats {
     regionsAgedOut = tsanAtomicValue(other.regionsAgedOut);
     regionsEvicted = tsanAtomicValue(other.regionsEvicted);
     numPins = tsanAtomicValue(other.numPins);
+    regionsPendingRecovery = tsanAtomicValue(other.regionsPendingRecovery);
+    entriesVerifiedAfterRecovery =
+        tsanAtomicValue(other.entriesVerifiedAfterRecovery);
 
     openFileErrors = tsanAtomicValue(other.openFileErrors);
     openCheckpointErrors = tsanAtomicValue(other.openCheckpointErrors);
@@ -171,6 +220,8 @@ struct SsdCacheStats {
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
     readWithoutChecksumChecks =
         tsanAtomicValue(other.readWithoutChecksumChecks);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -180,6 +231,8 @@ struct SsdCacheStats {
     result.checkpointsWritten = checkpointsWritten - other.checkpointsWritten;
     result.entriesRead = entriesRead - other.entriesRead;
     result.entriesRecovered = entriesRecovered - other.entriesRecovered;
+    result.entriesVerifiedAfterRecovery =
+        entriesVerifiedAfterRecovery - other.entriesVerifiedAfterRecovery;
     result.bytesRead = bytesRead - other.bytesRead;
     result.checkpointsRead = checkpointsRead - other.checkpointsRead;
     result.entriesAgedOut = entriesAgedOut - other.entriesAgedOut;
@@ -202,6 +255,9 @@ struct SsdCacheStats {
         readCheckpointErrors - other.readCheckpointErrors;
     result.readWithoutChecksumChecks =
         readWithoutChecksumChecks - other.readWithoutChecksumChecks;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.bytesSavedByCompression =
+        bytesSavedByCompression - other.bytesSavedByCompression;
     return result;
   }
 
@@ -214,6 +270,9 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> regionsCached{0};
   tsan_atomic<uint64_t> bytesCached{0};
   tsan_atomic<int32_t> numPins{0};
+  /// Number of regions whose entries are still being recovered from the
+  /// checkpoint in the background.
+  tsan_atomic<uint32_t> regionsPendingRecovery{0};
 
   /// Cumulative stats
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -221,11 +280,16 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> checkpointsWritten{0};
   tsan_atomic<uint64_t> entriesRead{0};
   tsan_atomic<uint64_t> entriesRecovered{0};
+  /// Number of recovered entries whose checksum was verified on first read.
+  tsan_atomic<uint64_t> entriesVerifiedAfterRecovery{0};
   tsan_atomic<uint64_t> bytesRead{0};
   tsan_atomic<uint64_t> checkpointsRead{0};
   tsan_atomic<uint64_t> entriesAgedOut{0};
   tsan_atomic<uint64_t> regionsAgedOut{0};
   tsan_atomic<uint64_t> regionsEvicted{0};
+  /// Number of entries written compressed and the SSD bytes saved by it.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
   tsan_atomic<uint32_t> openFileErrors{0};
   tsan_atomic<uint32_t> openCheckpointErrors{0};
   tsan_atomic<uint32_t> openLogErrors{0};
@@ -257,7 +321,10 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind =
+            common::CompressionKind_NONE,
+        bool _lazyCheckpointRecovery = false)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -266,7 +333,9 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind),
+          lazyCheckpointRecovery(_lazyCheckpointRecovery){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -292,6 +361,18 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// The codec to compress the cache entries with on SSD. An entry is only
+    /// stored compressed if the data of its file group has been observed to
+    /// compress well. No compression if it is CompressionKind_NONE.
+    common::CompressionKind compressionKind;
+
+    /// If true, only the region layout is read from the checkpoint at
+    /// construction and the cache entries are recovered region by region on
+    /// 'executor' while the file serves traffic. The recovered entries are
+    /// verified against their checksums on first read, if the checkpoint has
+    /// checksums.
+    bool lazyCheckpointRecovery;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -300,6 +381,9 @@ class SsdFile {
   /// filename.
   SsdFile(const Config& config);
 
+  /// Stops a pending background checkpoint recovery.
+  ~SsdFile();
+
   /// Adds entries of 'pins' to this file. 'pins' must be in read mode and
   /// those pins that are successfully added to SSD are marked as being on SSD.
   /// The file of the entries must be a file that is backed by 'this'.
@@ -359,6 +443,11 @@ class SsdFile {
   /// eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
 
+  /// Waits for a background checkpoint recovery to finish or recovers the
+  /// remaining regions on the calling thread if it has not started. No-op
+  /// if there is no recovery in progress.
+  void waitForRecovery();
+
   /// Returns the SSD file path.
   const std::string& fileName() const {
     return fileName_;
@@ -388,6 +477,49 @@ class SsdFile {
 
   static constexpr int kMaxErasedSizePct = 50;
 
+  // An entry is stored compressed only if its data compresses to at most this
+  // percentage of the uncompressed size.
+  static constexpr int32_t kMaxCompressedSizePct = 80;
+  // Number of entries of a file group that are compressed before deciding
+  // whether to compress the group from the observed compression ratio.
+  static constexpr int32_t kMinCompressionSamples = 8;
+  // A file group that does not compress well is still sampled once every
+  // this many entries to follow changes in its data.
+  static constexpr int32_t kCompressionSampleInterval = 32;
+  // Maximum number of file groups in 'compressionStats_'.
+  static constexpr int32_t kMaxCompressionStatsGroups = 16 << 10;
+
+  // A write of 'iovecs' with 'length' bytes at 'offset' of the cache file.
+  struct PendingWrite {
+    int64_t offset;
+    int64_t length;
+    std::vector<iovec> iovecs;
+  };
+
+  // The state for recovering the cache entries of a checkpoint region by
+  // region.
+  struct CheckpointRecovery {
+    // The checkpoint file positioned at the entries of the next region.
+    std::unique_ptr<common::FileInputStream> stream;
+    // Maps the file numbers in the checkpoint to the leases of their recovered
+    // ids. The entries of files whose ids could not be recovered are dropped.
+    std::unordered_map<uint64_t, StringIdLease> idMap;
+    // The file numbers in the checkpoint whose ids could not be recovered.
+    std::unordered_set<uint64_t> droppedFileNums;
+    // The number of entries of each region in the checkpoint.
+    std::vector<uint32_t> numRegionEntries;
+    bool hasChecksum{false};
+    bool hasCompression{false};
+  };
+
+  // Observed compression ratio of the entries of a file group.
+  struct CompressionStats {
+    uint64_t uncompressedBytes{0};
+    uint64_t compressedBytes{0};
+    int32_t numSamples{0};
+    int32_t numSkipped{0};
+  };
+
   // Updates the read count of a region.
   void regionRead(int32_t region, int32_t size) {
     tracker_.regionRead(region, size);
@@ -403,10 +535,13 @@ class SsdFile {
     return offset % kRegionSize;
   }
 
-  // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
-  std::string checkpointVersion() const {
-    return checksumEnabled_ ? "CPT2" : "CPT1";
+  // The first 4 bytes of a checkpoint file contains version string. "CPT4" is
+  // followed by the checksum enabled flag and the compression kind. Its
+  // entries are grouped by region after a directory of the per region entry
+  // counts so that the regions can be recovered one by one. "CPT1", "CPT2" and
+  // "CPT3" are earlier versions which are still recovered from.
+  static std::string checkpointVersion() {
+    return "CPT4";
   }
 
   // Increments the pin count of the region of 'offset'. Caller must hold
@@ -415,14 +550,23 @@ class SsdFile {
     ++regionPins_[regionIndex(offset)];
   }
 
-  // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // Returns [offset, size] of contiguous space for storing a number of
+  // contiguous entries of 'sizes' starting with the entry at index 'begin'.
+  // Returns nullopt if there is no space. The space does not necessarily cover
+  // all the entries, so multiple calls starting at the first unwritten entry
+  // may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
+  // Returns the compressed data of 'entry' if it should be stored compressed,
+  // otherwise nullptr. Updates the compression stats of the entry's file group.
+  std::unique_ptr<folly::IOBuf> maybeCompress(const AsyncDataCacheEntry& entry);
+
+  // Decompresses 'size' bytes of compressed 'data' of 'run'.
+  std::unique_ptr<folly::IOBuf>
+  decompress(const char* data, int32_t size, const SsdRun& run);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -434,13 +578,45 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
-  // Verifies that 'entry' has the data at 'run'.
+  // Returns the io_uring for the IO on the cache data file or nullptr if the
+  // IO is blocking. Asked per batch since the ring is gone once it fails.
+  IoUring* ioUring() const {
+    return readFd_ >= 0 ? IoUring::instance() : nullptr;
+  }
+
+  // Reads the backing file at the offsets into the buffers of 'reads' with
+  // a single submission to 'ioUring' and waits for all of them to complete.
+  // Falls back to read() if the ring fails.
+  void readBatch(
+      IoUring& ioUring,
+      const std::vector<
+          std::pair<uint64_t, std::vector<folly::Range<char*>>>>& reads);
+
+  // Verifies that 'entry' has the data at 'run'. The data is decompressed
+  // first if 'run' is compressed.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
   // Reads a checkpoint file and sets 'this' accordingly if read succeeds. A
   // failed read deletes the checkpoint and leaves the truncated log open.
   void readCheckpoint();
 
+  // Reads the entries of the remaining regions of 'recovery_' and adds those
+  // of the regions still in 'pendingRegions_' to 'entries_'. Throws if the
+  // checkpoint is corrupt.
+  void recoverRegions();
+
+  // Runs recoverRegions() on 'executor_'. A failure drops the regions not
+  // recovered so far.
+  void recoverRegionsInBackground();
+
+  // Reads 'numEntries' entries from the checkpoint of 'recovery'. Adds the
+  // size of the dropped entries of files without a recovered id to
+  // 'droppedBytes'.
+  std::vector<std::pair<FileCacheKey, SsdRun>> readCheckpointEntries(
+      CheckpointRecovery& recovery,
+      uint32_t numEntries,
+      uint64_t& droppedBytes);
+
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
@@ -456,6 +632,11 @@ class SsdFile {
   // succeeds; otherwise, log the error and return false.
   bool write(int64_t offset, int64_t length, const std::vector<iovec>& iovecs);
 
+  // Writes all of 'writes', with a single io_uring submission if io_uring is
+  // used. Falls back to write() if the ring fails. Returns true if all the
+  // writes succeed; otherwise, log the error and return false.
+  bool writeBatch(const std::vector<PendingWrite>& writes);
+
   // Synchronously logs that 'regions' are no longer valid in a possibly
   // existing checkpoint.
   void logEviction(std::vector<int32_t>& regions);
@@ -468,18 +649,28 @@ class SsdFile {
     return checkpointIntervalBytes_ > 0;
   }
 
-  // Returns true if checkpoint is needed.
+  // Returns true if checkpoint is needed. A checkpoint made before all the
+  // regions are recovered would lose the entries of the pending regions, so
+  // only a forced checkpoint, which waits for the recovery, is made then.
   bool needCheckpoint(bool force) const {
     if (!checkpointEnabled()) {
       return false;
     }
-    return force || (bytesAfterCheckpoint_ >= checkpointIntervalBytes_);
+    return force ||
+        (numPendingRegions_ == 0 &&
+         bytesAfterCheckpoint_ >= checkpointIntervalBytes_);
   }
 
+  // Verifies the checksum of 'entry' read from 'ssdRun' if read verification
+  // is enabled or if 'ssdRun' is recovered and not yet verified.
   void maybeVerifyChecksum(
       const AsyncDataCacheEntry& entry,
       const SsdRun& ssdRun);
 
+  // Clears the unverified flag of the run of 'entry' after its first
+  // successful verification.
+  void markVerified(const AsyncDataCacheEntry& entry, const SsdRun& ssdRun);
+
   // Disable 'copy on write'. Will throw if failed for any reason, including
   // file system not supporting cow feature.
   void disableFileCow();
@@ -526,6 +717,18 @@ class SsdFile {
     return checkpointVersion == "CPT2";
   }
 
+  // Returns true if the checkpoint entries record their uncompressed sizes.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPT3";
+  }
+
+  // Returns true if the checkpoint entries are grouped by region.
+  static bool isRegionGroupedCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion == "CPT4";
+  }
+
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
   static constexpr uint32_t kCheckpointBufferSize = 1 << 20; // 1MB
@@ -545,9 +748,15 @@ class SsdFile {
   // If true, checksum read verification from SSD is enabled.
   const bool checksumReadVerificationEnabled_;
 
+  // If true, the checkpoint entries are recovered in the background.
+  const bool lazyCheckpointRecovery_;
+
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
+  // The codec to compress entries with. Null if compression is disabled.
+  const std::unique_ptr<folly::compression::Codec> codec_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
@@ -578,6 +787,27 @@ class SsdFile {
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
+  // True for the regions whose entries are still to be recovered from the
+  // checkpoint. A region is no longer pending once it is recovered, evicted or
+  // cleared.
+  std::vector<bool> pendingRegions_;
+
+  // Number of true values in 'pendingRegions_'.
+  int32_t numPendingRegions_{0};
+
+  // Serializes the access to 'recoverySource_'.
+  std::mutex recoveryMutex_;
+
+  // The checkpoint state to recover entries from. Only accessed by the
+  // recovery.
+  std::unique_ptr<CheckpointRecovery> recovery_;
+
+  // Runs the background recovery of the regions in 'recovery_'.
+  std::shared_ptr<AsyncSource<int>> recoverySource_;
+
+  // Set to stop the background recovery at the next region.
+  std::atomic_bool recoveryCancelled_{false};
+
   // File system.
   std::shared_ptr<filesystems::FileSystem> fs_;
 
@@ -590,6 +820,11 @@ class SsdFile {
   // WriteFile for cache data file.
   std::unique_ptr<WriteFile> writeFile_;
 
+  // File descriptors of 'readFile_' and 'writeFile_' for io_uring. -1 if the
+  // cache data file is not a local file.
+  int32_t readFd_{-1};
+  int32_t writeFd_{-1};
+
   // WriteFile for evict log file.
   std::unique_ptr<WriteFile> evictLogWriteFile_;
 
@@ -618,6 +853,11 @@ class SsdFile {
   // Buffered data size for checkpoint.
   uint32_t checkpointBufferedDataSize_;
 
+  // Compression stats per file group id. Holds at most
+  // 'kMaxCompressionStatsGroups' groups. Only accessed by write() which is
+  // serialized by SsdCache.
+  folly::F14FastMap<uint64_t, CompressionStats> compressionStats_;
+
   friend class test::SsdFileTestHelper;
   friend class test::SsdCacheTestHelper;
 };
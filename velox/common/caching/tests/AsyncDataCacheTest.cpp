@@ -1215,6 +1215,47 @@ TEST_P(AsyncDataCacheTest, shrinkCache) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, shrinkInBackground) {
+  constexpr uint64_t kRamBytes = 128UL << 20;
+  constexpr int kDataSize = 64 << 10;
+  constexpr int kNumEntries = 10;
+  initializeCache(kRamBytes);
+
+  std::vector<RawFileCacheKey> keys;
+  std::vector<StringIdLease> fileLeases;
+  for (int i = 0; i < kNumEntries; ++i) {
+    fileLeases.emplace_back(
+        StringIdLease(fileIds(), fmt::format("shrinkInBackgroundFile{}", i)));
+    keys.emplace_back(RawFileCacheKey{fileLeases.back().id(), 0});
+    auto pin = cache_->findOrCreate(keys.back(), kDataSize);
+    ASSERT_FALSE(pin.empty());
+    pin.entry()->setExclusiveToShared();
+  }
+  ASSERT_EQ(cache_->lookupStats(), std::make_pair<uint64_t, uint64_t>(10, 0));
+  ASSERT_GE(cache_->cachedBytes(), kDataSize * kNumEntries);
+
+  // Keeps the first entry pinned.
+  std::vector<CachePin> pins;
+  for (const auto& key : keys) {
+    pins.push_back(cache_->findOrCreate(key, kDataSize));
+    ASSERT_TRUE(pins.back().entry()->isShared());
+  }
+  ASSERT_EQ(cache_->lookupStats(), std::make_pair<uint64_t, uint64_t>(20, 10));
+  pins.resize(1);
+
+  VELOX_ASSERT_THROW(cache_->shrinkInBackground(0), "");
+  for (const auto& key : keys) {
+    cache_->makeEvictable(key);
+  }
+  ASSERT_GE(
+      cache_->shrinkInBackground(kRamBytes), kDataSize * (kNumEntries - 1));
+  ASSERT_TRUE(cache_->exists(keys[0]));
+  for (int i = 1; i < kNumEntries; ++i) {
+    ASSERT_FALSE(cache_->exists(keys[i]));
+  }
+  ASSERT_LT(cache_->cachedBytes(), kDataSize * 2);
+}
+
 TEST_P(AsyncDataCacheTest, shutdown) {
   constexpr uint64_t kRamBytes = 16 << 20;
   constexpr uint64_t kSsdBytes = 64UL << 20;
@@ -1442,6 +1483,84 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, tinyLfu) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 16 << 10;
+  constexpr int32_t kNumHot = 200;
+  AsyncDataCache::Options options;
+  options.evictionPolicy = CacheEvictionPolicy::kTinyLfu;
+  initializeCache(kMaxBytes, 0, 0, false, options);
+
+  const auto hit = [&](uint64_t offset) {
+    folly::SemiFuture<bool> wait(false);
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset}, kSize, &wait);
+    ASSERT_FALSE(pin.empty());
+    ASSERT_FALSE(pin.entry()->isExclusive());
+  };
+
+  // Makes a hot set. The first use of a prefetched entry does not promote it,
+  // the second does.
+  for (auto i = 0; i < kNumHot; ++i) {
+    auto pin = newEntry(i * kSize, kSize);
+    ASSERT_FALSE(pin.empty());
+    pin.entry()->setExclusiveToShared();
+  }
+  for (auto i = 0; i < kNumHot; ++i) {
+    hit(i * kSize);
+    ASSERT_EQ(cache_->refreshStats().numPromote, i);
+    hit(i * kSize);
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numPromote, kNumHot);
+  ASSERT_EQ(stats.protectedBytes, kNumHot * kSize);
+
+  // Scans twice the cache capacity of data that is read once. The hot set
+  // stays in the protected segment.
+  for (uint64_t offset = kNumHot * kSize; offset < 3 * kMaxBytes;
+       offset += kSize) {
+    auto pin = newEntry(offset, kSize);
+    ASSERT_FALSE(pin.empty());
+    pin.entry()->setExclusiveToShared();
+  }
+  stats = cache_->refreshStats();
+  ASSERT_LT(0, stats.numEvict);
+  ASSERT_EQ(stats.numDemote, 0);
+  for (auto i = 0; i < kNumHot; ++i) {
+    ASSERT_TRUE(
+        cache_->exists(RawFileCacheKey{filenames_[0].id(), i * kSize}));
+  }
+
+  // An entry with low expected reuse is not promoted on its first hit.
+  const uint64_t lowReuseOffset = 4 * kMaxBytes;
+  {
+    auto pin = newEntry(lowReuseOffset, kSize);
+    ASSERT_FALSE(pin.empty());
+    pin.entry()->setLowReuse(true);
+    pin.entry()->setExclusiveToShared();
+  }
+  hit(lowReuseOffset);
+  hit(lowReuseOffset);
+  ASSERT_EQ(cache_->refreshStats().numPromote, kNumHot);
+
+  // The entry stays in probation. It is retained over the probation entries
+  // evicted for new entries whose keys are accessed less often.
+  const auto numEvict = cache_->refreshStats().numEvict;
+  for (uint64_t offset = 5 * kMaxBytes; offset < 5 * kMaxBytes + (4 << 20);
+       offset += kSize) {
+    auto pin = newEntry(offset, kSize);
+    ASSERT_FALSE(pin.empty());
+    pin.entry()->setExclusiveToShared();
+  }
+  ASSERT_LT(numEvict, cache_->refreshStats().numEvict);
+  ASSERT_TRUE(
+      cache_->exists(RawFileCacheKey{filenames_[0].id(), lowReuseOffset}));
+  for (auto i = 0; i < kNumHot; ++i) {
+    ASSERT_TRUE(
+        cache_->exists(RawFileCacheKey{filenames_[0].id(), i * kSize}));
+  }
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
@@ -55,6 +55,13 @@ class SsdFileTestHelper {
     return ssdFile_->entries_;
   }
 
+  /// Returns the bytes written to 'region' minus the bytes of the runs that
+  /// are no longer referenced by any entry.
+  uint64_t liveRegionBytes(int32_t region) const {
+    return ssdFile_->regionSizes_[region] -
+        ssdFile_->erasedRegionSizes_[region];
+  }
+
   bool checksumReadVerificationEnabled() const {
     return ssdFile_->checksumReadVerificationEnabled_;
   }
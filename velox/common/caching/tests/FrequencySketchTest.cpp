@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/base/BitUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1000);
+  EXPECT_EQ(sketch.capacity(), 1024);
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 0); };
+  EXPECT_EQ(sketch.estimate(hash(1)), 0);
+  for (auto i = 0; i < 3; ++i) {
+    sketch.record(hash(1));
+  }
+  for (auto key = 100; key < 600; ++key) {
+    sketch.record(hash(key));
+  }
+  // The estimate is never below the true count.
+  EXPECT_GE(sketch.estimate(hash(1)), 3);
+  for (auto key = 100; key < 600; ++key) {
+    EXPECT_GE(sketch.estimate(hash(key)), 1);
+  }
+  // Counters saturate.
+  for (auto i = 0; i < 2 * FrequencySketch::kMaxCount; ++i) {
+    sketch.record(hash(2));
+  }
+  EXPECT_EQ(sketch.estimate(hash(2)), FrequencySketch::kMaxCount);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(64);
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 0); };
+  for (auto i = 0; i < 8; ++i) {
+    sketch.record(hash(1));
+  }
+  EXPECT_GE(sketch.estimate(hash(1)), 8);
+  // After 10 records per tracked key, the counters are halved, so a
+  // formerly hot key fades out when it is no longer accessed.
+  for (uint64_t key = 1'000; key < 1'000 + 20 * sketch.capacity(); ++key) {
+    sketch.record(hash(key));
+  }
+  EXPECT_LT(sketch.estimate(hash(1)), 8);
+}
+
+TEST(FrequencySketchTest, ensureCapacity) {
+  FrequencySketch sketch;
+  EXPECT_EQ(sketch.capacity(), 64);
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 0); };
+  for (auto i = 0; i < 3; ++i) {
+    sketch.record(hash(1));
+  }
+  for (uint64_t key = 100; key < 150; ++key) {
+    sketch.record(hash(key));
+  }
+  sketch.ensureCapacity(100);
+  EXPECT_EQ(sketch.capacity(), 64);
+  EXPECT_GE(sketch.estimate(hash(1)), 3);
+
+  std::vector<int32_t> estimates;
+  for (uint64_t key = 0; key < 200; ++key) {
+    estimates.push_back(sketch.estimate(hash(key)));
+  }
+  sketch.ensureCapacity(1'000);
+  EXPECT_EQ(sketch.capacity(), 1024);
+  // Resizing keeps the history.
+  for (uint64_t key = 0; key < 200; ++key) {
+    EXPECT_EQ(sketch.estimate(hash(key)), estimates[key]);
+  }
+  EXPECT_GE(sketch.estimate(hash(1)), 3);
+}
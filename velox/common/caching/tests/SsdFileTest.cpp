@@ -18,11 +18,16 @@
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/tests/CacheTestUtil.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <folly/compression/Compression.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
@@ -33,6 +38,7 @@ using namespace facebook::velox;
 using namespace facebook::velox::cache;
 using namespace facebook::velox::tests::utils;
 
+using facebook::velox::common::testutil::TestValue;
 using facebook::velox::memory::MemoryAllocator;
 
 DECLARE_bool(velox_ssd_odirect);
@@ -96,7 +102,9 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      bool lazyCheckpointRecovery = false) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -105,7 +113,9 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        compressionKind,
+        lazyCheckpointRecovery);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -498,6 +508,105 @@ TEST_F(SsdFileTest, checkpoint) {
   EXPECT_EQ(numEntriesFound, 0);
 }
 
+TEST_F(SsdFileTest, compression) {
+  if (!folly::compression::hasCodec(folly::compression::CodecType::ZSTD)) {
+    GTEST_SKIP() << "ZSTD codec is not available";
+  }
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = SsdFile::kRegionSize;
+  FLAGS_velox_ssd_verify_write = true;
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+
+  // The test contents compress well, so all the entries are compressed.
+  std::vector<TestEntry> allEntries;
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 20 * kMB);
+  uint64_t uncompressedBytes{0};
+  for (auto& pin : pins) {
+    uncompressedBytes += pin.entry()->size();
+  }
+  ssdFile_->write(pins);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.entriesWritten, pins.size());
+  ASSERT_EQ(stats.entriesCompressed, pins.size());
+  ASSERT_EQ(
+      stats.bytesWritten + stats.bytesSavedByCompression, uncompressedBytes);
+  for (auto& pin : pins) {
+    EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    allEntries.emplace_back(
+        pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+  }
+  readAndCheckPins(pins);
+  auto compressedPins = std::move(pins);
+
+  // Random data of another file group does not compress and is stored as is.
+  const auto fileNameAlt = StringIdLease(fileIds(), "fileInStorageAlt");
+  pins = makePins(fileNameAlt.id(), 0, 4096, 4096, 64 * 4096);
+  folly::Random::DefaultGenerator rng(1);
+  for (auto& pin : pins) {
+    auto* entry = pin.entry();
+    entry->setGroupId(1);
+    for (auto i = 0; i < entry->data().numRuns(); ++i) {
+      const auto run = entry->data().runAt(i);
+      auto* words = run.data<uint64_t>();
+      for (auto j = 0; j < run.numBytes() / sizeof(uint64_t); ++j) {
+        words[j] = folly::Random::rand64(rng);
+      }
+    }
+  }
+  ssdFile_->write(pins);
+  const auto prevStats = stats;
+  stats.clear();
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.entriesWritten - prevStats.entriesWritten, pins.size());
+  ASSERT_EQ(stats.entriesCompressed, prevStats.entriesCompressed);
+
+  // The compressed and uncompressed entries were written back to back and
+  // are loaded with a single coalesced read.
+  std::vector<CachePin> loadPins;
+  std::vector<SsdPin> ssdPins;
+  const auto numCompressed = compressedPins.size();
+  for (auto* pinsToLoad : {&compressedPins, &pins}) {
+    for (auto& pin : *pinsToLoad) {
+      ssdPins.push_back(ssdFile_->find(RawFileCacheKey{
+          pin.entry()->key().fileNum.id(), pin.entry()->key().offset}));
+      ASSERT_FALSE(ssdPins.back().empty());
+      loadPins.push_back(std::move(pin));
+    }
+  }
+  const auto loadStats = ssdFile_->load(ssdPins, loadPins);
+  ASSERT_EQ(loadStats.numIos, 1);
+  for (auto i = 0; i < numCompressed; ++i) {
+    checkContents(loadPins[i].entry()->data(), loadPins[i].entry()->size());
+  }
+  ssdPins.clear();
+  loadPins.clear();
+  pins.clear();
+
+  // The compressed entries are recovered from checkpoint.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+
+  // The checkpoint is not used without compression.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  ASSERT_EQ(checkEntries(allEntries), 0);
+}
+
 TEST_F(SsdFileTest, fileCorruption) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -691,6 +800,152 @@ TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   }
 }
 
+TEST_F(SsdFileTest, lazyCheckpointRecovery) {
+  constexpr int64_t kSsdSize = 8 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
+  FLAGS_velox_ssd_verify_write = true;
+
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, false);
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    };
+  }
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+
+  // Recover the checkpoint in the background.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      false,
+      false,
+      common::CompressionKind_NONE,
+      true);
+  ssdFile_->waitForRecovery();
+  SsdCacheStats statsAfterRecover;
+  ssdFile_->updateStats(statsAfterRecover);
+  EXPECT_EQ(statsAfterRecover.regionsPendingRecovery, 0);
+  EXPECT_EQ(statsAfterRecover.entriesRecovered, allEntries.size());
+  EXPECT_EQ(statsAfterRecover.entriesCached, stats.entriesCached);
+  EXPECT_EQ(statsAfterRecover.bytesCached, stats.bytesCached);
+  EXPECT_EQ(statsAfterRecover.regionsCached, stats.regionsCached);
+  for (const auto& [key, run] : ssdFileHelper_->eEntries()) {
+    EXPECT_TRUE(run.unverified());
+  }
+
+  // The recovered entries are verified on first read even though read
+  // verification is disabled.
+  EXPECT_EQ(checkEntries(allEntries), allEntries.size());
+  statsAfterRecover.clear();
+  ssdFile_->updateStats(statsAfterRecover);
+  EXPECT_EQ(
+      statsAfterRecover.entriesVerifiedAfterRecovery, allEntries.size());
+  for (const auto& [key, run] : ssdFileHelper_->eEntries()) {
+    EXPECT_FALSE(run.unverified());
+  }
+
+  // A corrupt entry is detected on first read after lazy recovery.
+  ssdFile_->checkpoint(true);
+  corruptSsdFile(fmt::format("{}/ssdtest", tempDirectory_->getPath()));
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      false,
+      false,
+      common::CompressionKind_NONE,
+      true);
+  ssdFile_->waitForRecovery();
+  EXPECT_EQ(checkEntries({allEntries.begin(), allEntries.begin() + 100}), 100);
+  VELOX_ASSERT_THROW(checkEntries(allEntries), "Corrupt SSD cache entry");
+  statsAfterRecover.clear();
+  ssdFile_->updateStats(statsAfterRecover);
+  EXPECT_GT(statsAfterRecover.readSsdCorruptions, 0);
+}
+
+DEBUG_ONLY_TEST_F(SsdFileTest, lazyCheckpointRecoveryWithWrites) {
+  constexpr int64_t kSsdSize = 8 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
+  FLAGS_velox_ssd_verify_write = true;
+
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, false);
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    };
+  }
+  ssdFile_->checkpoint(true);
+  // Drops the entries from memory so that they are written to SSD again.
+  cache_->clear();
+
+  // Rewrites the entries of the last region before any region is recovered.
+  // The file is full, so the write also evicts regions pending recovery. The
+  // rewritten keys are newer than the ones in the checkpoint.
+  std::atomic_int32_t numRewritten{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::cache::SsdFile::recoverRegions",
+      std::function<void(SsdFile*)>([&](SsdFile* ssdFile) {
+        auto pins = makePins(
+            fileName_.id(),
+            kSsdSize - SsdFile::kRegionSize,
+            4096,
+            2048 * 1025,
+            62 * kMB);
+        ssdFile->write(pins);
+        for (const auto& pin : pins) {
+          if (pin.entry()->ssdFile() == ssdFile) {
+            ++numRewritten;
+          }
+        }
+      }));
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      false,
+      false,
+      common::CompressionKind_NONE,
+      true);
+  ssdFile_->waitForRecovery();
+  ASSERT_GT(numRewritten, 0);
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(stats.regionsPendingRecovery, 0);
+  EXPECT_EQ(stats.readCheckpointErrors, 0);
+  EXPECT_LT(stats.entriesRecovered, allEntries.size());
+
+  // The bytes of each region that are not erased are exactly the runs of the
+  // entries in it. Stale checkpointed runs of rewritten keys are erased.
+  std::vector<uint64_t> entryBytes(kSsdSize / SsdFile::kRegionSize);
+  for (const auto& [key, run] : ssdFileHelper_->eEntries()) {
+    entryBytes[run.offset() / SsdFile::kRegionSize] += run.size();
+  }
+  for (auto region = 0; region < entryBytes.size(); ++region) {
+    EXPECT_EQ(ssdFileHelper_->liveRegionBytes(region), entryBytes[region])
+        << "region " << region;
+  }
+
+  // Every entry that is found is read back from its latest run.
+  cache_->clear();
+  EXPECT_GE(checkEntries(allEntries), numRewritten);
+}
+
 TEST_F(SsdFileTest, recoverWithEvictedEntries) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 5 * SsdFile::kRegionSize;
@@ -820,6 +1075,33 @@ TEST_F(SsdFileTest, ssdReadWithoutChecksumCheck) {
 #endif
 }
 
+TEST_F(SsdFileTest, ioUringFailure) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  FLAGS_velox_io_uring = true;
+  SCOPE_EXIT {
+    IoUring::testingSetFailed(false);
+    FLAGS_velox_io_uring = false;
+  };
+  initializeCache(kSsdSize);
+
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+  ssdFile_->write(pins);
+
+  // Once the ring fails, the reads and writes use blocking IO.
+  IoUring::testingSetFailed(true);
+  ASSERT_EQ(IoUring::instance(), nullptr);
+  readAndCheckPins(pins);
+  auto newPins = makePins(
+      fileName_.id(), SsdFile::kRegionSize, 4096, 2048 * 1025, 62 * kMB);
+  ssdFile_->write(newPins);
+  readAndCheckPins(newPins);
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.writeSsdErrors, 0);
+  ASSERT_EQ(stats.readSsdErrors, 0);
+}
+
 TEST_F(SsdFileTest, dataFileErrorInjection) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   initializeCache(kSsdSize, 0, false, false, false, true);
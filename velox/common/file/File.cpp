@@ -16,9 +16,11 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 
@@ -264,10 +266,62 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+bool LocalReadFile::hasPreadvAsync() const {
+  return executor_ != nullptr || IoUring::instance() != nullptr;
+}
+
+std::optional<folly::SemiFuture<uint64_t>> LocalReadFile::preadvIoUring(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    filesystems::File::IoStats* stats) const {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr || buffers.size() > IOV_MAX) {
+    return std::nullopt;
+  }
+  // The skipped ranges are all read into one buffer that lives until the read
+  // completes.
+  size_t maxSkipSize = 0;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      maxSkipSize = std::max(maxSkipSize, range.size());
+    }
+  }
+  auto droppedBytes = std::make_unique<char[]>(maxSkipSize);
+  IoUring::Request request{fd_, false, offset, {}};
+  request.iovecs.reserve(buffers.size());
+  for (const auto& range : buffers) {
+    request.iovecs.push_back(
+        {range.data() != nullptr ? range.data() : droppedBytes.get(),
+         range.size()});
+  }
+  return ioUring->submit(std::move(request))
+      .deferValue([droppedBytes = std::move(droppedBytes),
+                   stats,
+                   start = std::chrono::steady_clock::now()](uint64_t bytes) {
+        if (stats != nullptr) {
+          stats->addCounter(kIoUringReads, RuntimeCounter(1));
+          stats->addCounter(
+              kIoUringReadBytes,
+              RuntimeCounter(bytes, RuntimeCounter::Unit::kBytes));
+          stats->addCounter(
+              kIoUringReadWallNanos,
+              RuntimeCounter(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count(),
+                  RuntimeCounter::Unit::kNanos));
+        }
+        return bytes;
+      });
+}
+
 folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers,
     filesystems::File::IoStats* stats) const {
+  if (auto future = preadvIoUring(offset, buffers, stats)) {
+    return std::move(future.value());
+  }
   if (!executor_) {
     return ReadFile::preadvAsync(offset, buffers, stats);
   }
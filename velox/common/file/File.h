@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -325,9 +326,15 @@ class LocalReadFile final : public ReadFile {
       const std::vector<folly::Range<char*>>& buffers,
       filesystems::File::IoStats* stats = nullptr) const override;
 
-  bool hasPreadvAsync() const override {
-    return executor_ != nullptr;
-  }
+  /// Returns true if reads can be issued asynchronously on 'executor_' or on
+  /// the io_uring. See IoUring.
+  bool hasPreadvAsync() const override;
+
+  /// The IoStats counters of the reads issued on the io_uring: the number of
+  /// reads, the read bytes and the wall time from submission to completion.
+  static constexpr const char* kIoUringReads = "ioUringReads";
+  static constexpr const char* kIoUringReadBytes = "ioUringReadBytes";
+  static constexpr const char* kIoUringReadWallNanos = "ioUringReadWallNanos";
 
   uint64_t memoryUsage() const final;
 
@@ -346,9 +353,23 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  /// Returns the file descriptor for issuing IO outside of this, e.g. batched
+  /// io_uring reads.
+  int32_t fd() const {
+    return fd_;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Reads 'buffers' with io_uring and records the read in 'stats' if not
+  // null. Returns nullopt if the read can not be issued as a single io_uring
+  // request.
+  std::optional<folly::SemiFuture<uint64_t>> preadvIoUring(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      filesystems::File::IoStats* stats) const;
+
   folly::Executor* const executor_;
   std::string path_;
   int32_t fd_;
@@ -404,6 +425,12 @@ class LocalWriteFile final : public WriteFile {
     return path_;
   }
 
+  /// Returns the file descriptor for issuing IO outside of this, e.g. batched
+  /// io_uring writes.
+  int32_t fd() const {
+    return fd_;
+  }
+
  private:
   // File descriptor.
   int32_t fd_{-1};
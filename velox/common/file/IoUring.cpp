@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+DEFINE_bool(
+    velox_io_uring,
+    false,
+    "Use io_uring for asynchronous local file and SSD cache IO if Velox is "
+    "built with io_uring support and the kernel supports it");
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    256,
+    "Number of submission queue entries of the io_uring");
+
+namespace facebook::velox {
+
+struct IoUring::Operation {
+  Request request;
+  // Total number of bytes to read or write.
+  uint64_t length;
+  // Number of bytes transferred by the completed submissions.
+  uint64_t transferred{0};
+  folly::Promise<uint64_t> promise;
+};
+
+#ifdef VELOX_ENABLE_IO_URING
+struct IoUring::Ring {
+  struct io_uring ring;
+};
+#else
+struct IoUring::Ring {};
+#endif
+
+namespace {
+uint64_t totalLength(const std::vector<iovec>& iovecs) {
+  uint64_t length = 0;
+  for (const auto& iov : iovecs) {
+    length += iov.iov_len;
+  }
+  return length;
+}
+
+// Removes the first 'bytes' from 'iovecs'.
+void skipBytes(std::vector<iovec>& iovecs, uint64_t bytes) {
+  auto it = iovecs.begin();
+  for (; it != iovecs.end() && bytes >= it->iov_len; ++it) {
+    bytes -= it->iov_len;
+  }
+  iovecs.erase(iovecs.begin(), it);
+  if (bytes > 0) {
+    VELOX_CHECK(!iovecs.empty());
+    auto& first = iovecs.front();
+    first.iov_base = static_cast<char*>(first.iov_base) + bytes;
+    first.iov_len -= bytes;
+  }
+}
+
+std::exception_ptr makeError(std::string message) {
+  try {
+    VELOX_FAIL("{}", message);
+  } catch (const std::exception&) {
+    return std::current_exception();
+  }
+}
+} // namespace
+
+std::atomic_bool IoUring::testingFailed_{false};
+
+// static
+void IoUring::testingSetFailed(bool failed) {
+  testingFailed_ = failed;
+}
+
+// static
+IoUring* IoUring::instance() {
+#ifdef VELOX_ENABLE_IO_URING
+  if (!FLAGS_velox_io_uring) {
+    return nullptr;
+  }
+  static const std::unique_ptr<IoUring> instance =
+      []() -> std::unique_ptr<IoUring> {
+    auto ring = std::make_unique<Ring>();
+    struct io_uring_params params {};
+    const auto rc = io_uring_queue_init_params(
+        FLAGS_velox_io_uring_queue_depth, &ring->ring, &params);
+    if (rc < 0) {
+      LOG(WARNING) << "io_uring is not available, using blocking IO: "
+                   << folly::errnoStr(-rc);
+      return nullptr;
+    }
+    auto ioUring = std::unique_ptr<IoUring>(new IoUring(std::move(ring)));
+    ioUring->maxInflight_ = params.cq_entries;
+    return ioUring;
+  }();
+  if (instance == nullptr || instance->failed_ || testingFailed_) {
+    return nullptr;
+  }
+  return instance.get();
+#else
+  return nullptr;
+#endif
+}
+
+IoUring::IoUring(std::unique_ptr<Ring> ring) : ring_(std::move(ring)) {
+  completionThread_ = std::thread([this]() { reapCompletions(); });
+}
+
+IoUring::~IoUring() {
+#ifdef VELOX_ENABLE_IO_URING
+  {
+    // Takes the submission queue for good so that the completion thread does
+    // not submit any more.
+    std::unique_lock<std::mutex> l(submitMutex_);
+    inflightCv_.wait(l, [&]() { return !submitting_; });
+    submitting_ = true;
+  }
+  bool stopped{false};
+  if (!failed_) {
+    // A nop without operation tells the completion thread to exit.
+    std::vector<Operation*> none;
+    submitToKernel(none);
+    auto* sqe = io_uring_get_sqe(&ring_->ring);
+    if (sqe != nullptr) {
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      stopped = io_uring_submit(&ring_->ring) > 0;
+    }
+  }
+  if (!stopped) {
+    // The completion thread can't be stopped. Leaves it and the ring it waits
+    // on behind at process exit.
+    LOG(ERROR) << "Failed to stop the io_uring completion thread";
+    completionThread_.detach();
+    (void)ring_.release();
+    return;
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_->ring);
+#endif
+}
+
+std::vector<folly::SemiFuture<uint64_t>> IoUring::submit(
+    std::vector<Request> requests) {
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  futures.reserve(requests.size());
+#ifdef VELOX_ENABLE_IO_URING
+  if (testingFailed_) {
+    const auto error = makeError("io_uring failed on a previous submission");
+    for (auto i = 0; i < requests.size(); ++i) {
+      futures.push_back(folly::makeSemiFuture<uint64_t>(
+          folly::exception_wrapper(error)));
+    }
+    return futures;
+  }
+  std::vector<std::unique_ptr<Operation>> operations;
+  operations.reserve(requests.size());
+  for (auto& request : requests) {
+    VELOX_CHECK_LE(request.iovecs.size(), IOV_MAX);
+    auto operation = std::make_unique<Operation>();
+    operation->length = totalLength(request.iovecs);
+    operation->request = std::move(request);
+    futures.push_back(operation->promise.getSemiFuture());
+    operations.push_back(std::move(operation));
+  }
+
+  std::unique_lock<std::mutex> l(submitMutex_);
+  for (auto& operation : operations) {
+    while (!failed_ && numInflight_ >= maxInflight_) {
+      // Submits the pending operations so that they complete and free up
+      // in-flight slots.
+      flushLocked(l, true);
+      inflightCv_.wait(l, [&]() {
+        return failed_ || numInflight_ < maxInflight_ ||
+            (!submitting_ && !pending_.empty());
+      });
+    }
+    if (failed_) {
+      operation->promise.setException(
+          makeError("io_uring failed on a previous submission"));
+      continue;
+    }
+    ++numInflight_;
+    pending_.push_back(operation.release());
+  }
+  flushLocked(l, true);
+#else
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+#endif
+  return futures;
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(Request request) {
+  std::vector<Request> requests;
+  requests.push_back(std::move(request));
+  return std::move(submit(std::move(requests))[0]);
+}
+
+void IoUring::flushLocked(std::unique_lock<std::mutex>& lock, bool mayWait) {
+#ifdef VELOX_ENABLE_IO_URING
+  if (submitting_) {
+    // The owner of the submission queue submits 'pending_' before it stops.
+    return;
+  }
+  submitting_ = true;
+  while (!failed_ && !(pending_.empty() && queued_.empty())) {
+    auto operations = std::move(pending_);
+    pending_.clear();
+    const auto numReaped = numReaped_;
+    lock.unlock();
+    const auto rc = submitToKernel(operations);
+    lock.lock();
+    // The operations that did not fit in the submission queue go first.
+    pending_.insert(pending_.begin(), operations.begin(), operations.end());
+    if (rc < 0 && rc != -EINTR && rc != -EAGAIN && rc != -EBUSY) {
+      LOG(ERROR) << "io_uring_submit failed: " << folly::errnoStr(-rc);
+      failed_ = true;
+      const auto error = makeError(
+          fmt::format("io_uring_submit failed: {}", folly::errnoStr(-rc)));
+      auto queued = std::move(queued_);
+      queued_.clear();
+      for (auto* operation : queued) {
+        failLocked(std::unique_ptr<Operation>(operation), error);
+      }
+      break;
+    }
+    if (queued_.empty() || rc == -EINTR) {
+      continue;
+    }
+    // The kernel is short of resources or has completions to be reaped.
+    if (!mayWait) {
+      break;
+    }
+    const auto reaped = [&]() { return failed_ || numReaped_ != numReaped; };
+    if (rc == -EBUSY) {
+      // The completion queue is full. Only reaping completions makes room.
+      inflightCv_.wait(lock, reaped);
+    } else {
+      inflightCv_.wait_for(lock, std::chrono::milliseconds(1), reaped);
+    }
+  }
+  if (failed_) {
+    const auto error = makeError("io_uring failed on a previous submission");
+    auto pending = std::move(pending_);
+    pending_.clear();
+    for (auto* operation : pending) {
+      failLocked(std::unique_ptr<Operation>(operation), error);
+    }
+  }
+  submitting_ = false;
+  inflightCv_.notify_all();
+#endif
+}
+
+int32_t IoUring::submitToKernel(std::vector<Operation*>& operations) {
+#ifdef VELOX_ENABLE_IO_URING
+  size_t numAdded = 0;
+  for (; numAdded < operations.size(); ++numAdded) {
+    auto* sqe = io_uring_get_sqe(&ring_->ring);
+    if (sqe == nullptr) {
+      break;
+    }
+    auto* operation = operations[numAdded];
+    const auto& request = operation->request;
+    if (request.isWrite) {
+      io_uring_prep_writev(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    } else {
+      io_uring_prep_readv(
+          sqe,
+          request.fd,
+          request.iovecs.data(),
+          request.iovecs.size(),
+          request.offset);
+    }
+    io_uring_sqe_set_data(sqe, operation);
+    queued_.push_back(operation);
+  }
+  operations.erase(operations.begin(), operations.begin() + numAdded);
+
+  int32_t rc = 0;
+  while (!queued_.empty()) {
+    rc = io_uring_submit(&ring_->ring);
+    if (rc <= 0) {
+      break;
+    }
+    // The kernel takes the submission queue entries in order.
+    VELOX_CHECK_LE(rc, queued_.size());
+    queued_.erase(queued_.begin(), queued_.begin() + rc);
+  }
+  return rc;
+#else
+  return 0;
+#endif
+}
+
+void IoUring::failLocked(
+    std::unique_ptr<Operation> operation,
+    const std::exception_ptr& error) {
+  VELOX_CHECK_GT(numInflight_, 0);
+  --numInflight_;
+  inflightCv_.notify_all();
+  operation->promise.setException(folly::exception_wrapper(error));
+}
+
+void IoUring::reapCompletions() {
+#ifdef VELOX_ENABLE_IO_URING
+  for (;;) {
+    bool unsubmitted;
+    {
+      // Retries the operations left behind when the kernel was short of
+      // resources and no other thread is submitting.
+      std::unique_lock<std::mutex> l(submitMutex_);
+      flushLocked(l, false);
+      unsubmitted =
+          !pending_.empty() || (!submitting_ && !queued_.empty());
+    }
+    struct io_uring_cqe* cqe{nullptr};
+    int rc;
+    if (unsubmitted) {
+      struct __kernel_timespec timeout {};
+      timeout.tv_nsec = 1'000'000;
+      rc = io_uring_wait_cqe_timeout(&ring_->ring, &cqe, &timeout);
+    } else {
+      rc = io_uring_wait_cqe(&ring_->ring, &cqe);
+    }
+    if (rc < 0) {
+      if (rc != -EINTR && rc != -ETIME) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+      }
+      continue;
+    }
+    auto* operation = static_cast<Operation*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_->ring, cqe);
+    {
+      std::lock_guard<std::mutex> l(submitMutex_);
+      ++numReaped_;
+    }
+    inflightCv_.notify_all();
+    if (operation == nullptr) {
+      return;
+    }
+    complete(std::unique_ptr<Operation>(operation), result);
+  }
+#endif
+}
+
+void IoUring::complete(std::unique_ptr<Operation> operation, int32_t result) {
+  auto& request = operation->request;
+  if (result == -EINTR || result == -EAGAIN) {
+    // Retries the interrupted transfer. The operation keeps its in-flight
+    // slot.
+    std::unique_lock<std::mutex> l(submitMutex_);
+    pending_.push_back(operation.release());
+    flushLocked(l, false);
+    return;
+  }
+  if (result < 0) {
+    auto error = makeError(fmt::format(
+        "io_uring {} failed: {}",
+        request.isWrite ? "write" : "read",
+        folly::errnoStr(-result)));
+    std::lock_guard<std::mutex> l(submitMutex_);
+    failLocked(std::move(operation), error);
+    return;
+  }
+  operation->transferred += result;
+  if (operation->transferred == operation->length) {
+    finish(std::move(operation));
+    return;
+  }
+  if (result == 0) {
+    // A read may stop short at end of file in which case the bytes read so far
+    // are returned. A write that makes no progress fails.
+    if (!request.isWrite) {
+      finish(std::move(operation));
+      return;
+    }
+    auto error = makeError(fmt::format(
+        "Short io_uring write: {} of {} bytes",
+        operation->transferred,
+        operation->length));
+    std::lock_guard<std::mutex> l(submitMutex_);
+    failLocked(std::move(operation), error);
+    return;
+  }
+  // Resubmits the remaining bytes of a short transfer. The operation keeps its
+  // in-flight slot.
+  skipBytes(request.iovecs, result);
+  request.offset += result;
+  std::unique_lock<std::mutex> l(submitMutex_);
+  pending_.push_back(operation.release());
+  flushLocked(l, false);
+}
+
+void IoUring::finish(std::unique_ptr<Operation> operation) {
+  {
+    std::lock_guard<std::mutex> l(submitMutex_);
+    VELOX_CHECK_GT(numInflight_, 0);
+    --numInflight_;
+  }
+  inflightCv_.notify_all();
+  operation->promise.setValue(operation->transferred);
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/futures/Future.h>
+#include <folly/portability/SysUio.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DECLARE_bool(velox_io_uring);
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+
+/// Asynchronous positional file IO on an io_uring shared by the process.
+/// Requests are submitted from the calling thread without blocking and are
+/// completed by a single completion thread which fulfills the returned
+/// futures. This avoids tying up an executor thread per outstanding IO.
+///
+/// A short transfer is resubmitted for the remaining bytes until the request
+/// completes, a read reaches the end of file or an error occurs. The number of
+/// operations in flight is bounded by the completion queue size, so the
+/// completion queue never overflows. Submitting threads wait for the kernel
+/// without holding the submission lock, and the completion thread resubmits
+/// without ever waiting, so that it always gets to reap completions.
+///
+/// io_uring is only used if Velox is built with VELOX_ENABLE_IO_URING, the
+/// 'velox_io_uring' flag is set and the kernel supports it. Otherwise
+/// instance() returns nullptr and the callers fall back to blocking IO. If the
+/// kernel rejects a submission with an unrecoverable error, the operations not
+/// taken by the kernel fail and instance() returns nullptr from then on.
+class IoUring {
+ public:
+  /// A positional readv or writev of 'iovecs' on 'fd' at 'offset'.
+  struct Request {
+    int32_t fd;
+    bool isWrite;
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+  };
+
+  /// Returns the process wide io_uring or nullptr if io_uring is disabled, not
+  /// available or has failed.
+  static IoUring* instance();
+
+  /// Makes the ring behave as if a submission had failed with an
+  /// unrecoverable error if 'failed' is true: instance() returns nullptr and
+  /// submit() fails the requests. Undone with false. Used in tests only.
+  static void testingSetFailed(bool failed);
+
+  ~IoUring();
+
+  /// Submits 'requests' to the kernel with as few system calls as the queue
+  /// depth allows. Returns a future per request that is fulfilled with the
+  /// number of bytes transferred once all the bytes of the request have been
+  /// read or written. The memory referenced by the iovecs must stay valid
+  /// until the future is fulfilled.
+  std::vector<folly::SemiFuture<uint64_t>> submit(
+      std::vector<Request> requests);
+
+  /// Submits a single request. See above.
+  folly::SemiFuture<uint64_t> submit(Request request);
+
+ private:
+  struct Operation;
+  struct Ring;
+
+  explicit IoUring(std::unique_ptr<Ring> ring);
+
+  // Hands the operations in 'pending_' to the kernel unless another thread is
+  // already doing so. 'submitMutex_' is held on entry and on return but is
+  // released while entering the kernel and while waiting. If 'mayWait' is
+  // true, waits for the kernel to take all the operations. Otherwise, gives up
+  // when the kernel is short of resources and leaves the rest to the next
+  // call. The completion thread never waits since only it frees completion
+  // queue space.
+  void flushLocked(std::unique_lock<std::mutex>& lock, bool mayWait);
+
+  // Adds as many of 'operations' to the submission queue as fit and submits
+  // the submission queue to the kernel. Removes the added operations from
+  // 'operations'. Returns the result of the last io_uring_submit() call. Only
+  // called by the thread that set 'submitting_', without 'submitMutex_'.
+  int32_t submitToKernel(std::vector<Operation*>& operations);
+
+  // Fails 'operation' with 'error' and releases its in-flight slot. The caller
+  // holds 'submitMutex_'.
+  void failLocked(
+      std::unique_ptr<Operation> operation,
+      const std::exception_ptr& error);
+
+  // Completion thread loop that fulfills the promises of the completed
+  // operations until shutdown.
+  void reapCompletions();
+
+  // Handles the completion of a submission of 'operation' which transferred
+  // 'result' bytes or failed with -'result'. Resubmits the remaining bytes of
+  // a short transfer.
+  void complete(std::unique_ptr<Operation> operation, int32_t result);
+
+  // Fulfills the promise of 'operation' with the transferred bytes and
+  // releases its in-flight slot.
+  void finish(std::unique_ptr<Operation> operation);
+
+  std::unique_ptr<Ring> ring_;
+
+  // Max number of operations in flight. It is the completion queue size so
+  // that the completions never overflow.
+  uint32_t maxInflight_{0};
+
+  // Guards the members below. Not held while entering the kernel.
+  std::mutex submitMutex_;
+
+  // Notified when an operation completes, completions are reaped or a thread
+  // stops submitting.
+  std::condition_variable inflightCv_;
+
+  // Number of operations submitted or queued and not yet completed.
+  uint32_t numInflight_{0};
+
+  // Number of completions reaped so far.
+  uint64_t numReaped_{0};
+
+  // The operations to submit which are not yet in the submission queue, in
+  // submission order.
+  std::vector<Operation*> pending_;
+
+  // Set while a thread owns the submission queue. Only the owner accesses the
+  // submission queue and 'queued_'.
+  bool submitting_{false};
+
+  // The operations in the submission queue which have not been taken by the
+  // kernel, in submission order.
+  std::vector<Operation*> queued_;
+
+  // Set if a submission failed with an unrecoverable error. The ring is not
+  // entered again, so the kernel never takes the failed operations.
+  std::atomic_bool failed_{false};
+
+  static std::atomic_bool testingFailed_;
+
+  std::thread completionThread_;
+};
+
+} // namespace facebook::velox
@@ -15,11 +15,13 @@
  */
 
 #include <fcntl.h>
+#include <folly/ScopeGuard.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -233,6 +235,94 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, ioUring) {
+  if (useFaultyFs_) {
+    return;
+  }
+  FLAGS_velox_io_uring = true;
+  SCOPE_EXIT {
+    FLAGS_velox_io_uring = false;
+  };
+  auto* ioUring = IoUring::instance();
+
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  // Falls back to synchronous reads if io_uring is not available.
+  auto readFile = std::make_shared<LocalReadFile>(filename);
+  ASSERT_EQ(readFile->hasPreadvAsync(), ioUring != nullptr);
+  readData(readFile.get(), true, true);
+  if (ioUring == nullptr) {
+    return;
+  }
+
+  // Writes and reads back a batch of requests.
+  LocalWriteFile writeFile(filename, false, false);
+  std::string data1(1000, 'x');
+  std::string data2(3000, 'y');
+  std::vector<IoUring::Request> writes;
+  writes.push_back({writeFile.fd(), true, 100, {{data1.data(), data1.size()}}});
+  writes.push_back(
+      {writeFile.fd(), true, 200'000, {{data2.data(), data2.size()}}});
+  auto writeFutures = ioUring->submit(std::move(writes));
+  ASSERT_EQ(std::move(writeFutures[0]).get(), data1.size());
+  ASSERT_EQ(std::move(writeFutures[1]).get(), data2.size());
+
+  std::string read1(data1.size(), '\0');
+  std::string read2(data2.size(), '\0');
+  std::vector<IoUring::Request> reads;
+  reads.push_back({readFile->fd(), false, 100, {{read1.data(), read1.size()}}});
+  reads.push_back(
+      {readFile->fd(), false, 200'000, {{read2.data(), read2.size()}}});
+  auto readFutures = ioUring->submit(std::move(reads));
+  ASSERT_EQ(std::move(readFutures[0]).get(), read1.size());
+  ASSERT_EQ(std::move(readFutures[1]).get(), read2.size());
+  ASSERT_EQ(read1, data1);
+  ASSERT_EQ(read2, data2);
+
+  // A read past the end of file returns the bytes read.
+  std::string tail(100, '\0');
+  ASSERT_EQ(
+      ioUring
+          ->submit(IoUring::Request{
+              readFile->fd(),
+              false,
+              15 + kOneMB - 10,
+              {{tail.data(), tail.size()}}})
+          .get(),
+      10);
+
+  // Submits more requests than the submission and completion queues hold.
+  const int32_t numReads = 4 * FLAGS_velox_io_uring_queue_depth + 1;
+  std::string bytes(numReads, '\0');
+  reads.clear();
+  for (auto i = 0; i < numReads; ++i) {
+    reads.push_back({readFile->fd(), false, 100, {{&bytes[i], 1}}});
+  }
+  readFutures = ioUring->submit(std::move(reads));
+  for (auto& future : readFutures) {
+    ASSERT_EQ(std::move(future).get(), 1);
+  }
+  ASSERT_EQ(bytes, std::string(numReads, 'x'));
+
+  // The io_uring reads are recorded in the IoStats.
+  filesystems::File::IoStats ioStats;
+  std::string buffer(10, '\0');
+  const std::vector<folly::Range<char*>> buffers{
+      folly::Range<char*>(buffer.data(), buffer.size())};
+  ASSERT_EQ(
+      readFile->preadvAsync(100, buffers, &ioStats).get(), buffer.size());
+  const auto stats = ioStats.stats();
+  ASSERT_EQ(stats.at(LocalReadFile::kIoUringReads).sum, 1);
+  ASSERT_EQ(stats.at(LocalReadFile::kIoUringReadBytes).sum, buffer.size());
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
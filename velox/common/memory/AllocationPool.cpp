@@ -21,6 +21,25 @@
 
 namespace facebook::velox::memory {
 
+AllocationPool::AllocationPool(AllocationPool&& other) noexcept
+    : pool_(other.pool_),
+      allocations_(std::move(other.allocations_)),
+      largeAllocations_(std::move(other.largeAllocations_)),
+      runs_(std::move(other.runs_)),
+      startOfRun_(other.startOfRun_),
+      bytesInRun_(other.bytesInRun_),
+      currentOffset_(other.currentOffset_),
+      usedBytes_(other.usedBytes_),
+      hugePageThreshold_(other.hugePageThreshold_) {
+  other.allocations_.clear();
+  other.largeAllocations_.clear();
+  other.runs_.clear();
+  other.startOfRun_ = nullptr;
+  other.bytesInRun_ = 0;
+  other.currentOffset_ = 0;
+  other.usedBytes_ = 0;
+}
+
 folly::Range<char*> AllocationPool::rangeAt(int32_t index) const {
   if (index < allocations_.size()) {
     auto run = allocations_[index].runAt(0);
@@ -39,9 +58,22 @@ folly::Range<char*> AllocationPool::rangeAt(int32_t index) const {
   VELOX_FAIL("Out of range index for rangeAt(): {}", index);
 }
 
+bool AllocationPool::contains(const void* ptr) const {
+  const auto* address = reinterpret_cast<const char*>(ptr);
+  auto it = runs_.upper_bound(address);
+  if (it == runs_.begin()) {
+    return false;
+  }
+  --it;
+  // Only the part of the current run before the first free byte is in use.
+  const auto size = it->first == startOfRun_ ? currentOffset_ : it->second;
+  return address < it->first + size;
+}
+
 void AllocationPool::clear() {
   allocations_.clear();
   largeAllocations_.clear();
+  runs_.clear();
   startOfRun_ = nullptr;
   bytesInRun_ = 0;
   currentOffset_ = 0;
@@ -124,6 +156,7 @@ void AllocationPool::newRunImpl(MachinePageCount numPages) {
     startOfRun_ = range.data();
     bytesInRun_ = range.size();
     largeAllocations_.emplace_back(std::move(largeAlloc));
+    runs_[startOfRun_] = bytesInRun_;
     currentOffset_ = 0;
     usedBytes_ += AllocationTraits::pageBytes(pagesToAlloc);
     return;
@@ -137,6 +170,7 @@ void AllocationPool::newRunImpl(MachinePageCount numPages) {
   bytesInRun_ = allocation.runAt(0).numBytes();
   currentOffset_ = 0;
   allocations_.push_back(std::move(allocation));
+  runs_[startOfRun_] = bytesInRun_;
   usedBytes_ += bytesInRun_;
 }
 
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <map>
+
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
@@ -30,6 +32,10 @@ class AllocationPool {
 
   explicit AllocationPool(memory::MemoryPool* pool) : pool_(pool) {}
 
+  /// Takes over the allocations of 'other'. 'other' is left empty and can
+  /// continue to allocate from the same MemoryPool.
+  AllocationPool(AllocationPool&& other) noexcept;
+
   ~AllocationPool() {
     clear();
   }
@@ -89,6 +95,10 @@ class AllocationPool {
     return pool_;
   }
 
+  /// Returns true if 'ptr' is inside any of the ranges of 'this'. Takes
+  /// logarithmic time in the number of ranges.
+  bool contains(const void* ptr) const;
+
   /// Returns true if 'ptr' is inside the range allocations are made from.
   bool isInCurrentRange(void* ptr) const {
     return reinterpret_cast<char*>(ptr) >= startOfRun_ &&
@@ -141,6 +151,10 @@ class AllocationPool {
   std::vector<memory::Allocation> allocations_;
   std::vector<memory::ContiguousAllocation> largeAllocations_;
 
+  // Maps the start of each run in 'allocations_' and 'largeAllocations_' to
+  // its addressable size. Used for looking up the run containing an address.
+  std::map<const char*, int64_t> runs_;
+
   // Points to the start of the run from which allocations are being made.
   char* startOfRun_{nullptr};
 
@@ -85,11 +85,19 @@ HashStringAllocator::~HashStringAllocator() {
   clear();
 }
 
-void HashStringAllocator::clear() {
+void HashStringAllocator::resetFreeLists() {
   state_.numFree() = 0;
   state_.freeBytes() = 0;
   std::fill(
       std::begin(state_.freeNonEmpty()), std::end(state_.freeNonEmpty()), 0);
+  for (auto i = 0; i < kNumFreeLists; ++i) {
+    new (&state_.freeLists()[i]) CompactDoubleList();
+  }
+}
+
+void HashStringAllocator::clear() {
+  resetFreeLists();
+  state_.compactedSlabs().reset();
   for (auto& pair : state_.allocationsFromPool()) {
     const auto size = pair.second;
     pool()->free(pair.first, size);
@@ -97,9 +105,6 @@ void HashStringAllocator::clear() {
     state_.currentBytes() -= size;
   }
   state_.allocationsFromPool().clear();
-  for (auto i = 0; i < kNumFreeLists; ++i) {
-    new (&state_.freeLists()[i]) CompactDoubleList();
-  }
 
 #ifndef NDEBUG
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
@@ -440,6 +445,12 @@ HashStringAllocator::Header* HashStringAllocator::allocateFromFreeList(
 }
 
 void HashStringAllocator::free(Header* header) {
+  if (state_.compactedSlabs() != nullptr &&
+      state_.compactedSlabs()->contains(header)) {
+    // The block is released with the slabs being compacted. Its continuations
+    // are in the same slabs.
+    return;
+  }
   Header* headerToFree = header;
   do {
     Header* continued = nullptr;
@@ -489,6 +500,99 @@ void HashStringAllocator::free(Header* header) {
   } while (headerToFree != nullptr);
 }
 
+double HashStringAllocator::freeRatio() const {
+  const auto slabBytes = state_.pool().allocatedBytes();
+  if (slabBytes == 0) {
+    return 0;
+  }
+  return static_cast<double>(state_.freeBytes()) / slabBytes;
+}
+
+int64_t HashStringAllocator::compact(
+    const std::function<void(const Relocator&)>& relocateAll) {
+  VELOX_CHECK_NULL(
+      state_.currentHeader(),
+      "Do not call compact() when a write is in progress");
+  if (state_.compactedSlabs() != nullptr) {
+    // A previous compaction failed. Its slabs may still be referenced.
+    return 0;
+  }
+  const auto sizeBefore = retainedSize();
+  state_.compactedSlabs() =
+      std::make_unique<memory::AllocationPool>(std::move(state_.pool()));
+  resetFreeLists();
+  // Only the blocks allocated directly from the pool remain.
+  state_.currentBytes() = state_.sizeFromPool();
+
+  relocateAll([this](Header* header) { return relocate(header); });
+
+  // On error the old slabs stay in 'compactedSlabs_' until clear().
+  state_.compactedSlabs().reset();
+  return sizeBefore - retainedSize();
+}
+
+HashStringAllocator::Header* HashStringAllocator::relocate(Header* header) {
+  auto* oldSlabs = state_.compactedSlabs().get();
+  VELOX_CHECK_NOT_NULL(oldSlabs);
+  if (!oldSlabs->contains(header)) {
+    // A block allocated directly from the pool stays in place but the rest of
+    // the allocation may have to move.
+    if (header->isContinued()) {
+      auto** next = reinterpret_cast<Header**>(
+          header->end() - Header::kContinuedPtrSize);
+      *next = relocate(*next);
+    }
+    return header;
+  }
+  if (header->isFree()) {
+    // A live block is marked free after it has been relocated. The first word
+    // points to the copy.
+    return *reinterpret_cast<Header**>(header->begin());
+  }
+
+  int64_t size = 0;
+  for (auto* part = header;; part = part->nextContinued()) {
+    size += part->usableSize();
+    if (!part->isContinued()) {
+      break;
+    }
+  }
+
+  // Calls 'copy' on the payload of each part. Frees the parts allocated
+  // directly from the pool after they are copied.
+  const auto copyParts = [&](const auto& copy) {
+    for (auto* part = header; part != nullptr;) {
+      auto* next = part->isContinued() ? part->nextContinued() : nullptr;
+      copy(part->begin(), part->usableSize());
+      if (!oldSlabs->contains(part)) {
+        part->clearContinued();
+        free(part);
+      }
+      part = next;
+    }
+  };
+
+  Header* newHeader;
+  if (size <= kMaxAlloc) {
+    newHeader = allocate(std::max<int64_t>(size, kMinAlloc), true);
+    auto* destination = newHeader->begin();
+    copyParts([&](const char* data, int32_t bytes) {
+      ::memcpy(destination, data, bytes);
+      destination += bytes;
+    });
+  } else {
+    ByteOutputStream stream(this, false, false);
+    newWrite(stream, static_cast<int32_t>(size));
+    copyParts([&](const char* data, int32_t bytes) {
+      stream.appendStringView(std::string_view(data, bytes));
+    });
+    newHeader = finishWrite(stream, 0).first.header;
+  }
+  header->setFree();
+  *reinterpret_cast<Header**>(header->begin()) = newHeader;
+  return newHeader;
+}
+
 // static
 int64_t HashStringAllocator::offset(Header* header, Position position) {
   static const int64_t kOutOfRange = -1;
@@ -25,6 +25,8 @@
 
 #include <folly/container/F14Map.h>
 
+#include <functional>
+
 namespace facebook::velox {
 
 /// Implements an arena backed by memory::Allocation. This is for backing
@@ -292,7 +294,10 @@ class HashStringAllocator : public StreamArena {
 
   /// Returns the total memory footprint of 'this'.
   int64_t retainedSize() const {
-    return state_.pool().allocatedBytes() + state_.sizeFromPool();
+    return state_.pool().allocatedBytes() + state_.sizeFromPool() +
+        (state_.compactedSlabs() != nullptr
+             ? state_.compactedSlabs()->allocatedBytes()
+             : 0);
   }
 
   /// Adds the allocation of 'header' and any extensions (if header has
@@ -310,6 +315,30 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  /// Returns the fraction of the slab memory of 'this' that is on the free
+  /// lists. A high ratio means that the live blocks are scattered over mostly
+  /// empty slabs, which compact() can return to pool().
+  double freeRatio() const;
+
+  /// Maps the first Header of a live allocation to the first Header of its
+  /// relocated copy. See compact().
+  using Relocator = std::function<Header*(Header*)>;
+
+  /// Moves the live blocks of 'this' into fresh slabs and frees the old slabs.
+  /// 'relocateAll' is called with a Relocator and must pass the first Header
+  /// of every live allocation referenced by the owners of 'this' to it,
+  /// replacing the references with the returned Header. A multipart
+  /// allocation is copied as a whole and keeps the logical offsets of its
+  /// payload, so that a Position inside it is remapped with offset() before
+  /// and seek() after the relocation. The Relocator may be called more than
+  /// once for the same allocation. Blocks allocated directly from pool() are
+  /// not moved. Freeing a block of the old slabs while 'relocateAll' runs is a
+  /// no-op and blocks which are not passed to the Relocator are released with
+  /// the old slabs. Returns the number of bytes released. If 'relocateAll'
+  /// throws, the old slabs are kept until clear() and further compactions are
+  /// no-ops.
+  int64_t compact(const std::function<void(const Relocator&)>& relocateAll);
+
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
@@ -401,6 +430,14 @@ class HashStringAllocator : public StreamArena {
   // Returns the free list index for 'size'.
   int32_t freeListIndex(int size);
 
+  // Empties the free lists without touching the blocks on them.
+  void resetFreeLists();
+
+  // Relocator used by compact(). Copies the allocation starting at 'header'
+  // from the old slabs to a new block and leaves a forwarding pointer in the
+  // old block.
+  Header* relocate(Header* header);
+
   /// A class that wraps any fields in the HashStringAllocator, it's main
   /// purpose is to simplify the freeze/unfreeze mechanic.  Fields are exposed
   /// via accessor methods, attempting to invoke a non-const accessor when the
@@ -489,6 +526,11 @@ class HashStringAllocator : public StreamArena {
     // Sum of sizes in 'allocationsFromPool_'.
     DECLARE_FIELD_WITH_INIT_VALUE(int64_t, sizeFromPool, 0);
 
+    // The slabs being vacated while compact() is running. Non-null only
+    // during compaction or after a compaction failed, in which case the slabs
+    // are kept until clear() since the owners may still reference them.
+    DECLARE_FIELD(std::unique_ptr<memory::AllocationPool>, compactedSlabs);
+
 #undef DECLARE_FIELD_WITH_INIT_VALUE
 #undef DECLARE_FIELD
 #undef DECLARE_GETTERS
@@ -169,21 +169,25 @@ bool MallocAllocator::allocateContiguousImpl(
     VELOX_MEM_LOG_EVERY_MS(WARNING, 1000) << errorMsg;
     return false;
   }
+  void* data = mapContiguous(AllocationTraits::pageBytes(maxPages));
+  if (data == MAP_FAILED) {
+    const auto errorMsg = fmt::format(
+        "Mmap failed with {} pages, errno {}",
+        maxPages,
+        folly::errnoStr(errno));
+    VELOX_MEM_LOG(ERROR) << errorMsg;
+    setAllocatorFailureMessage(errorMsg);
+    decrementUsage(totalBytes);
+    return false;
+  }
   numAllocated_.fetch_add(numPages);
   numMapped_.fetch_add(numPages);
-  void* data = ::mmap(
-      nullptr,
-      AllocationTraits::pageBytes(maxPages),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  // TODO: add handling of MAP_FAILED.
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
   useHugePages(allocation, true);
+  prefaultHugePages(allocation, 0, allocation.size());
   return true;
 }
 
@@ -248,10 +252,12 @@ bool MallocAllocator::growContiguousWithoutRetry(
   }
   numAllocated_ += increment;
   numMapped_ += increment;
+  const auto oldSize = allocation.size();
   allocation.set(
       allocation.data(),
-      allocation.size() + AllocationTraits::kPageSize * increment,
+      oldSize + AllocationTraits::kPageSize * increment,
       allocation.maxSize());
+  prefaultHugePages(allocation, oldSize, allocation.size() - oldSize);
   return true;
 }
 
@@ -52,6 +52,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaNodes = options.numaAware ? numaNumNodes() : 0;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -61,7 +62,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
 }
 
 std::unique_ptr<MemoryArbitrator> createArbitrator(
-    const MemoryManager::Options& options) {
+    const MemoryManager::Options& options,
+    MemoryAllocator* allocator) {
   // TODO: consider to reserve a small amount of memory to compensate for the
   //  non-reclaimable cache memory which are pinned by query accesses if
   //  enabled.
@@ -71,7 +73,8 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .capacity =
            std::min(options.arbitratorCapacity, options.allocatorCapacity),
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
-       .extraConfigs = options.extraArbitratorConfigs});
+       .extraConfigs = options.extraArbitratorConfigs,
+       .allocator = allocator});
 }
 
 std::shared_ptr<MemoryAllocator> createAllocator(
@@ -82,6 +85,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.largestSizeClass = options.largestSizeClassPages;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaNodes = options.numaAware ? numaNumNodes() : 0;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -91,7 +95,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
 }
 
 std::unique_ptr<MemoryArbitrator> createArbitrator(
-    const MemoryManagerOptions& options) {
+    const MemoryManagerOptions& options,
+    MemoryAllocator* allocator) {
   // TODO: consider to reserve a small amount of memory to compensate for the
   //  non-reclaimable cache memory which are pinned by query accesses if
   //  enabled.
@@ -101,7 +106,8 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .capacity =
            std::min(options.arbitratorCapacity, options.allocatorCapacity),
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
-       .extraConfigs = options.extraArbitratorConfigs});
+       .extraConfigs = options.extraArbitratorConfigs,
+       .allocator = allocator});
 }
 
 std::vector<std::shared_ptr<MemoryPool>> createSharedLeafMemoryPools(
@@ -121,11 +127,12 @@ std::vector<std::shared_ptr<MemoryPool>> createSharedLeafMemoryPools(
 
 MemoryManager::MemoryManager(const MemoryManager::Options& options)
     : allocator_{createAllocator(options)},
-      arbitrator_(createArbitrator(options)),
+      arbitrator_(createArbitrator(options, allocator_.get())),
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
+      smallAllocationCacheBytes_(options.smallAllocationCacheBytes),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       sysRoot_{std::make_shared<MemoryPoolImpl>(
@@ -165,11 +172,12 @@ MemoryManager::MemoryManager(const MemoryManager::Options& options)
 
 MemoryManager::MemoryManager(const MemoryManagerOptions& options)
     : allocator_{createAllocator(options)},
-      arbitrator_(createArbitrator(options)),
+      arbitrator_(createArbitrator(options, allocator_.get())),
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
       disableMemoryPoolTracking_(options.disableMemoryPoolTracking),
+      smallAllocationCacheBytes_(options.smallAllocationCacheBytes),
       getPreferredSize_(options.getPreferredSize),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       sysRoot_{std::make_shared<MemoryPoolImpl>(
@@ -347,6 +355,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.getPreferredSize = getPreferredSize_;
   options.debugOptions = poolDebugOpts;
   options.poolPriority = poolPriority;
+  options.smallAllocationCacheBytes = smallAllocationCacheBytes_;
 
   auto pool = createRootPool(poolName, reclaimer, options);
   if (!disableMemoryPoolTracking_) {
@@ -80,6 +80,11 @@ struct MemoryManagerOptions {
   /// Disables the memory manager's tracking on memory pools.
   bool disableMemoryPoolTracking{false};
 
+  /// If not zero, the leaf pools of the root pools created by addRootPool()
+  /// keep up to this many bytes of freed small buffers for reuse. See
+  /// MemoryPool::Options::smallAllocationCacheBytes.
+  int64_t smallAllocationCacheBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
 
   /// Specifies the max memory allocation capacity in bytes enforced by
@@ -108,6 +113,13 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// If true, MmapAllocator keeps size classes per NUMA node of the host and
+  /// serves allocations from the node of the allocating thread. See
+  /// MmapAllocator::Options::numaNodes.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAware{false};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -197,6 +209,11 @@ class MemoryManager {
     /// Disables the memory manager's tracking on memory pools.
     bool disableMemoryPoolTracking{false};
 
+    /// If not zero, the leaf pools of the root pools created by addRootPool()
+    /// keep up to this many bytes of freed small buffers for reuse. See
+    /// MemoryPool::Options::smallAllocationCacheBytes.
+    int64_t smallAllocationCacheBytes{0};
+
     /// ================== 'MemoryAllocator' settings ==================
 
     /// Specifies the max memory allocation capacity in bytes enforced by
@@ -225,6 +242,13 @@ class MemoryManager {
     /// NOTE: this only applies for MmapAllocator.
     int32_t mmapArenaCapacityRatio{10};
 
+    /// If true, MmapAllocator keeps size classes per NUMA node of the host and
+    /// serves allocations from the node of the allocating thread. See
+    /// MmapAllocator::Options::numaNodes.
+    ///
+    /// NOTE: this only applies for MmapAllocator.
+    bool numaAware{false};
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
     /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will
@@ -433,6 +457,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool coreOnAllocationFailureEnabled_;
   const bool disableMemoryPoolTracking_;
+  const int64_t smallAllocationCacheBytes_;
   const std::function<size_t(size_t)> getPreferredSize_;
 
   // The destruction callback set for the allocated root memory pools which are
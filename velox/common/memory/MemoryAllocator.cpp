@@ -26,6 +26,12 @@
 #include "velox/common/memory/Memory.h"
 
 DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_int64(velox_memory_hugepage_align_bytes);
+DECLARE_bool(velox_memory_prefault_hugepages);
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
 
 namespace facebook::velox::memory {
 
@@ -373,6 +379,11 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numaLocalBytes = numaLocalBytes - other.numaLocalBytes;
+  result.numaRemoteBytes = numaRemoteBytes - other.numaRemoteBytes;
+  result.hugePageBytes = hugePageBytes;
+  result.prefaultedHugePageBytes =
+      prefaultedHugePageBytes - other.prefaultedHugePageBytes;
   return result;
 }
 
@@ -392,6 +403,18 @@ std::string Stats::toString() const {
       totalClocks >> 30,
       totalAllocations,
       numAdvise >> 8);
+  if (numaLocalBytes + numaRemoteBytes > 0) {
+    out << fmt::format(
+        "NUMA local: {}MB remote: {}MB\n",
+        numaLocalBytes >> 20,
+        numaRemoteBytes >> 20);
+  }
+  if (hugePageBytes + prefaultedHugePageBytes > 0) {
+    out << fmt::format(
+        "Huge pages: {}MB prefaulted: {}MB\n",
+        hugePageBytes >> 20,
+        prefaultedHugePageBytes >> 20);
+  }
 
   // Sort the size classes by decreasing clocks.
   std::vector<int32_t> indices(sizes.size());
@@ -433,6 +456,80 @@ void MemoryAllocator::useHugePages(
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
   }
+  // Counted whether or not madvise succeeds so that the free of an allocation
+  // subtracts exactly what its allocation added.
+  if (enable) {
+    hugePageBytes_ += maybeRange.value().size();
+  } else {
+    hugePageBytes_ -= maybeRange.value().size();
+  }
+#endif
+}
+
+// static
+void* MemoryAllocator::mapContiguous(uint64_t bytes) {
+  const auto kHugePageSize = AllocationTraits::kHugePageSize;
+  if (!FLAGS_velox_memory_use_hugepages ||
+      FLAGS_velox_memory_hugepage_align_bytes <= 0 ||
+      bytes < FLAGS_velox_memory_hugepage_align_bytes) {
+    return ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+  }
+  // Maps an extra huge page and unmaps the unaligned head and tail.
+  auto* data = reinterpret_cast<char*>(::mmap(
+      nullptr,
+      bytes + kHugePageSize,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0));
+  if (data == MAP_FAILED) {
+    return MAP_FAILED;
+  }
+  auto* aligned = reinterpret_cast<char*>(
+      bits::roundUp(reinterpret_cast<uintptr_t>(data), kHugePageSize));
+  const auto headBytes = aligned - data;
+  if (headBytes > 0) {
+    ::munmap(data, headBytes);
+  }
+  const auto tailBytes = kHugePageSize - headBytes;
+  if (tailBytes > 0) {
+    ::munmap(aligned + bytes, tailBytes);
+  }
+  return aligned;
+}
+
+void MemoryAllocator::prefaultHugePages(
+    const ContiguousAllocation& data,
+    uint64_t offset,
+    uint64_t bytes) {
+#ifdef linux
+  if (!FLAGS_velox_memory_use_hugepages ||
+      !FLAGS_velox_memory_prefault_hugepages || bytes == 0) {
+    return;
+  }
+  const auto maybeRange = data.hugePageRange();
+  if (!maybeRange.has_value()) {
+    return;
+  }
+  // Only the part of ['offset', 'offset' + 'bytes') that is in the huge page
+  // range.
+  auto* begin = std::max(data.data<char>() + offset, maybeRange->begin());
+  auto* end = std::min(data.data<char>() + offset + bytes, maybeRange->end());
+  if (begin >= end) {
+    return;
+  }
+  if (::madvise(begin, end - begin, MADV_POPULATE_WRITE) != 0) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 60'000)
+        << "madvise populate errno=" << folly::errnoStr(errno);
+    return;
+  }
+  prefaultedHugePageBytes_ += end - begin;
 #endif
 }
 
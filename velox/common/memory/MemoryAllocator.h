@@ -136,6 +136,16 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Cumulative bytes allocated from the NUMA node of the allocating thread's
+  /// CPU and from other nodes, if the allocator is NUMA aware.
+  int64_t numaLocalBytes{0};
+  int64_t numaRemoteBytes{0};
+
+  /// Bytes in the huge page ranges of the live contiguous allocations and
+  /// cumulative bytes of huge pages faulted in at allocation time.
+  int64_t hugePageBytes{0};
+  int64_t prefaultedHugePageBytes{0};
 };
 
 class MemoryAllocator;
@@ -162,6 +172,26 @@ class Cache {
   /// 'targetBytes'. The method returns the actually freed cache space in bytes.
   virtual uint64_t shrink(uint64_t targetBytes) = 0;
 
+  /// Frees up to 'targetBytes' of cache space in the background to make room
+  /// for the query memory. Unlike shrink(), this is not for an urgent memory
+  /// need: it only evicts the cold entries and lets the SSD admissible entries
+  /// be saved to SSD first if possible. The method returns the actually freed
+  /// cache space in bytes.
+  virtual uint64_t shrinkInBackground(uint64_t targetBytes) {
+    return shrink(targetBytes);
+  }
+
+  /// Returns the memory space held by the cache in bytes.
+  virtual uint64_t cachedBytes() const {
+    return 0;
+  }
+
+  /// Returns the cumulative number of lookups and hits. Used to weigh the cache
+  /// against the query memory when trading memory between them.
+  virtual std::pair<uint64_t, uint64_t> lookupStats() const {
+    return {0, 0};
+  }
+
   virtual MemoryAllocator* allocator() const = 0;
 };
 
@@ -220,6 +250,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   /// the same as 'this'.
   virtual void registerCache(const std::shared_ptr<Cache>& cache) = 0;
 
+  /// Returns the registered 'Cache' or nullptr if there is none. The cache is
+  /// only responsible for freeing up memory space by shrinking itself when
+  /// there is not enough space upon allocating. The free of space is not
+  /// guaranteed.
+  virtual Cache* cache() const = 0;
+
   using ReservationCallback = std::function<void(uint64_t, bool)>;
 
   /// Returns the capacity of the allocator in bytes.
@@ -342,7 +378,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   virtual MachinePageCount numMapped() const = 0;
 
   virtual Stats stats() const {
-    return stats_;
+    auto stats = stats_;
+    stats.hugePageBytes = hugePageBytes_;
+    stats.prefaultedHugePageBytes = prefaultedHugePageBytes_;
+    return stats;
   }
 
   virtual std::string toString() const = 0;
@@ -453,10 +492,6 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
       MachinePageCount increment,
       ContiguousAllocation& allocation) = 0;
 
-  // 'Cache' getter. The cache is only responsible for freeing up memory space
-  // by shrinking itself when there is not enough space upon allocating. The
-  // free of space is not guaranteed.
-  virtual Cache* cache() const = 0;
 
   // Returns the size class size that corresponds to 'bytes'.
   static MachinePageCount roundUpToSizeClassSize(
@@ -484,6 +519,21 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Maps 'bytes' of anonymous memory for a contiguous allocation. If huge
+  // pages are used and 'bytes' is at least
+  // FLAGS_velox_memory_hugepage_align_bytes, the mapping starts at a huge page
+  // boundary so that all of it is in the huge page range. Returns MAP_FAILED
+  // on failure.
+  static void* mapContiguous(uint64_t bytes);
+
+  // Faults in the huge pages of 'data' in ['offset', 'offset' + 'bytes') if
+  // FLAGS_velox_memory_prefault_hugepages is set. Called after allocating or
+  // growing 'data' so that the first access does not take the page faults.
+  void prefaultHugePages(
+      const ContiguousAllocation& data,
+      uint64_t offset,
+      uint64_t bytes);
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -509,6 +559,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   bool isPersistentFailureInjection_{false};
 
   Stats stats_;
+
+  // See the Stats fields of the same name.
+  std::atomic<int64_t> hugePageBytes_{0};
+  std::atomic<int64_t> prefaultedHugePageBytes_{0};
 };
 
 std::ostream& operator<<(std::ostream& out, const MemoryAllocator::Kind& kind);
@@ -27,6 +27,7 @@
 
 namespace facebook::velox::memory {
 
+class MemoryAllocator;
 class MemoryPool;
 class ArbitrationOperation;
 
@@ -95,6 +96,11 @@ class MemoryArbitrator {
     /// Additional configs that are arbitrator implementation specific.
     std::unordered_map<std::string, std::string> extraConfigs{};
 
+    /// The memory allocator shared by the query memory pools and the cache
+    /// registered with it if any. Used by the arbitrator to trade memory
+    /// between the cache and the queries.
+    MemoryAllocator* allocator{nullptr};
+
     std::string toString() const {
       std::stringstream ss;
       for (const auto& extraConfig : extraConfigs) {
@@ -229,6 +229,10 @@ MemoryPool::MemoryPool(
       debugOptions_(options.debugOptions),
       poolPriority_(options.poolPriority),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      smallAllocationCacheBytes_(
+          options.trackUsage && options.threadSafe
+              ? options.smallAllocationCacheBytes
+              : 0),
       getPreferredSize_(
           options.getPreferredSize == nullptr
               ? [](size_t size) { return MemoryPool::getPreferredSize(size); }
@@ -236,6 +240,9 @@ MemoryPool::MemoryPool(
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
+  if (parent_ != nullptr) {
+    preferredNumaNode_ = parent_->preferredNumaNode();
+  }
   VELOX_CHECK_NOT_NULL(getPreferredSize_);
   MemoryAllocator::alignmentCheck(0, alignment_);
 }
@@ -449,10 +456,23 @@ MemoryPoolImpl::MemoryPoolImpl(
       // actually used memory arbitration policy.
       capacity_(parent_ != nullptr ? kMaxMemory : 0) {
   VELOX_CHECK(options.threadSafe || isLeaf());
+  if (isLeaf() && smallAllocationCacheBytes_ > 0) {
+    magazines_ = std::make_unique<folly::ThreadLocal<
+        SmallAllocationMagazines,
+        SmallAllocationMagazines>>(
+        [allocator = allocator_, cachedBytes = &cachedBytes_]() {
+          return new SmallAllocationMagazines(allocator, cachedBytes);
+        });
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
   DEBUG_LEAK_CHECK();
+  if (magazines_ != nullptr) {
+    // Returns the magazines of all threads, then the shared free lists.
+    magazines_.reset();
+    freeCachedAllocations();
+  }
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
@@ -525,10 +545,15 @@ void* MemoryPoolImpl::allocate(
 
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
-  void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
+  const auto allocationSize = allocationSizeClass(alignedSize);
+  reserve(allocationSize);
+  void* buffer = allocateCached(alignedSize);
+  if (buffer == nullptr) {
+    ScopedNumaNode numaNode(preferredNumaNode_);
+    buffer = allocator_->allocateBytes(allocationSize, alignment_);
+  }
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
+    release(allocationSize);
     handleAllocationFailure(fmt::format(
         "{} failed with {} from {} {}",
         __FUNCTION__,
@@ -544,10 +569,17 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
   const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
-  void* buffer = allocator_->allocateZeroFilled(alignedSize);
+  const auto allocationSize = allocationSizeClass(alignedSize);
+  reserve(allocationSize);
+  void* buffer = allocateCached(alignedSize);
+  if (buffer != nullptr) {
+    ::memset(buffer, 0, size);
+  } else {
+    ScopedNumaNode numaNode(preferredNumaNode_);
+    buffer = allocator_->allocateZeroFilled(allocationSize);
+  }
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
+    release(allocationSize);
     handleAllocationFailure(fmt::format(
         "{} failed with {} entries and {} each from {} {}",
         __FUNCTION__,
@@ -563,11 +595,15 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedNewSize = sizeAlign(newSize);
-  reserve(alignedNewSize);
-
-  void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+  const auto allocationSize = allocationSizeClass(alignedNewSize);
+  reserve(allocationSize);
+  void* newP = allocateCached(alignedNewSize);
+  if (newP == nullptr) {
+    ScopedNumaNode numaNode(preferredNumaNode_);
+    newP = allocator_->allocateBytes(allocationSize, alignment_);
+  }
   if (FOLLY_UNLIKELY(newP == nullptr)) {
-    release(alignedNewSize);
+    release(allocationSize);
     handleAllocationFailure(fmt::format(
         "{} failed with new {} and old {} from {} {}",
         __FUNCTION__,
@@ -587,9 +623,122 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const auto alignedSize = sizeAlign(size);
+  const auto allocationSize = allocationSizeClass(alignedSize);
   DEBUG_RECORD_FREE(p, size);
-  allocator_->freeBytes(p, alignedSize);
-  release(alignedSize);
+  if (!freeCached(p, alignedSize)) {
+    allocator_->freeBytes(p, allocationSize);
+  }
+  release(allocationSize);
+}
+
+MemoryPoolImpl::SmallAllocationMagazines::~SmallAllocationMagazines() {
+  int64_t freedBytes{0};
+  for (auto i = 0; i < kNumCachedAllocationSizes; ++i) {
+    const auto sizeClass = kMinCachedAllocationSize << i;
+    for (auto* buffer : buffers[i]) {
+      allocator->freeBytes(buffer, sizeClass);
+    }
+    freedBytes += buffers[i].size() * sizeClass;
+  }
+  *cachedBytes -= freedBytes;
+}
+
+void* MemoryPoolImpl::allocateCached(int64_t alignedSize) {
+  const auto sizeClass = cacheSizeClass(alignedSize);
+  if (sizeClass == 0) {
+    return nullptr;
+  }
+  auto& magazines = **magazines_;
+  const auto index = cacheSizeIndex(sizeClass);
+  auto& buffers = magazines.buffers[index];
+  if (buffers.empty()) {
+    // Refills the magazine with a batch from the shared free list.
+    const auto batchSize = magazineBatchSize(sizeClass);
+    std::lock_guard<std::mutex> l(cacheMutex_);
+    auto& shared = cachedAllocations_[index];
+    const auto numBuffers = std::min<size_t>(batchSize, shared.size());
+    if (numBuffers == 0) {
+      return nullptr;
+    }
+    buffers.insert(buffers.end(), shared.end() - numBuffers, shared.end());
+    shared.resize(shared.size() - numBuffers);
+  }
+  void* buffer = buffers.back();
+  buffers.pop_back();
+  cachedBytes_ -= sizeClass;
+  return buffer;
+}
+
+bool MemoryPoolImpl::freeCached(void* p, int64_t alignedSize) {
+  const auto sizeClass = cacheSizeClass(alignedSize);
+  if (sizeClass == 0) {
+    return false;
+  }
+  // The buffers in the shared free list and in the magazines of all threads
+  // are bounded by 'smallAllocationCacheBytes_'. The rest goes back to the
+  // allocator.
+  if (cachedBytes_.fetch_add(sizeClass) + sizeClass >
+      smallAllocationCacheBytes_) {
+    cachedBytes_ -= sizeClass;
+    return false;
+  }
+  auto& magazines = **magazines_;
+  const auto index = cacheSizeIndex(sizeClass);
+  auto& buffers = magazines.buffers[index];
+  const auto batchSize = magazineBatchSize(sizeClass);
+  if (buffers.size() >= 2 * batchSize) {
+    // Drains the least recently freed batch to the shared free list.
+    std::lock_guard<std::mutex> l(cacheMutex_);
+    cachedAllocations_[index].insert(
+        cachedAllocations_[index].end(),
+        buffers.begin(),
+        buffers.begin() + batchSize);
+    buffers.erase(buffers.begin(), buffers.begin() + batchSize);
+  }
+  buffers.push_back(p);
+  return true;
+}
+
+int64_t MemoryPoolImpl::cachedBytes() const {
+  return cachedBytes_;
+}
+
+uint64_t MemoryPoolImpl::freeCachedAllocations() {
+  if (!isLeaf()) {
+    uint64_t freedBytes{0};
+    visitChildren([&](MemoryPool* pool) {
+      freedBytes += toImpl(pool)->freeCachedAllocations();
+      return true;
+    });
+    return freedBytes;
+  }
+  if (smallAllocationCacheBytes_ == 0) {
+    return 0;
+  }
+  std::array<std::vector<void*>, kNumCachedAllocationSizes> buffers;
+  if (magazines_ != nullptr) {
+    buffers.swap((*magazines_)->buffers);
+  }
+  {
+    std::lock_guard<std::mutex> l(cacheMutex_);
+    for (auto i = 0; i < kNumCachedAllocationSizes; ++i) {
+      buffers[i].insert(
+          buffers[i].end(),
+          cachedAllocations_[i].begin(),
+          cachedAllocations_[i].end());
+      cachedAllocations_[i].clear();
+    }
+  }
+  uint64_t freedBytes{0};
+  for (auto i = 0; i < kNumCachedAllocationSizes; ++i) {
+    const auto sizeClass = kMinCachedAllocationSize << i;
+    for (auto* buffer : buffers[i]) {
+      allocator_->freeBytes(buffer, sizeClass);
+    }
+    freedBytes += buffers[i].size() * sizeClass;
+  }
+  cachedBytes_ -= freedBytes;
+  return freedBytes;
 }
 
 void MemoryPoolImpl::allocateNonContiguous(
@@ -605,6 +754,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  ScopedNumaNode numaNode(preferredNumaNode_);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -656,6 +806,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  ScopedNumaNode numaNode(preferredNumaNode_);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -773,7 +924,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .threadSafe = threadSafe,
           .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
           .getPreferredSize = getPreferredSize,
-          .debugOptions = debugOptions_});
+          .debugOptions = debugOptions_,
+          .smallAllocationCacheBytes = smallAllocationCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -929,6 +1081,7 @@ void MemoryPoolImpl::incrementReservationLocked(uint64_t bytes) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  freeCachedAllocations();
   release(0, true);
 }
 
@@ -1098,6 +1251,8 @@ uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   if (parent_ != nullptr) {
     return toImpl(parent_)->shrink(targetBytes);
   }
+  // Returns the cached small buffers to the allocator first.
+  freeCachedAllocations();
   std::lock_guard<std::mutex> l(mutex_);
   // We don't expect to shrink a memory pool without capacity limit.
   VELOX_CHECK_NE(capacity_, kMaxMemory);
@@ -21,12 +21,14 @@
 #include <optional>
 
 #include <fmt/format.h>
+#include <folly/ThreadLocal.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/Numa.h"
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
@@ -157,6 +159,22 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// determining which pools to abort when the system is out of memory.
     /// higher poolPriority value respresents higher priority and vice-versa.
     uint32_t poolPriority{0};
+
+    /// If not zero, a leaf memory pool keeps up to this many bytes of freed
+    /// small buffers and reuses them for later allocations of the same size
+    /// class instead of going to the memory allocator. Each thread keeps a
+    /// small magazine of buffers per size class that it fills from and drains
+    /// to a shared free list a batch at a time. The bound covers the shared
+    /// free list and the magazines of all threads. A small allocation is
+    /// rounded up to its power of two size class, which is what the pool
+    /// reserves and counts as used. The cached buffers are not counted in the
+    /// pool's usage. The shared free list and the calling thread's magazine
+    /// are returned to the allocator on release() and when the memory
+    /// arbitrator shrinks the pool. The magazine of another thread is returned
+    /// when the thread exits or the pool is destroyed. Only applies to
+    /// thread-safe pools with usage tracking and is inherited by the child
+    /// pools.
+    int64_t smallAllocationCacheBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -307,6 +325,18 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     return poolPriority_;
   }
 
+  /// Sets the NUMA node the memory of this pool should come from. Child pools
+  /// created after this call inherit the node. kNoNumaNode clears the
+  /// preference. Only has an effect with a NUMA aware allocator.
+  void setPreferredNumaNode(int32_t node) {
+    preferredNumaNode_ = node;
+  }
+
+  /// Returns the preferred NUMA node of this pool or kNoNumaNode if none.
+  int32_t preferredNumaNode() const {
+    return preferredNumaNode_;
+  }
+
   /// Resource governing methods used to track and limit the memory usage
   /// through this memory pool object.
 
@@ -558,6 +588,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const std::optional<DebugOptions> debugOptions_;
   const uint32_t poolPriority_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t smallAllocationCacheBytes_;
   std::function<size_t(size_t)> getPreferredSize_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
@@ -569,6 +600,10 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Saves the aborted error exception which is only set if 'aborted_' is true.
   std::exception_ptr abortError_{nullptr};
 
+  /// NUMA node for the allocations from this pool. Inherited from the parent
+  /// at creation.
+  tsan_atomic<int32_t> preferredNumaNode_{kNoNumaNode};
+
   mutable folly::SharedMutex poolMutex_;
   std::unordered_map<std::string, std::weak_ptr<MemoryPool>> children_;
 
@@ -678,6 +713,17 @@ class MemoryPoolImpl : public MemoryPool {
 
   void setDestructionCallback(const DestructionCallback& callback);
 
+  /// Returns the freed small buffers kept in the shared free lists and the
+  /// calling thread's magazines of this pool and its descendants to the
+  /// allocator. Returns the number of bytes freed.
+  uint64_t freeCachedAllocations();
+
+  /// Returns the bytes of freed small buffers kept for reuse by this leaf
+  /// pool, including the magazines of all threads. At most
+  /// Options::smallAllocationCacheBytes. See
+  /// Options::smallAllocationCacheBytes.
+  int64_t cachedBytes() const;
+
   std::string toString(bool detail = false) const override {
     std::string result;
     {
@@ -783,6 +829,44 @@ class MemoryPoolImpl : public MemoryPool {
         : std::max<int64_t>(0, reservationBytes_ - usedReservationBytes_);
   }
 
+  // Returns the size class of the small allocation cache for an allocation of
+  // 'alignedSize' bytes, or 0 if the allocation is not cached.
+  FOLLY_ALWAYS_INLINE int64_t cacheSizeClass(int64_t alignedSize) const {
+    if (FOLLY_LIKELY(smallAllocationCacheBytes_ == 0) ||
+        alignedSize > kMaxCachedAllocationSize) {
+      return 0;
+    }
+    return std::max<int64_t>(
+        kMinCachedAllocationSize, bits::nextPowerOfTwo(alignedSize));
+  }
+
+  FOLLY_ALWAYS_INLINE static int32_t cacheSizeIndex(int64_t sizeClass) {
+    return __builtin_ctzll(sizeClass / kMinCachedAllocationSize);
+  }
+
+  // Returns the number of bytes to get from the allocator for an allocation
+  // of 'alignedSize' bytes.
+  FOLLY_ALWAYS_INLINE int64_t allocationSizeClass(int64_t alignedSize) const {
+    const auto sizeClass = cacheSizeClass(alignedSize);
+    return sizeClass == 0 ? alignedSize : sizeClass;
+  }
+
+  // Returns the number of buffers of 'sizeClass' bytes moved between a
+  // thread's magazine and the shared free list at a time.
+  FOLLY_ALWAYS_INLINE static size_t magazineBatchSize(int64_t sizeClass) {
+    return std::max<int64_t>(1, kMagazineBatchBytes / sizeClass);
+  }
+
+  // Returns a cached buffer for an allocation of 'alignedSize' bytes from the
+  // calling thread's magazine, or nullptr if the allocation is not cached or
+  // there is no cached buffer. Does not change the pool's usage.
+  void* allocateCached(int64_t alignedSize);
+
+  // Keeps the buffer 'p' of an allocation of 'alignedSize' bytes in the
+  // calling thread's magazine for reuse. Returns false if the allocation is
+  // not cached or the cache is full. Does not change the pool's usage.
+  bool freeCached(void* p, int64_t alignedSize);
+
   FOLLY_ALWAYS_INLINE int64_t sizeAlign(int64_t size) const {
     const auto remainder = size & (alignment_ - 1);
     return (remainder == 0) ? size : (size + alignment_ - remainder);
@@ -1044,6 +1128,56 @@ class MemoryPoolImpl : public MemoryPool {
   // release().
   tsan_atomic<int64_t> minReservationBytes_{0};
 
+  // Smallest and largest size class of the small allocation cache.
+  static constexpr int64_t kMinCachedAllocationSize = 64;
+  static constexpr int64_t kMaxCachedAllocationSize = 8 << 10;
+  static constexpr int32_t kNumCachedAllocationSizes = 8;
+  static_assert(
+      kMinCachedAllocationSize << (kNumCachedAllocationSizes - 1) ==
+      kMaxCachedAllocationSize);
+
+  // Bytes of the buffers of one size class moved between a magazine and the
+  // shared free list at a time. A magazine holds up to two batches.
+  static constexpr int64_t kMagazineBatchBytes = 4 << 10;
+
+  // Per thread free lists of the small allocation cache. The owning thread
+  // uses them without locking. Returns its buffers to 'allocator' when the
+  // thread exits or the pool is destroyed.
+  struct SmallAllocationMagazines {
+    SmallAllocationMagazines(
+        MemoryAllocator* _allocator,
+        std::atomic<int64_t>* _cachedBytes)
+        : allocator(_allocator), cachedBytes(_cachedBytes) {}
+
+    ~SmallAllocationMagazines();
+
+    MemoryAllocator* const allocator;
+
+    // The pool's 'cachedBytes_', which counts the bytes in 'buffers'.
+    std::atomic<int64_t>* const cachedBytes;
+
+    // Freed buffers per size class, from 'kMinCachedAllocationSize' up in
+    // powers of two.
+    std::array<std::vector<void*>, kNumCachedAllocationSizes> buffers;
+  };
+
+  // The magazines of the threads that use this pool. Set for a leaf pool with
+  // 'smallAllocationCacheBytes_'.
+  std::unique_ptr<
+      folly::ThreadLocal<SmallAllocationMagazines, SmallAllocationMagazines>>
+      magazines_;
+
+  // Protects 'cachedAllocations_'.
+  mutable std::mutex cacheMutex_;
+
+  // Freed buffers shared by the threads per size class, like
+  // SmallAllocationMagazines::buffers.
+  std::array<std::vector<void*>, kNumCachedAllocationSizes> cachedAllocations_;
+
+  // The bytes in 'cachedAllocations_' and the magazines of all threads. At
+  // most 'smallAllocationCacheBytes_'.
+  std::atomic<int64_t> cachedBytes_{0};
+
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
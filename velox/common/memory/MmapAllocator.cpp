@@ -18,6 +18,8 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/StatsReporter.h"
@@ -35,10 +37,18 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numaNodes_(std::max(1, options.numaNodes)) {
+  for (auto node = 0; node < numaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numaNodes_ > 1 ? node : kNoNumaNode));
+    }
+  }
+  for (auto i = 0; i < sizeClasses_.size(); ++i) {
+    sizeClassAddresses_.emplace_back(sizeClasses_[i]->address(), i);
   }
+  std::sort(sizeClassAddresses_.begin(), sizeClassAddresses_.end());
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
@@ -91,6 +101,8 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
 
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
+  const auto node = allocationNode();
+  const auto firstSizeClass = node * sizeClassSizes_.size();
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
@@ -98,8 +110,9 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success =
+              sizeClasses_[firstSizeClass + sizeMix.sizeIndices[i]]->allocate(
+                  sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -122,6 +135,7 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
       return false;
     }
   }
+  recordNumaAllocation(node, AllocationTraits::pageBytes(sizeMix.totalPages));
   if (newMapsNeeded == 0) {
     return true;
   }
@@ -183,8 +197,19 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
     return numFreed;
   }
 
-  for (auto i = 0; i < sizeClasses_.size(); ++i) {
-    auto& sizeClass = sizeClasses_[i];
+  // The size classes with runs in 'allocation'. The runs of a size class are
+  // usually adjacent.
+  std::vector<int32_t> classIndices;
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    const auto index = sizeClassIndex(allocation.runAt(i).data());
+    if (index >= 0 &&
+        std::find(classIndices.begin(), classIndices.end(), index) ==
+            classIndices.end()) {
+      classIndices.push_back(index);
+    }
+  }
+  for (const auto index : classIndices) {
+    auto& sizeClass = sizeClasses_[index];
     int32_t pages = 0;
     uint64_t clocks = 0;
     {
@@ -196,7 +221,7 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
       const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClass->unitSize()));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -330,13 +355,7 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mapContiguous(AllocationTraits::pageBytes(maxPages));
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -353,11 +372,18 @@ bool MmapAllocator::allocateContiguousImpl(
     rollbackAllocation(numToMap);
     return false;
   }
+  if (numaNodes_ > 1) {
+    // Before the pages are touched, so that they come from the node.
+    const auto node = allocationNode();
+    numaBindPreferred(data, AllocationTraits::pageBytes(maxPages), node);
+    recordNumaAllocation(node, AllocationTraits::pageBytes(numPages));
+  }
   allocation.set(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
   useHugePages(allocation, true);
+  prefaultHugePages(allocation, 0, allocation.size());
   return true;
 }
 
@@ -420,10 +446,12 @@ bool MmapAllocator::growContiguousWithoutRetry(
   }
 
   numExternalMapped_ += increment;
+  const auto oldSize = allocation.size();
   allocation.set(
       allocation.data(),
-      allocation.size() + AllocationTraits::pageBytes(increment),
+      oldSize + AllocationTraits::pageBytes(increment),
       allocation.maxSize());
+  prefaultHugePages(allocation, oldSize, allocation.size() - oldSize);
   return true;
 }
 
@@ -509,9 +537,13 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
+      numaNode_(numaNode),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
@@ -538,6 +570,11 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode_ != kNoNumaNode) {
+    // The range is not backed yet. Pages get memory from 'numaNode_' when
+    // first touched.
+    numaBindPreferred(address_, byteSize_, numaNode_);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -951,6 +988,38 @@ bool MmapAllocator::checkConsistency() const {
   return numErrors == 0;
 }
 
+int32_t MmapAllocator::sizeClassIndex(const uint8_t* address) const {
+  auto it = std::upper_bound(
+      sizeClassAddresses_.begin(),
+      sizeClassAddresses_.end(),
+      address,
+      [](const uint8_t* value, const auto& entry) {
+        return value < entry.first;
+      });
+  if (it == sizeClassAddresses_.begin()) {
+    return -1;
+  }
+  return (--it)->second;
+}
+
+int32_t MmapAllocator::allocationNode() const {
+  if (numaNodes_ == 1) {
+    return 0;
+  }
+  return numaAllocationNode() % numaNodes_;
+}
+
+void MmapAllocator::recordNumaAllocation(int32_t node, uint64_t bytes) {
+  if (numaNodes_ == 1) {
+    return;
+  }
+  if (node == numaCurrentNode()) {
+    numaLocalBytes_ += bytes;
+  } else {
+    numaRemoteBytes_ += bytes;
+  }
+}
+
 bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
@@ -30,6 +30,7 @@
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/Numa.h"
 
 namespace facebook::velox::memory {
 
@@ -80,6 +81,14 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If greater than 1, the size classes are replicated per NUMA node and
+    /// each replica prefers the memory of its node. A non-contiguous
+    /// allocation comes from the node preferred by the calling thread (see
+    /// ScopedNumaNode) or else from the node of the CPU it runs on. Use
+    /// numaNumNodes() for the number of nodes of the host. 0 or 1 treats the
+    /// host as a single node.
+    int32_t numaNodes = 0;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -156,9 +165,17 @@ class MmapAllocator : public MemoryAllocator {
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
+    stats.numaLocalBytes = numaLocalBytes_;
+    stats.numaRemoteBytes = numaRemoteBytes_;
     return stats;
   }
 
+  /// Returns the number of NUMA nodes with their own size classes. 1 if not
+  /// NUMA aware.
+  int32_t numaNodes() const {
+    return numaNodes_;
+  }
+
   std::string toString() const override;
 
  private:
@@ -168,7 +185,10 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = kNoNumaNode);
 
     ~SizeClass();
 
@@ -176,6 +196,15 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    int32_t numaNode() const {
+      return numaNode_;
+    }
+
+    // Returns the start of the address range of 'this'.
+    uint8_t* address() const {
+      return address_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -273,6 +302,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size of one size class page in machine pages.
     const MachinePageCount unitSize_;
 
+    // NUMA node preferred for the memory of 'this' or kNoNumaNode.
+    const int32_t numaNode_;
+
     // Size in bytes of the address range.
     const size_t byteSize_;
 
@@ -372,6 +404,18 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node for an allocation by the calling thread. 0 if not
+  // NUMA aware.
+  int32_t allocationNode() const;
+
+  // Counts 'bytes' allocated from NUMA 'node' as local or remote to the CPU of
+  // the calling thread.
+  void recordNumaAllocation(int32_t node, uint64_t bytes);
+
+  // Returns the index in 'sizeClasses_' of the size class whose address range
+  // starts at or before 'address'. -1 if 'address' is below all size classes.
+  int32_t sizeClassIndex(const uint8_t* address) const;
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -408,12 +452,26 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // Number of NUMA nodes with their own size classes. 1 if not NUMA aware.
+  const int32_t numaNodes_;
+
+  // The size classes of node 'n' are at ['n' * sizeClassSizes_.size(), ('n' +
+  // 1) * sizeClassSizes_.size()).
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Start addresses of the ranges of 'sizeClasses_' in ascending order with
+  // the index of the size class. Used for finding the size classes of the
+  // runs to free without checking every size class of every node.
+  std::vector<std::pair<const uint8_t*, int32_t>> sizeClassAddresses_;
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
+  // Bytes allocated from the NUMA node of the allocating thread's CPU and from
+  // other nodes. Only counted if NUMA aware.
+  std::atomic<uint64_t> numaLocalBytes_ = 0;
+  std::atomic<uint64_t> numaRemoteBytes_ = 0;
   folly::ThreadCachedInt<int64_t, MmapAllocator> numMallocBytes_;
 
   // Allocations that are larger than largest size classes will be delegated to
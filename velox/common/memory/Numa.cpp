@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/Numa.h"
+
+#include <fmt/format.h>
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::memory {
+namespace {
+// Memory policy of mbind(2) from numaif.h. Defined here to not depend on
+// libnuma.
+constexpr int32_t kMpolPreferred = 1;
+
+thread_local int32_t preferredNode{kNoNumaNode};
+
+// Parses a sysfs list like "0-3,8,10-11".
+std::vector<int32_t> parseList(const std::string& text) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(text), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    std::vector<folly::StringPiece> bounds;
+    folly::split('-', range, bounds);
+    const auto first = folly::to<int32_t>(bounds[0]);
+    const auto last = bounds.size() > 1 ? folly::to<int32_t>(bounds[1]) : first;
+    for (auto i = first; i <= last; ++i) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+std::vector<int32_t> readList(const std::string& path) {
+  std::string text;
+  if (!folly::readFile(path.c_str(), text)) {
+    return {};
+  }
+  try {
+    return parseList(text);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to parse " << path << ": " << e.what();
+    return {};
+  }
+}
+} // namespace
+
+int32_t numaNumNodes() {
+  static const int32_t numNodes = []() {
+    const auto nodes = readList("/sys/devices/system/node/online");
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return numNodes;
+}
+
+int32_t numaCurrentNode() {
+#ifdef __linux__
+  uint32_t cpu;
+  uint32_t node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+  return readList(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+}
+
+bool numaBindPreferred(void* address, uint64_t bytes, int32_t node) {
+#ifdef __linux__
+  if (node < 0 || node >= 64) {
+    return false;
+  }
+  const uint64_t nodeMask = 1UL << node;
+  if (::syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          kMpolPreferred,
+          &nodeMask,
+          // The kernel uses one bit less than 'maxnode'.
+          sizeof(nodeMask) * 8 + 1,
+          0) == 0) {
+    return true;
+  }
+  LOG_EVERY_N(WARNING, 1000) << "mbind to NUMA node " << node
+                             << " failed: " << folly::errnoStr(errno);
+#endif
+  return false;
+}
+
+int32_t numaPreferredNode() {
+  return preferredNode;
+}
+
+int32_t numaAllocationNode() {
+  return preferredNode == kNoNumaNode ? numaCurrentNode() : preferredNode;
+}
+
+ScopedNumaNode::ScopedNumaNode(int32_t node) : savedNode_(preferredNode) {
+  if (node != kNoNumaNode) {
+    preferredNode = node;
+  }
+}
+
+ScopedNumaNode::~ScopedNumaNode() {
+  preferredNode = savedNode_;
+}
+
+} // namespace facebook::velox::memory
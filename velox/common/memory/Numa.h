@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+/// Denotes no NUMA node preference.
+constexpr int32_t kNoNumaNode = -1;
+
+/// Returns the number of NUMA nodes of the host. Returns 1 if the host has no
+/// NUMA information.
+int32_t numaNumNodes();
+
+/// Returns the NUMA node of the CPU the calling thread runs on. Returns 0 if
+/// not known.
+int32_t numaCurrentNode();
+
+/// Returns the CPUs of NUMA 'node'. Returns an empty vector if not known.
+std::vector<int32_t> numaNodeCpus(int32_t node);
+
+/// Sets the memory policy of the pages in ['address', 'address' + 'bytes') to
+/// prefer NUMA 'node'. Pages that are already backed by memory are not moved.
+/// The kernel falls back to other nodes if 'node' has no free memory. Returns
+/// false if the policy could not be set.
+bool numaBindPreferred(void* address, uint64_t bytes, int32_t node);
+
+/// Returns the NUMA node preferred for allocations by the calling thread or
+/// kNoNumaNode if none is set. See ScopedNumaNode.
+int32_t numaPreferredNode();
+
+/// Returns the node an allocation by the calling thread should come from: the
+/// preferred node if set, otherwise the node of the current CPU.
+int32_t numaAllocationNode();
+
+/// Sets the preferred NUMA node for allocations of the calling thread for the
+/// lifetime of 'this'. kNoNumaNode leaves the current preference in place.
+class ScopedNumaNode {
+ public:
+  explicit ScopedNumaNode(int32_t node);
+
+  ~ScopedNumaNode();
+
+ private:
+  const int32_t savedNode_;
+};
+
+} // namespace facebook::velox::memory
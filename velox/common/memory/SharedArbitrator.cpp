@@ -236,6 +236,56 @@ double SharedArbitrator::ExtraConfig::globalArbitrationAbortTimeRatio(
       kDefaultGlobalArbitrationAbortTimeRatio);
 }
 
+uint32_t SharedArbitrator::ExtraConfig::proactiveArbitrationFreeCapacityPct(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<uint32_t>(
+      configs,
+      kProactiveArbitrationFreeCapacityPct,
+      kDefaultProactiveArbitrationFreeCapacityPct);
+}
+
+uint64_t SharedArbitrator::ExtraConfig::proactiveArbitrationCheckIntervalNs(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             config::toDuration(getConfig<std::string>(
+                 configs,
+                 kProactiveArbitrationCheckInterval,
+                 std::string(kDefaultProactiveArbitrationCheckInterval))))
+      .count();
+}
+
+uint32_t SharedArbitrator::ExtraConfig::memoryPoolReclaimShieldPriority(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<uint32_t>(
+      configs,
+      kMemoryPoolReclaimShieldPriority,
+      kDefaultMemoryPoolReclaimShieldPriority);
+}
+
+bool SharedArbitrator::ExtraConfig::cacheArbitrationEnabled(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return getConfig<bool>(
+      configs, kCacheArbitrationEnabled, kDefaultCacheArbitrationEnabled);
+}
+
+uint64_t SharedArbitrator::ExtraConfig::cacheMinCapacity(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return config::toCapacity(
+      getConfig<std::string>(
+          configs, kCacheMinCapacity, std::string(kDefaultCacheMinCapacity)),
+      config::CapacityUnit::BYTE);
+}
+
+uint64_t SharedArbitrator::ExtraConfig::cacheMaxShrinkBytesPerRun(
+    const std::unordered_map<std::string, std::string>& configs) {
+  return config::toCapacity(
+      getConfig<std::string>(
+          configs,
+          kCacheMaxShrinkBytesPerRun,
+          std::string(kDefaultCacheMaxShrinkBytesPerRun)),
+      config::CapacityUnit::BYTE);
+}
+
 SharedArbitrator::SharedArbitrator(const Config& config)
     : MemoryArbitrator(config),
       capacity_(config.capacity),
@@ -265,6 +315,20 @@ SharedArbitrator::SharedArbitrator(const Config& config)
           ExtraConfig::globalArbitrationAbortTimeRatio(config.extraConfigs)),
       globalArbitrationWithoutSpill_(
           ExtraConfig::globalArbitrationWithoutSpill(config.extraConfigs)),
+      proactiveArbitrationFreeCapacityPct_(
+          ExtraConfig::proactiveArbitrationFreeCapacityPct(
+              config.extraConfigs)),
+      proactiveArbitrationCheckIntervalNs_(
+          ExtraConfig::proactiveArbitrationCheckIntervalNs(
+              config.extraConfigs)),
+      memoryPoolReclaimShieldPriority_(
+          ExtraConfig::memoryPoolReclaimShieldPriority(config.extraConfigs)),
+      cacheArbitrationEnabled_(
+          ExtraConfig::cacheArbitrationEnabled(config.extraConfigs)),
+      cacheMinCapacity_(ExtraConfig::cacheMinCapacity(config.extraConfigs)),
+      cacheMaxShrinkBytesPerRun_(
+          ExtraConfig::cacheMaxShrinkBytesPerRun(config.extraConfigs)),
+      allocator_(config.allocator),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -276,6 +340,28 @@ SharedArbitrator::SharedArbitrator(const Config& config)
       globalArbitrationMemoryReclaimPct_,
       100,
       "Invalid globalArbitrationMemoryReclaimPct");
+  VELOX_CHECK_LE(
+      proactiveArbitrationFreeCapacityPct_,
+      100,
+      "Invalid proactiveArbitrationFreeCapacityPct");
+  VELOX_CHECK(
+      proactiveArbitrationFreeCapacityPct_ == 0 || globalArbitrationEnabled_,
+      "Proactive arbitration requires global arbitration");
+  VELOX_CHECK(
+      proactiveArbitrationFreeCapacityPct_ == 0 ||
+          proactiveArbitrationCheckIntervalNs_ > 0,
+      "proactiveArbitrationCheckInterval can't be zero");
+  VELOX_CHECK(
+      !cacheArbitrationEnabled_ || globalArbitrationEnabled_,
+      "Cache arbitration requires global arbitration");
+  VELOX_CHECK(
+      !cacheArbitrationEnabled_ || allocator_ != nullptr,
+      "Cache arbitration requires the memory allocator");
+  VELOX_CHECK(
+      !cacheArbitrationEnabled_ || proactiveArbitrationCheckIntervalNs_ > 0,
+      "proactiveArbitrationCheckInterval can't be zero");
+  VELOX_CHECK_GT(
+      cacheMaxShrinkBytesPerRun_, 0, "cacheMaxShrinkBytesPerRun can't be zero");
 
   VELOX_CHECK_GT(
       memoryReclaimThreadsHwMultiplier_,
@@ -305,7 +391,12 @@ SharedArbitrator::SharedArbitrator(const Config& config)
                         << ", global arbitration abort time ratio "
                         << globalArbitrationAbortTimeRatio_
                         << ", global arbitration skip spill "
-                        << globalArbitrationWithoutSpill_;
+                        << globalArbitrationWithoutSpill_
+                        << ", proactive arbitration free capacity percentage "
+                        << proactiveArbitrationFreeCapacityPct_
+                        << ", reclaim shield priority "
+                        << memoryPoolReclaimShieldPriority_
+                        << ", cache arbitration " << cacheArbitrationEnabled_;
   }
   VELOX_MEM_LOG(INFO) << "Memory pool participant config: "
                       << participantConfig_.toString();
@@ -915,18 +1006,37 @@ void SharedArbitrator::updateGlobalArbitrationStats(
 void SharedArbitrator::globalArbitrationMain() {
   VELOX_MEM_LOG(INFO) << "Global arbitration controller started";
   while (true) {
+    bool hasWaiters;
     {
       std::unique_lock<std::mutex> l(stateMutex_);
-      globalArbitrationThreadCv_.wait(l, [&] {
+      const auto wakeup = [&] {
         return hasShutdownLocked() || !globalArbitrationWaiters_.empty();
-      });
+      };
+      if (proactiveArbitrationFreeCapacityPct_ == 0 &&
+          !cacheArbitrationEnabled_) {
+        globalArbitrationThreadCv_.wait(l, wakeup);
+      } else {
+        // Wakes up periodically to check the free capacity and cache size.
+        globalArbitrationThreadCv_.wait_for(
+            l,
+            std::chrono::nanoseconds(proactiveArbitrationCheckIntervalNs_),
+            wakeup);
+      }
       if (hasShutdownLocked()) {
         VELOX_CHECK(globalArbitrationWaiters_.empty());
         break;
       }
+      hasWaiters = !globalArbitrationWaiters_.empty();
     }
     GlobalArbitrationSection section{this};
-    runGlobalArbitration();
+    if (hasWaiters) {
+      runGlobalArbitration();
+    } else {
+      runProactiveArbitration();
+    }
+    if (cacheArbitrationEnabled_) {
+      runCacheArbitration();
+    }
   }
   VELOX_MEM_LOG(INFO) << "Global arbitration controller stopped";
 }
@@ -1007,6 +1117,114 @@ uint64_t SharedArbitrator::getGlobalArbitrationTarget() {
       capacity_ * globalArbitrationMemoryReclaimPct_ / 100, targetBytes);
 }
 
+uint64_t SharedArbitrator::getProactiveArbitrationTarget() const {
+  if (proactiveArbitrationFreeCapacityPct_ == 0) {
+    return 0;
+  }
+  const uint64_t watermark =
+      capacity_ * proactiveArbitrationFreeCapacityPct_ / 100;
+  std::lock_guard<std::mutex> l(stateMutex_);
+  const uint64_t freeCapacity =
+      freeNonReservedCapacity_ + freeReservedCapacity_;
+  return freeCapacity >= watermark ? 0 : watermark - freeCapacity;
+}
+
+uint64_t SharedArbitrator::runProactiveArbitration() {
+  const uint64_t targetBytes = getProactiveArbitrationTarget();
+  if (targetBytes == 0) {
+    return 0;
+  }
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::runProactiveArbitration",
+      this);
+  uint64_t arbitrationTimeNs{0};
+  uint64_t reclaimedBytes{0};
+  {
+    NanosecondTimer timer(&arbitrationTimeNs);
+    // The unused capacity is the cheapest to reclaim.
+    reclaimedBytes = reclaimUnusedCapacity();
+    if (reclaimedBytes < targetBytes) {
+      std::unordered_set<uint64_t> reclaimedParticipants;
+      std::unordered_set<uint64_t> failedParticipants;
+      bool allParticipantsReclaimed;
+      reclaimedBytes += reclaimUsedMemoryBySpill(
+          targetBytes - reclaimedBytes,
+          reclaimedParticipants,
+          failedParticipants,
+          allParticipantsReclaimed,
+          /*proactive=*/true);
+    }
+  }
+  ++proactiveArbitrationRuns_;
+  proactiveArbitrationBytes_ += reclaimedBytes;
+  RECORD_METRIC_VALUE(kMetricArbitratorProactiveArbitrationCount);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricArbitratorProactiveArbitrationBytes, reclaimedBytes);
+  // The controller runs this on every wake-up, so rate-limit the log.
+  VELOX_MEM_LOG_EVERY_MS(INFO, 1'000)
+      << "Proactive arbitration reclaimed " << succinctBytes(reclaimedBytes)
+      << " with target " << succinctBytes(targetBytes) << ", spent "
+      << succinctNanos(arbitrationTimeNs);
+  return reclaimedBytes;
+}
+
+uint64_t SharedArbitrator::getCacheTarget(const Cache& cache) {
+  const auto [numLookups, numHits] = cache.lookupStats();
+  const uint64_t newLookups = numLookups - prevCacheLookups_;
+  // Keeps the cache if it is not accessed, e.g. when the system is idle.
+  const double hitRatio = newLookups == 0
+      ? 1.0
+      : static_cast<double>(numHits - prevCacheHits_) / newLookups;
+  prevCacheLookups_ = numLookups;
+  prevCacheHits_ = numHits;
+
+  uint64_t freeCapacity;
+  {
+    std::lock_guard<std::mutex> l(stateMutex_);
+    freeCapacity = freeNonReservedCapacity_ + freeReservedCapacity_;
+  }
+  // The capacity granted to the query memory pools must be backed by the
+  // allocator. The queries can grow into the free capacity, which is left to
+  // the cache only as long as the cache is useful.
+  const uint64_t queryDemand = (capacity_ - freeCapacity) +
+      static_cast<uint64_t>(freeCapacity * (1.0 - hitRatio));
+  const uint64_t allocatorCapacity = allocator_->capacity();
+  const uint64_t targetBytes =
+      allocatorCapacity > queryDemand ? allocatorCapacity - queryDemand : 0;
+  return std::max(targetBytes, cacheMinCapacity_);
+}
+
+uint64_t SharedArbitrator::runCacheArbitration() {
+  auto* cache = allocator_->cache();
+  if (cache == nullptr) {
+    return 0;
+  }
+  const uint64_t targetBytes = getCacheTarget(*cache);
+  RECORD_METRIC_VALUE(kMetricArbitratorCacheTargetBytes, targetBytes);
+  const uint64_t cachedBytes = cache->cachedBytes();
+  if (cachedBytes <= targetBytes) {
+    return 0;
+  }
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::runCacheArbitration", this);
+  const uint64_t freedBytes = cache->shrinkInBackground(
+      std::min(cachedBytes - targetBytes, cacheMaxShrinkBytesPerRun_));
+  cacheArbitrationBytes_ += freedBytes;
+  RECORD_METRIC_VALUE(kMetricArbitratorCacheShrinkBytes, freedBytes);
+  // The controller runs this on every wake-up, so rate-limit the log.
+  VELOX_MEM_LOG_EVERY_MS(INFO, 1'000)
+      << "Cache arbitration freed " << succinctBytes(freedBytes)
+      << " from cache of " << succinctBytes(cachedBytes) << " with target "
+      << succinctBytes(targetBytes);
+  return freedBytes;
+}
+
+bool SharedArbitrator::isShielded(const ArbitrationCandidate& candidate) const {
+  return memoryPoolReclaimShieldPriority_ != 0 &&
+      candidate.participant->poolPriority() >=
+      memoryPoolReclaimShieldPriority_;
+}
+
 void SharedArbitrator::checkIfAborted(ArbitrationOperation& op) {
   if (op.participant()->aborted()) {
     VELOX_MEM_POOL_ABORTED(
@@ -1130,7 +1348,8 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
     uint64_t targetBytes,
     std::unordered_set<uint64_t>& reclaimedParticipants,
     std::unordered_set<uint64_t>& failedParticipants,
-    bool& allParticipantsReclaimed) {
+    bool& allParticipantsReclaimed,
+    bool proactive) {
   TestValue::adjust(
       "facebook::velox::memory::SharedArbitrator::reclaimUsedMemoryBySpill",
       this);
@@ -1138,7 +1357,35 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   allParticipantsReclaimed = true;
   const uint64_t prevReclaimedBytes = reclaimedUsedBytes_;
   auto candidates = getCandidates();
+  if (proactive) {
+    candidates.erase(
+        std::remove_if(
+            candidates.begin(),
+            candidates.end(),
+            [&](const ArbitrationCandidate& candidate) {
+              return isShielded(candidate);
+            }),
+        candidates.end());
+  }
   sortCandidatesByReclaimableUsedCapacity(candidates);
+  if (proactive) {
+    // Lower priority participants are cheaper to spill as they are not
+    // latency sensitive.
+    std::stable_sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const ArbitrationCandidate& lhs, const ArbitrationCandidate& rhs) {
+          return lhs.participant->poolPriority() <
+              rhs.participant->poolPriority();
+        });
+  } else if (memoryPoolReclaimShieldPriority_ != 0) {
+    std::stable_partition(
+        candidates.begin(),
+        candidates.end(),
+        [&](const ArbitrationCandidate& candidate) {
+          return !isShielded(candidate);
+        });
+  }
 
   std::vector<ArbitrationCandidate> victims;
   victims.reserve(candidates.size());
@@ -1146,7 +1393,7 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
   for (auto& candidate : candidates) {
     if (candidate.reclaimableUsedCapacity <
         participantConfig_.minReclaimBytes) {
-      break;
+      continue;
     }
     if (failedParticipants.count(candidate.participant->id()) != 0) {
       VELOX_CHECK_EQ(
@@ -1159,6 +1406,14 @@ uint64_t SharedArbitrator::reclaimUsedMemoryBySpill(
       }
       continue;
     }
+    if (proactive) {
+      // Only reclaims the remaining target from each participant.
+      candidate.reclaimableUsedCapacity = std::min<uint64_t>(
+          candidate.reclaimableUsedCapacity,
+          std::max<uint64_t>(
+              targetBytes - bytesToReclaim,
+              participantConfig_.minReclaimBytes));
+    }
     bytesToReclaim += candidate.reclaimableUsedCapacity;
     reclaimedParticipants.insert(candidate.participant->id());
     victims.push_back(std::move(candidate));
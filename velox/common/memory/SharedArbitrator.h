@@ -50,6 +50,14 @@ class SharedArbitratorTestHelper;
 /// global arbitration first tries to reclaim memory by disk spilling and if it
 /// can't quickly reclaim enough memory, it then switchs to abort the younger
 /// queries which also have more memory usage.
+///
+/// Optionally, the global arbitration controller also runs proactively when the
+/// arbitrator's free capacity falls below a watermark so that the arbitration
+/// requests find free capacity instead of waiting for synchronous spilling.
+/// Queries can be shielded from reclaim by spilling by their memory pool
+/// priority. The controller can also manage the cache which shares the memory
+/// allocator with the queries, shrinking it in the background as the query
+/// memory demand grows.
 class SharedArbitrator : public memory::MemoryArbitrator {
  public:
   struct ExtraConfig {
@@ -226,6 +234,69 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     static bool globalArbitrationWithoutSpill(
         const std::unordered_map<std::string, std::string>& configs);
 
+    /// If not zero, the global arbitration controller also reclaims memory
+    /// ahead of demand when the arbitrator's free capacity falls below this
+    /// percentage of its capacity, until the free capacity is back at this
+    /// percentage. The proactive arbitration reclaims in the order of
+    /// increasing cost: first the unused capacity of the participants and then
+    /// used memory by spilling the lowest priority participants. It never
+    /// aborts and never spills the shielded participants (see
+    /// 'memory-pool-reclaim-shield-priority').
+    static constexpr std::string_view kProactiveArbitrationFreeCapacityPct{
+        "proactive-arbitration-free-capacity-pct"};
+    static constexpr uint32_t kDefaultProactiveArbitrationFreeCapacityPct{0};
+    static uint32_t proactiveArbitrationFreeCapacityPct(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// The interval at which the global arbitration controller checks the
+    /// arbitrator's free capacity for proactive arbitration and the cache size
+    /// for cache arbitration.
+    static constexpr std::string_view kProactiveArbitrationCheckInterval{
+        "proactive-arbitration-check-interval"};
+    static constexpr std::string_view kDefaultProactiveArbitrationCheckInterval{
+        "1s"};
+    static uint64_t proactiveArbitrationCheckIntervalNs(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// If not zero, the participants whose memory pool priority is at least
+    /// this value are shielded from reclaim by spilling. The proactive
+    /// arbitration never spills them and the global arbitration only spills
+    /// them after all the other participants. This keeps the interactive
+    /// queries from being stalled by spilling triggered by the batch queries.
+    static constexpr std::string_view kMemoryPoolReclaimShieldPriority{
+        "memory-pool-reclaim-shield-priority"};
+    static constexpr uint32_t kDefaultMemoryPoolReclaimShieldPriority{0};
+    static uint32_t memoryPoolReclaimShieldPriority(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// If true, the global arbitration controller manages the cache
+    /// registered with the memory allocator as an arbitration participant. The
+    /// cache target size leaves enough allocator space to back the capacity
+    /// granted to the query memory pools plus a share of the arbitrator's free
+    /// capacity which grows as the cache hit ratio drops. The cache is shrunk
+    /// to the target in the background so that the query memory allocations
+    /// don't stall on synchronous cache eviction.
+    static constexpr std::string_view kCacheArbitrationEnabled{
+        "cache-arbitration-enabled"};
+    static constexpr bool kDefaultCacheArbitrationEnabled{false};
+    static bool cacheArbitrationEnabled(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// The minimum cache target size set by cache arbitration.
+    static constexpr std::string_view kCacheMinCapacity{"cache-min-capacity"};
+    static constexpr std::string_view kDefaultCacheMinCapacity{"0B"};
+    static uint64_t cacheMinCapacity(
+        const std::unordered_map<std::string, std::string>& configs);
+
+    /// The maximum bytes to evict from the cache per cache arbitration run.
+    /// This spreads the cache shrink over several check intervals.
+    static constexpr std::string_view kCacheMaxShrinkBytesPerRun{
+        "cache-max-shrink-bytes-per-run"};
+    static constexpr std::string_view kDefaultCacheMaxShrinkBytesPerRun{
+        "256MB"};
+    static uint64_t cacheMaxShrinkBytesPerRun(
+        const std::unordered_map<std::string, std::string>& configs);
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -414,6 +485,28 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // Invoked to get the global arbitration target in bytes.
   uint64_t getGlobalArbitrationTarget();
 
+  // Returns the bytes to reclaim to bring the free capacity back to the
+  // proactive arbitration watermark or zero if the free capacity is above it
+  // or proactive arbitration is disabled.
+  uint64_t getProactiveArbitrationTarget() const;
+
+  // Invoked by global arbitration control thread to reclaim memory ahead of
+  // demand when the free capacity is below the proactive arbitration
+  // watermark. Returns the reclaimed bytes.
+  uint64_t runProactiveArbitration();
+
+  // Returns the cache size in bytes which leaves enough allocator space for
+  // the query memory. The free capacity of the arbitrator is left to the cache
+  // in proportion to the cache hit ratio since the last call.
+  uint64_t getCacheTarget(const Cache& cache);
+
+  // Invoked by global arbitration control thread to shrink the cache towards
+  // its target size in the background. Returns the freed cache bytes.
+  uint64_t runCacheArbitration();
+
+  // Returns true if 'candidate' is shielded from reclaim by spilling.
+  bool isShielded(const ArbitrationCandidate& candidate) const;
+
   // Invoked to run global arbitration to reclaim free or used memory from other
   // queries. The global arbitration run is protected by the exclusive lock of
   // 'arbitrationLock_' for serial execution mode. The function throws on
@@ -457,14 +550,19 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // if need to switch to abort to reclaim used memory in the next arbitration
   // round. The function returns the actually reclaimed used capacity in bytes.
   //
+  // If 'proactive' is true, the function skips the shielded participants,
+  // reclaims from the lower priority participants first and caps the reclaim
+  // from each participant at the remaining target.
+  //
   // NOTE: the function sorts participants based on their reclaimable used
   // memory capacity, and reclaims from participants with larger reclaimable
-  // used memory first.
+  // used memory first. The shielded participants are reclaimed last.
   uint64_t reclaimUsedMemoryBySpill(
       uint64_t targetBytes,
       std::unordered_set<uint64_t>& reclaimedParticipants,
       std::unordered_set<uint64_t>& failedParticipants,
-      bool& allParticipantsReclaimed);
+      bool& allParticipantsReclaimed,
+      bool proactive = false);
 
   uint64_t reclaimUsedMemoryBySpill(uint64_t targetBytes);
 
@@ -610,6 +708,13 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   const uint32_t globalArbitrationMemoryReclaimPct_;
   const double globalArbitrationAbortTimeRatio_;
   const bool globalArbitrationWithoutSpill_;
+  const uint32_t proactiveArbitrationFreeCapacityPct_;
+  const uint64_t proactiveArbitrationCheckIntervalNs_;
+  const uint32_t memoryPoolReclaimShieldPriority_;
+  const bool cacheArbitrationEnabled_;
+  const uint64_t cacheMinCapacity_;
+  const uint64_t cacheMaxShrinkBytesPerRun_;
+  MemoryAllocator* const allocator_;
 
   // The executor used to reclaim memory from multiple participants in parallel
   // at the background for global arbitration or external memory reclamation.
@@ -664,6 +769,14 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> globalArbitrationRuns_{0};
   tsan_atomic<uint64_t> globalArbitrationTimeNs_{0};
   tsan_atomic<uint64_t> globalArbitrationBytes_{0};
+  tsan_atomic<uint64_t> proactiveArbitrationRuns_{0};
+  tsan_atomic<uint64_t> proactiveArbitrationBytes_{0};
+  tsan_atomic<uint64_t> cacheArbitrationBytes_{0};
+
+  // The cache lookup stats at the previous cache arbitration run. Only
+  // accessed by the global arbitration controller thread.
+  uint64_t prevCacheLookups_{0};
+  uint64_t prevCacheHits_{0};
 
   std::atomic_uint64_t numRequests_{0};
   std::atomic_uint32_t numRunning_{0};
@@ -113,6 +113,39 @@ TEST_F(AllocationPoolTest, hugePages) {
   EXPECT_EQ(0, pool_->usedBytes());
 }
 
+TEST_F(AllocationPoolTest, contains) {
+  memory::AllocationPool allocationPool(pool_.get());
+  int stackValue;
+  EXPECT_FALSE(allocationPool.contains(&stackValue));
+
+  std::vector<char*> allocations;
+  allocationPool.setHugePageThreshold(256 << 10);
+  for (auto i = 0; i < 10; ++i) {
+    allocations.push_back(allocationPool.allocateFixed(100 << 10));
+  }
+  // Has small runs and a huge page run.
+  EXPECT_LT(2, allocationPool.numRanges());
+  for (auto* allocation : allocations) {
+    EXPECT_TRUE(allocationPool.contains(allocation));
+    EXPECT_TRUE(allocationPool.contains(allocation + (100 << 10) - 1));
+  }
+  for (auto i = 0; i < allocationPool.numRanges(); ++i) {
+    const auto range = allocationPool.rangeAt(i);
+    EXPECT_TRUE(allocationPool.contains(range.data()));
+    EXPECT_TRUE(allocationPool.contains(range.end() - 1));
+  }
+  // The free space at the end of the current run is not contained.
+  EXPECT_FALSE(allocationPool.contains(allocationPool.firstFreeInRun()));
+  EXPECT_FALSE(allocationPool.contains(&stackValue));
+
+  memory::AllocationPool moved(std::move(allocationPool));
+  EXPECT_TRUE(moved.contains(allocations.front()));
+  EXPECT_FALSE(allocationPool.contains(allocations.front()));
+
+  moved.clear();
+  EXPECT_FALSE(moved.contains(allocations.front()));
+}
+
 // This test relies on TestValue, so needs to be run in debug mode.
 DEBUG_ONLY_TEST_F(AllocationPoolTest, oomCleanUp) {
   // Test that when an OOM happens while growing an allocation in the
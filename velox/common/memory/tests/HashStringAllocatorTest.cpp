@@ -339,6 +339,72 @@ TEST_F(HashStringAllocatorTest, multipart) {
   ASSERT_EQ(allocatedBytes, allocator_->currentBytes());
 }
 
+TEST_F(HashStringAllocatorTest, compact) {
+  constexpr int32_t kNumSamples = 10'000;
+  std::vector<Multipart> data(kNumSamples);
+  for (auto i = 0; i < kNumSamples; ++i) {
+    // Some allocations are larger than kMaxAlloc.
+    auto chars = randomString(i % 100 == 0 ? 10'000 : 0);
+    ByteOutputStream stream(allocator_.get());
+    data[i].start = allocator_->newWrite(stream, chars.size());
+    stream.appendStringView(chars);
+    data[i].current = allocator_->finishWrite(stream, rand32() % 100).second;
+    data[i].reference = chars;
+  }
+  // Free most of the data to leave the live blocks scattered over the slabs.
+  for (auto i = 0; i < kNumSamples; ++i) {
+    if (i % 4 != 0) {
+      checkAndFree(data[i]);
+    }
+  }
+  const auto freeRatio = allocator_->freeRatio();
+  EXPECT_GT(freeRatio, 0.5);
+
+  const auto retainedSize = allocator_->retainedSize();
+  const auto freedBytes =
+      allocator_->compact([&](const HSA::Relocator& relocator) {
+        for (auto& d : data) {
+          if (!d.start.isSet()) {
+            continue;
+          }
+          const auto offset = HSA::offset(d.start.header, d.current);
+          auto* oldHeader = d.start.header;
+          d.start.header = relocator(oldHeader);
+          // Relocating again returns the same copy.
+          ASSERT_EQ(d.start.header, relocator(oldHeader));
+          d.start.position = d.start.header->begin();
+          d.current = HSA::seek(d.start.header, offset);
+        }
+      });
+  EXPECT_GT(freedBytes, 0);
+  EXPECT_EQ(allocator_->retainedSize(), retainedSize - freedBytes);
+  EXPECT_LT(allocator_->freeRatio(), freeRatio);
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  // The relocated data can be extended at the remapped positions.
+  for (auto& d : data) {
+    if (!d.start.isSet()) {
+      continue;
+    }
+    checkMultipart(d);
+    auto chars = randomString();
+    ByteOutputStream stream(allocator_.get());
+    allocator_->extendWrite(d.current, stream);
+    stream.appendStringView(chars);
+    d.current = allocator_->finishWrite(stream, 0).second;
+    d.reference.insert(d.reference.end(), chars.begin(), chars.end());
+    checkMultipart(d);
+  }
+  ASSERT_EQ(allocator_->checkConsistency(), allocator_->currentBytes());
+
+  for (auto& d : data) {
+    if (d.start.isSet()) {
+      checkAndFree(d);
+    }
+  }
+  EXPECT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, mixedMultipart) {
   // Create multi-part allocation with a mix of block allocated from Arena and
   // MemoryPool.
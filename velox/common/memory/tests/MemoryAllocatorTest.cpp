@@ -20,6 +20,7 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/Numa.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
 
@@ -31,10 +32,18 @@
 #include <gtest/gtest.h>
 
 #ifdef linux
+#include <sys/mman.h>
 #include <fstream>
 #endif // linux
 
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
 DECLARE_bool(velox_memory_leak_check_enabled);
+DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_int64(velox_memory_hugepage_align_bytes);
+DECLARE_bool(velox_memory_prefault_hugepages);
 
 using namespace facebook::velox::common::testutil;
 
@@ -45,6 +54,30 @@ struct ProcessSize {
   int64_t vsize;
   int64_t rss;
 };
+
+// Returns true if anonymous memory can be advised to use transparent huge
+// pages and be prefaulted on this host.
+bool hugePagesSupported() {
+#ifdef linux
+  const auto bytes = AllocationTraits::kHugePageSize;
+  void* data = ::mmap(
+      nullptr,
+      bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  const bool supported = ::madvise(data, bytes, MADV_HUGEPAGE) == 0 &&
+      ::madvise(data, bytes, MADV_POPULATE_WRITE) == 0;
+  ::munmap(data, bytes);
+  return supported;
+#else
+  return false;
+#endif
+}
 } // namespace
 
 static constexpr uint64_t kCapacityBytes = 1ULL << 30;
@@ -1153,6 +1186,58 @@ TEST_P(MemoryAllocatorTest, allocContiguousGrow) {
   freeSmall(kCapacityPages);
 }
 
+TEST_P(MemoryAllocatorTest, allocContiguousHugePages) {
+  if (!hugePagesSupported()) {
+    GTEST_SKIP() << "Transparent huge pages are not available";
+  }
+  gflags::FlagSaver flagSaver;
+  // The alignment is off by default.
+  ASSERT_EQ(FLAGS_velox_memory_hugepage_align_bytes, 0);
+  FLAGS_velox_memory_use_hugepages = true;
+  FLAGS_velox_memory_hugepage_align_bytes = 4 << 20;
+  FLAGS_velox_memory_prefault_hugepages = true;
+  constexpr uint64_t kHugePageSize = AllocationTraits::kHugePageSize;
+  const auto numHugePagePages = AllocationTraits::numPagesInHugePage();
+
+  // Below the alignment threshold, only the huge page aligned part of the
+  // allocation is in the huge page range.
+  ContiguousAllocation small;
+  ASSERT_TRUE(instance_->allocateContiguous(
+      numHugePagePages, nullptr, small, nullptr, numHugePagePages));
+  const auto smallRange = small.hugePageRange();
+  const auto smallHugePageBytes =
+      smallRange.has_value() ? smallRange->size() : 0;
+  ASSERT_EQ(instance_->stats().hugePageBytes, smallHugePageBytes);
+
+  // Above the threshold, the whole allocation is huge page aligned.
+  ContiguousAllocation large;
+  ASSERT_TRUE(instance_->allocateContiguous(
+      numHugePagePages, nullptr, large, nullptr, 4 * numHugePagePages));
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(large.data()) % kHugePageSize, 0);
+  ASSERT_EQ(large.hugePageRange()->size(), large.maxSize());
+  auto stats = instance_->stats();
+  ASSERT_EQ(stats.hugePageBytes, smallHugePageBytes + 4 * kHugePageSize);
+  ASSERT_EQ(
+      stats.prefaultedHugePageBytes,
+      (smallHugePageBytes > 0 ? kHugePageSize : 0) + kHugePageSize);
+
+  // Growing prefaults the added huge pages.
+  ASSERT_TRUE(instance_->growContiguous(2 * numHugePagePages, large));
+  ASSERT_EQ(
+      instance_->stats().prefaultedHugePageBytes,
+      stats.prefaultedHugePageBytes + 2 * kHugePageSize);
+  // The prefaulted memory is zero filled.
+  for (auto offset = 0; offset < large.size();
+       offset += AllocationTraits::kPageSize) {
+    ASSERT_EQ(large.data<char>()[offset], 0);
+  }
+
+  instance_->freeContiguous(small);
+  instance_->freeContiguous(large);
+  ASSERT_EQ(instance_->stats().hugePageBytes, 0);
+  ASSERT_EQ(instance_->numAllocated(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, DISABLED_allocContiguousVsize) {
   // Works with malloc and mmap allocators where MmapArena is not on.
   auto initialSize = processSize();
@@ -1991,4 +2076,55 @@ TEST_F(MmapConfigTest, sizeClasses) {
   }
 }
 
+TEST_F(MmapConfigTest, numaNodes) {
+  constexpr int32_t kNumNodes = 2;
+  MmapAllocator::Options options;
+  options.capacity = 256 << 20;
+  options.numaNodes = kNumNodes;
+  MmapAllocator allocator(options);
+  ASSERT_EQ(allocator.numaNodes(), kNumNodes);
+
+  // Allocates from each node. An allocation from the node of the current CPU
+  // is local, the other is remote.
+  const auto currentNode = numaCurrentNode() % kNumNodes;
+  std::vector<Allocation> allocations(kNumNodes);
+  for (auto node = 0; node < kNumNodes; ++node) {
+    ScopedNumaNode scopedNode(node);
+    ASSERT_EQ(numaPreferredNode(), node);
+    ASSERT_TRUE(allocator.allocateNonContiguous(100, allocations[node]));
+    ASSERT_EQ(allocations[node].numPages(), 100);
+  }
+  ASSERT_EQ(numaPreferredNode(), kNoNumaNode);
+  auto stats = allocator.stats();
+  if (numaCurrentNode() == currentNode) {
+    ASSERT_EQ(stats.numaLocalBytes, AllocationTraits::pageBytes(100));
+    ASSERT_EQ(stats.numaRemoteBytes, AllocationTraits::pageBytes(100));
+  }
+  ASSERT_EQ(
+      stats.numaLocalBytes + stats.numaRemoteBytes,
+      AllocationTraits::pageBytes(2 * 100));
+
+  // The allocations of different nodes do not share addresses and are freed
+  // to their own size classes.
+  ASSERT_NE(
+      allocations[0].runAt(0).data<char>(),
+      allocations[1].runAt(0).data<char>());
+  for (auto& allocation : allocations) {
+    allocator.freeNonContiguous(allocation);
+  }
+  ASSERT_EQ(allocator.numAllocated(), 0);
+  ASSERT_TRUE(allocator.checkConsistency());
+
+  // Contiguous allocations also count towards the node stats.
+  ContiguousAllocation contiguous;
+  {
+    ScopedNumaNode scopedNode(currentNode);
+    ASSERT_TRUE(allocator.allocateContiguous(1'000, nullptr, contiguous));
+  }
+  ASSERT_EQ(
+      allocator.stats().numaLocalBytes + allocator.stats().numaRemoteBytes,
+      AllocationTraits::pageBytes(2 * 100 + 1'000));
+  allocator.freeContiguous(contiguous);
+}
+
 } // namespace facebook::velox::memory
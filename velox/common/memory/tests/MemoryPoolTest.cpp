@@ -593,6 +593,112 @@ TEST_P(MemoryPoolTest, releasableMemory) {
   }
 }
 
+TEST_P(MemoryPoolTest, smallAllocationCache) {
+  constexpr int64_t kCacheBytes = 40 << 10;
+  MemoryManager::Options options;
+  options.allocatorCapacity = kDefaultCapacity;
+  options.smallAllocationCacheBytes = kCacheBytes;
+  setupMemory(options);
+  auto* allocator = getMemoryManager()->allocator();
+  const auto allocatorBytes = allocator->totalUsedBytes();
+  auto root = getMemoryManager()->addRootPool("smallAllocationCache", 4 * GB);
+  auto leaf = root->addLeafChild("leaf");
+  auto* leafImpl = static_cast<MemoryPoolImpl*>(leaf.get());
+
+  // The pool counts the size class of a small allocation as used.
+  void* buffer = leaf->allocate(1000);
+  ASSERT_EQ(leaf->usedBytes(), 1024);
+  const auto reservedBytes = leaf->reservedBytes();
+  leaf->free(buffer, 1000);
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  ASSERT_EQ(leafImpl->cachedBytes(), 1024);
+  ASSERT_EQ(leaf->reservedBytes(), reservedBytes);
+
+  // An allocation of the same size class reuses the cached buffer.
+  void* reused = leaf->allocate(900);
+  ASSERT_EQ(reused, buffer);
+  ASSERT_EQ(leaf->usedBytes(), 1024);
+  ASSERT_EQ(leafImpl->cachedBytes(), 0);
+  leaf->free(reused, 900);
+
+  // Zero filled allocations from the cache are zeroed.
+  void* dirty = leaf->allocate(1024);
+  ASSERT_EQ(dirty, buffer);
+  ::memset(dirty, 0xff, 1024);
+  leaf->free(dirty, 1024);
+  auto* zeroed = static_cast<char*>(leaf->allocateZeroFilled(128, 8));
+  ASSERT_EQ(zeroed, buffer);
+  for (auto i = 0; i < 1024; ++i) {
+    ASSERT_EQ(zeroed[i], 0);
+  }
+  ASSERT_EQ(leaf->usedBytes(), 1024);
+  leaf->free(zeroed, 1024);
+
+  // Large allocations are not cached.
+  void* large = leaf->allocate(64 << 10);
+  leaf->free(large, 64 << 10);
+  ASSERT_EQ(leafImpl->cachedBytes(), 1024);
+
+  // A full magazine drains a batch to the shared free list. The magazines and
+  // the shared free list together are bounded by 'kCacheBytes'. The rest goes
+  // back to the allocator. An empty magazine is refilled from the shared free
+  // list.
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 6; ++i) {
+    buffers.push_back(leaf->allocate(8 << 10));
+  }
+  ASSERT_EQ(leaf->usedBytes(), 6 * (8 << 10));
+  for (auto* smallBuffer : buffers) {
+    leaf->free(smallBuffer, 8 << 10);
+  }
+  ASSERT_EQ(leaf->usedBytes(), 0);
+  // Two buffers in the magazine and two in the shared free list.
+  ASSERT_EQ(leafImpl->cachedBytes(), 1024 + 4 * (8 << 10));
+  ASSERT_EQ(
+      allocator->totalUsedBytes(),
+      allocatorBytes + leafImpl->cachedBytes());
+  for (auto i = 0; i < 4; ++i) {
+    void* smallBuffer = leaf->allocate(8 << 10);
+    ASSERT_NE(
+        std::find(buffers.begin(), buffers.end(), smallBuffer), buffers.end());
+    buffers[i] = smallBuffer;
+  }
+  ASSERT_EQ(leafImpl->cachedBytes(), 1024);
+  for (auto i = 0; i < 4; ++i) {
+    leaf->free(buffers[i], 8 << 10);
+  }
+
+  // The magazine of an exited thread is returned to the allocator.
+  const auto cachedBytes = leafImpl->cachedBytes();
+  const auto cachedAllocatorBytes = allocator->totalUsedBytes();
+  std::thread([&]() {
+    void* threadBuffer = leaf->allocate(100);
+    leaf->free(threadBuffer, 100);
+  }).join();
+  ASSERT_EQ(leafImpl->cachedBytes(), cachedBytes);
+  ASSERT_EQ(allocator->totalUsedBytes(), cachedAllocatorBytes);
+
+  // Releasing the pool's reservation returns the cached buffers.
+  leaf->release();
+  ASSERT_EQ(leafImpl->cachedBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+  ASSERT_EQ(allocator->totalUsedBytes(), allocatorBytes);
+
+  // A pool destroyed with cached buffers returns them.
+  buffer = leaf->allocate(1000);
+  leaf->free(buffer, 1000);
+  ASSERT_EQ(leafImpl->cachedBytes(), 1024);
+  ASSERT_EQ(
+      static_cast<MemoryPoolImpl*>(root.get())->freeCachedAllocations(), 1024);
+  ASSERT_EQ(leafImpl->cachedBytes(), 0);
+  buffer = leaf->allocate(1000);
+  leaf->free(buffer, 1000);
+  leaf.reset();
+  ASSERT_EQ(root->reservedBytes(), 0);
+  ASSERT_EQ(allocator->totalUsedBytes(), allocatorBytes);
+}
+
 TEST_P(MemoryPoolTest, ReallocTestSameSize) {
   auto manager = getMemoryManager();
   auto root = manager->addRootPool();
@@ -430,6 +430,55 @@ MockTask::~MockTask() {
   }
 }
 
+// A cache which only reports its size and lookup stats to the arbitrator.
+class FakeCache : public Cache {
+ public:
+  explicit FakeCache(MemoryAllocator* allocator) : allocator_(allocator) {}
+
+  bool makeSpace(
+      MachinePageCount /*unused*/,
+      std::function<bool(Allocation&)> /*unused*/) override {
+    return false;
+  }
+
+  uint64_t shrink(uint64_t targetBytes) override {
+    return shrinkInBackground(targetBytes);
+  }
+
+  uint64_t shrinkInBackground(uint64_t targetBytes) override {
+    const uint64_t freedBytes = std::min(targetBytes, cachedBytes_);
+    cachedBytes_ -= freedBytes;
+    return freedBytes;
+  }
+
+  uint64_t cachedBytes() const override {
+    return cachedBytes_;
+  }
+
+  std::pair<uint64_t, uint64_t> lookupStats() const override {
+    return {numLookups_, numHits_};
+  }
+
+  MemoryAllocator* allocator() const override {
+    return allocator_;
+  }
+
+  void setCachedBytes(uint64_t bytes) {
+    cachedBytes_ = bytes;
+  }
+
+  void addLookups(uint64_t numLookups, uint64_t numHits) {
+    numLookups_ += numLookups;
+    numHits_ += numHits;
+  }
+
+ private:
+  MemoryAllocator* const allocator_;
+  uint64_t cachedBytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+};
+
 class MockSharedArbitrationTest : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -467,7 +516,10 @@ class MockSharedArbitrationTest : public testing::Test {
       bool globalArbitrationWithoutSpill = false,
       // Set the globalArbitrationAbortTimeRatio to be very small so that the
       // query can be aborted sooner and the test would not timeout.
-      double globalArbitrationAbortTimeRatio = 0.005) {
+      double globalArbitrationAbortTimeRatio = 0.005,
+      uint32_t proactiveArbitrationFreeCapacityPct = 0,
+      uint32_t memoryPoolReclaimShieldPriority = 0,
+      bool cacheArbitrationEnabled = false) {
     MemoryManager::Options options;
     options.allocatorCapacity = memoryCapacity;
     std::string arbitratorKind = "SHARED";
@@ -506,7 +558,15 @@ class MockSharedArbitrationTest : public testing::Test {
         {std::string(ExtraConfig::kGlobalArbitrationWithoutSpill),
          folly::to<std::string>(globalArbitrationWithoutSpill)},
         {std::string(ExtraConfig::kGlobalArbitrationAbortTimeRatio),
-         folly::to<std::string>(globalArbitrationAbortTimeRatio)}};
+         folly::to<std::string>(globalArbitrationAbortTimeRatio)},
+        {std::string(ExtraConfig::kProactiveArbitrationFreeCapacityPct),
+         folly::to<std::string>(proactiveArbitrationFreeCapacityPct)},
+        // The tests run the proactive arbitration explicitly.
+        {std::string(ExtraConfig::kProactiveArbitrationCheckInterval), "1h"},
+        {std::string(ExtraConfig::kMemoryPoolReclaimShieldPriority),
+         folly::to<std::string>(memoryPoolReclaimShieldPriority)},
+        {std::string(ExtraConfig::kCacheArbitrationEnabled),
+         folly::to<std::string>(cacheArbitrationEnabled)}};
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
@@ -2165,6 +2225,129 @@ TEST_F(MockSharedArbitrationTest, globalArbitrationWithMemoryPoolPriority) {
       "Memory pool aborted to reclaim used memory");
 }
 
+TEST_F(MockSharedArbitrationTest, proactiveArbitration) {
+  const int64_t memoryCapacity = 512 << 20;
+  const uint32_t shieldPriority = 100;
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      kMemoryReclaimThreadsHwMultiplier,
+      nullptr,
+      true,
+      5 * 60 * 1'000'000'000UL,
+      false,
+      0.005,
+      /*proactiveArbitrationFreeCapacityPct=*/25,
+      shieldPriority);
+  test::SharedArbitratorTestHelper arbitratorHelper(arbitrator_);
+
+  // task0 is shielded from spilling by its priority.
+  auto task0 = addTask(kMaxMemory, shieldPriority);
+  auto* op0 = task0->addMemoryOp(true);
+  op0->allocate(256 * MB);
+  // task1 has the lowest priority and is spilled first.
+  auto task1 = addTask(kMaxMemory, 10);
+  auto* op1 = task1->addMemoryOp(true);
+  for (int i = 0; i < 4; ++i) {
+    op1->allocate(32 * MB);
+  }
+  auto task2 = addTask(kMaxMemory, 50);
+  auto* op2 = task2->addMemoryOp(true);
+  op2->allocate(96 * MB);
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 32 * MB);
+
+  // The free capacity is 96MB below the 25% watermark.
+  ASSERT_GE(arbitratorHelper.runProactiveArbitration(), 96 * MB);
+  ASSERT_EQ(arbitratorHelper.proactiveArbitrationRuns(), 1);
+  ASSERT_GE(arbitrator_->stats().freeCapacityBytes, 128 * MB);
+  ASSERT_EQ(op0->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(op1->reclaimer()->stats().numReclaims, 1);
+  ASSERT_EQ(op2->reclaimer()->stats().numReclaims, 0);
+  // Only the remaining target is reclaimed from task1.
+  ASSERT_EQ(op1->pool()->usedBytes(), 32 * MB);
+  ASSERT_EQ(op0->pool()->usedBytes(), 256 * MB);
+  ASSERT_EQ(op2->pool()->usedBytes(), 96 * MB);
+  ASSERT_TRUE(task0->error() == nullptr);
+  ASSERT_TRUE(task1->error() == nullptr);
+  ASSERT_TRUE(task2->error() == nullptr);
+
+  // No-op once the free capacity is above the watermark.
+  ASSERT_EQ(arbitratorHelper.runProactiveArbitration(), 0);
+  ASSERT_EQ(arbitratorHelper.proactiveArbitrationRuns(), 1);
+}
+
+TEST_F(MockSharedArbitrationTest, cacheArbitration) {
+  const int64_t memoryCapacity = 512 << 20;
+  setupMemory(
+      memoryCapacity,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      0,
+      kMemoryReclaimThreadsHwMultiplier,
+      nullptr,
+      true,
+      5 * 60 * 1'000'000'000UL,
+      false,
+      0.005,
+      0,
+      0,
+      /*cacheArbitrationEnabled=*/true);
+  test::SharedArbitratorTestHelper arbitratorHelper(arbitrator_);
+  // No cache registered.
+  ASSERT_EQ(arbitratorHelper.runCacheArbitration(), 0);
+
+  auto cache = std::make_shared<FakeCache>(manager_->allocator());
+  manager_->allocator()->registerCache(cache);
+  cache->setCachedBytes(memoryCapacity);
+
+  auto task = addTask(kMaxMemory);
+  auto* op = task->addMemoryOp(true);
+  op->allocate(memoryCapacity / 4);
+
+  // With all hits, the cache only makes room for the capacity granted to the
+  // query.
+  cache->addLookups(100, 100);
+  ASSERT_EQ(arbitratorHelper.runCacheArbitration(), memoryCapacity / 4);
+  ASSERT_EQ(cache->cachedBytes(), memoryCapacity * 3 / 4);
+  // No-op if the cache is at its target.
+  ASSERT_EQ(arbitratorHelper.runCacheArbitration(), 0);
+
+  // With half hits, the cache also makes room for half of the free capacity.
+  cache->addLookups(100, 50);
+  ASSERT_EQ(arbitratorHelper.runCacheArbitration(), memoryCapacity * 3 / 8);
+  ASSERT_EQ(cache->cachedBytes(), memoryCapacity * 3 / 8);
+
+  // With no hits, the cache makes room for all the free capacity but the
+  // shrink is capped at 256MB per run.
+  cache->setCachedBytes(memoryCapacity * 3 / 4);
+  cache->addLookups(100, 0);
+  ASSERT_EQ(arbitratorHelper.runCacheArbitration(), 256 * MB);
+  ASSERT_EQ(cache->cachedBytes(), 128 * MB);
+  ASSERT_EQ(
+      arbitratorHelper.cacheArbitrationBytes(),
+      memoryCapacity * 5 / 8 + 256 * MB);
+  ASSERT_EQ(op->pool()->usedBytes(), memoryCapacity / 4);
+  ASSERT_TRUE(task->error() == nullptr);
+}
+
 DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, multipleGlobalRuns) {
   const int64_t memoryCapacity = 512 << 20;
   const uint64_t memoryPoolInitCapacity = memoryCapacity / 2;
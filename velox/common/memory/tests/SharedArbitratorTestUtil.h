@@ -70,6 +70,22 @@ class SharedArbitratorTestHelper {
     return arbitrator_->globalArbitrationRuns_;
   }
 
+  uint64_t runProactiveArbitration() {
+    return arbitrator_->runProactiveArbitration();
+  }
+
+  uint64_t proactiveArbitrationRuns() const {
+    return arbitrator_->proactiveArbitrationRuns_;
+  }
+
+  uint64_t runCacheArbitration() {
+    return arbitrator_->runCacheArbitration();
+  }
+
+  uint64_t cacheArbitrationBytes() const {
+    return arbitrator_->cacheArbitrationBytes_;
+  }
+
   bool hasShutdown() const {
     std::lock_guard<std::mutex> l(arbitrator_->stateMutex_);
     return arbitrator_->hasShutdownLocked();
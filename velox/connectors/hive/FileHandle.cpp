@@ -40,12 +40,13 @@ std::string groupName(const std::string& filename) {
 } // namespace
 
 std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
-    const std::string& filename,
+    const FileHandleKey& key,
     const FileProperties* properties,
     filesystems::File::IoStats* stats) {
   // We have seen cases where drivers are stuck when creating file handles.
   // Adding a trace here to spot this more easily in future.
   process::TraceContext trace("FileHandleGenerator::operator()");
+  const auto& filename = key.filename;
   uint64_t elapsedTimeUs{0};
   std::unique_ptr<FileHandle> fileHandle;
   {
@@ -60,7 +61,10 @@ std::unique_ptr<FileHandle> FileHandleGenerator::operator()(
     }
     fileHandle->file = filesystems::getFileSystem(filename, properties_)
                            ->openFileForRead(filename, options);
-    fileHandle->uuid = StringIdLease(fileIds(), filename);
+    // The cached data of the file is keyed on its modification time if known,
+    // so that a file rewritten at the same path does not hit stale data.
+    fileHandle->uuid =
+        StringIdLease(fileIds(), fileIdentity(filename, key.modificationTime));
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
             << " uuid: " << fileHandle->uuid.id();
@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <optional>
+
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/config/Config.h"
@@ -54,12 +57,42 @@ struct FileHandle {
   // first diff we'll not include the map.
 };
 
+/// Identifies a cached FileHandle. A file rewritten at the same path gets a new
+/// FileHandle, and with it a new 'uuid', if the modification time is known.
+struct FileHandleKey {
+  std::string filename;
+  std::optional<int64_t> modificationTime;
+
+  FileHandleKey(
+      std::string _filename,
+      std::optional<int64_t> _modificationTime = std::nullopt)
+      : filename(std::move(_filename)), modificationTime(_modificationTime) {}
+
+  bool operator==(const FileHandleKey& other) const {
+    return filename == other.filename &&
+        modificationTime == other.modificationTime;
+  }
+};
+
+} // namespace facebook::velox
+
+template <>
+struct std::hash<facebook::velox::FileHandleKey> {
+  size_t operator()(const facebook::velox::FileHandleKey& key) const {
+    return facebook::velox::bits::hashMix(
+        std::hash<std::string>()(key.filename),
+        std::hash<std::optional<int64_t>>()(key.modificationTime));
+  }
+};
+
+namespace facebook::velox {
+
 /// Estimates the memory usage of a FileHandle object.
 struct FileHandleSizer {
   uint64_t operator()(const FileHandle& a);
 };
 
-using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
+using FileHandleCache = SimpleLRUCache<FileHandleKey, FileHandle>;
 
 // Creates FileHandles via the Generator interface the CachedFactory requires.
 class FileHandleGenerator {
@@ -68,7 +101,7 @@ class FileHandleGenerator {
   FileHandleGenerator(std::shared_ptr<const config::ConfigBase> properties)
       : properties_(std::move(properties)) {}
   std::unique_ptr<FileHandle> operator()(
-      const std::string& filename,
+      const FileHandleKey& key,
       const FileProperties* properties,
       filesystems::File::IoStats* stats);
 
@@ -77,14 +110,14 @@ class FileHandleGenerator {
 };
 
 using FileHandleFactory = CachedFactory<
-    std::string,
+    FileHandleKey,
     FileHandle,
     FileHandleGenerator,
     FileProperties,
     filesystems::File::IoStats,
     FileHandleSizer>;
 
-using FileHandleCachedPtr = CachedPtr<std::string, FileHandle>;
+using FileHandleCachedPtr = CachedPtr<FileHandleKey, FileHandle>;
 
 using FileHandleCacheStats = SimpleLRUCacheStats;
 
@@ -100,6 +100,36 @@ bool HiveConfig::isParquetUseColumnNames(
       config_->get<bool>(kParquetUseColumnNames, false));
 }
 
+bool HiveConfig::isParquetPageIndexFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetPageIndexFilterEnabledSession,
+      config_->get<bool>(kParquetPageIndexFilterEnabled, false));
+}
+
+bool HiveConfig::isParquetBloomFilterEnabled(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kParquetBloomFilterEnabledSession,
+      config_->get<bool>(kParquetBloomFilterEnabled, false));
+}
+
+int32_t HiveConfig::parquetReadAheadPages(
+    const config::ConfigBase* session) const {
+  return session->get<int32_t>(
+      kParquetReadAheadPagesSession,
+      config_->get<int32_t>(kParquetReadAheadPages, 0));
+}
+
+uint64_t HiveConfig::parquetReadAheadBytes(
+    const config::ConfigBase* session) const {
+  return config::toCapacity(
+      session->get<std::string>(
+          kParquetReadAheadBytesSession,
+          config_->get<std::string>(kParquetReadAheadBytes, "8MB")),
+      config::CapacityUnit::BYTE);
+}
+
 bool HiveConfig::isFileColumnNamesReadAsLowerCase(
     const config::ConfigBase* session) const {
   return session->get<bool>(
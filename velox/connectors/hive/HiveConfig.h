@@ -80,6 +80,35 @@ class HiveConfig {
   static constexpr const char* kParquetUseColumnNamesSession =
       "parquet_use_column_names";
 
+  /// Skips Parquet pages using the page index (ColumnIndex and OffsetIndex)
+  /// when the filters cannot pass any row of the page.
+  static constexpr const char* kParquetPageIndexFilterEnabled =
+      "hive.parquet.page-index-filter.enabled";
+  static constexpr const char* kParquetPageIndexFilterEnabledSession =
+      "parquet_page_index_filter_enabled";
+
+  /// Skips Parquet row groups whose Bloom filters contain none of the values
+  /// of an equality or IN filter.
+  static constexpr const char* kParquetBloomFilterEnabled =
+      "hive.parquet.bloom-filter.enabled";
+  static constexpr const char* kParquetBloomFilterEnabledSession =
+      "parquet_bloom_filter_enabled";
+
+  /// Maximum number of Parquet data pages of a column chunk that are
+  /// decompressed on the connector executor ahead of the page being decoded.
+  /// 0 disables read-ahead.
+  static constexpr const char* kParquetReadAheadPages =
+      "hive.parquet.read-ahead-pages";
+  static constexpr const char* kParquetReadAheadPagesSession =
+      "parquet_read_ahead_pages";
+
+  /// Maximum compressed plus decompressed bytes of the Parquet pages read ahead
+  /// per column.
+  static constexpr const char* kParquetReadAheadBytes =
+      "hive.parquet.read-ahead-bytes";
+  static constexpr const char* kParquetReadAheadBytesSession =
+      "parquet_read_ahead_bytes";
+
   /// Reads the source file column name as lower case.
   static constexpr const char* kFileColumnNamesReadAsLowerCase =
       "file-column-names-read-as-lower-case";
@@ -202,6 +231,15 @@ class HiveConfig {
 
   bool isParquetUseColumnNames(const config::ConfigBase* session) const;
 
+  bool isParquetPageIndexFilterEnabled(
+      const config::ConfigBase* session) const;
+
+  bool isParquetBloomFilterEnabled(const config::ConfigBase* session) const;
+
+  int32_t parquetReadAheadPages(const config::ConfigBase* session) const;
+
+  uint64_t parquetReadAheadBytes(const config::ConfigBase* session) const;
+
   bool isFileColumnNamesReadAsLowerCase(
       const config::ConfigBase* session) const;
 
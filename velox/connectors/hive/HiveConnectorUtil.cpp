@@ -566,6 +566,14 @@ void configureReaderOptions(
     case dwio::common::FileFormat::PARQUET: {
       useColumnNamesForColumnMapping =
           hiveConfig->isParquetUseColumnNames(sessionProperties);
+      readerOptions.setPageIndexFilterEnabled(
+          hiveConfig->isParquetPageIndexFilterEnabled(sessionProperties));
+      readerOptions.setBloomFilterEnabled(
+          hiveConfig->isParquetBloomFilterEnabled(sessionProperties));
+      readerOptions.setReadAheadPages(
+          hiveConfig->parquetReadAheadPages(sessionProperties));
+      readerOptions.setReadAheadBytes(
+          hiveConfig->parquetReadAheadBytes(sessionProperties));
       break;
     }
     default:
@@ -197,6 +197,7 @@ HiveDataSource::HiveDataSource(
       hiveConfig_->readStatsBasedFilterReorderDisabled(
           connectorQueryCtx_->sessionProperties()),
       pool_);
+  shareFilterSelectivity(*scanSpec_);
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
@@ -267,11 +268,22 @@ std::vector<column_index_t> HiveDataSource::setupBucketConversion() {
             connectorQueryCtx_->sessionProperties()),
         pool_);
     newScanSpec->moveAdaptationFrom(*scanSpec_);
+    shareFilterSelectivity(*newScanSpec);
     scanSpec_ = std::move(newScanSpec);
   }
   return bucketChannels;
 }
 
+void HiveDataSource::shareFilterSelectivity(common::ScanSpec& scanSpec) const {
+  if (hiveConfig_->readStatsBasedFilterReorderDisabled(
+          connectorQueryCtx_->sessionProperties())) {
+    return;
+  }
+  scanSpec.setFilterSelectivityStats(
+      common::FilterSelectivityStats::getOrCreate(
+          connectorQueryCtx_->scanId()));
+}
+
 void HiveDataSource::setupRowIdColumn() {
   VELOX_CHECK(split_->rowIdProperties.has_value());
   const auto& props = *split_->rowIdProperties;
@@ -130,6 +130,10 @@ class HiveDataSource : public DataSource {
 
   void setupRowIdColumn();
 
+  // Shares the filter selectivity of 'scanSpec' with the other drivers of the
+  // scan unless stats based filter reordering is disabled.
+  void shareFilterSelectivity(common::ScanSpec& scanSpec) const;
+
   // Evaluates remainingFilter_ on the specified vector. Returns number of rows
   // passed. Populates filterEvalCtx_.selectedIndices and selectedBits if only
   // some rows passed the filter. If none or all rows passed
@@ -291,9 +291,13 @@ void SplitReader::createReader() {
 
   FileHandleCachedPtr fileHandleCachePtr;
   try {
+    const auto* properties =
+        hiveSplit_->properties.has_value() ? &*hiveSplit_->properties : nullptr;
     fileHandleCachePtr = fileHandleFactory_->generate(
-        hiveSplit_->filePath,
-        hiveSplit_->properties.has_value() ? &*hiveSplit_->properties : nullptr,
+        FileHandleKey(
+            hiveSplit_->filePath,
+            properties ? properties->modificationTime : std::nullopt),
+        properties,
         fsStats_ ? fsStats_.get() : nullptr);
     VELOX_CHECK_NOT_NULL(fileHandleCachePtr.get());
   } catch (const VeloxRuntimeError& e) {
@@ -380,6 +384,11 @@ void SplitReader::createRowReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       baseRowReaderOpts_);
+  if (executor_ != nullptr && baseReaderOpts_.readAheadPages() > 0) {
+    // The executor is owned by the connector, which outlives the row reader.
+    baseRowReaderOpts_.setDecodingExecutor(
+        std::shared_ptr<folly::Executor>(executor_, [](folly::Executor*) {}));
+  }
   baseRowReader_ = baseReader_->createRowReader(baseRowReaderOpts_);
 }
 
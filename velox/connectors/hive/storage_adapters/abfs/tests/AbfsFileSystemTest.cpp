@@ -163,7 +163,7 @@ TEST_F(AbfsFileSystemTest, openFileForReadWithInvalidOptions) {
 
 TEST_F(AbfsFileSystemTest, fileHandleWithProperties) {
   FileHandleFactory factory(
-      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1),
+      std::make_unique<FileHandleCache>(1),
       std::make_unique<FileHandleGenerator>(azuriteServer_->hiveConfig()));
   FileProperties properties = {15 + kOneMB, 1};
   auto fileHandleProperties =
@@ -69,7 +69,7 @@ TEST_F(S3FileSystemRegistrationTest, fileHandle) {
   }
   auto hiveConfig = minioServer_->hiveConfig();
   FileHandleFactory factory(
-      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1000),
+      std::make_unique<FileHandleCache>(1000),
       std::make_unique<FileHandleGenerator>(hiveConfig));
   auto fileHandleCachePtr = factory.generate(s3File);
   readData(fileHandleCachePtr->file.get());
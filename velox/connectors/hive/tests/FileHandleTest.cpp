@@ -37,7 +37,7 @@ TEST(FileHandleTest, localFile) {
   }
 
   FileHandleFactory factory(
-      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1000),
+      std::make_unique<FileHandleCache>(1000),
       std::make_unique<FileHandleGenerator>());
   auto fileHandle = factory.generate(filename);
   ASSERT_EQ(fileHandle->file->size(), 3);
@@ -61,7 +61,7 @@ TEST(FileHandleTest, localFileWithProperties) {
   }
 
   FileHandleFactory factory(
-      std::make_unique<SimpleLRUCache<std::string, FileHandle>>(1000),
+      std::make_unique<FileHandleCache>(1000),
       std::make_unique<FileHandleGenerator>());
   FileProperties properties = {
       .fileSize = tempFile->fileSize(),
@@ -74,3 +74,39 @@ TEST(FileHandleTest, localFileWithProperties) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, rewrittenFile) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  remove(filename.c_str());
+
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+
+  FileHandleFactory factory(
+      std::make_unique<FileHandleCache>(1000),
+      std::make_unique<FileHandleGenerator>());
+  auto fileHandle = factory.generate(FileHandleKey(filename, 1));
+  ASSERT_EQ(fileHandle->file->size(), 3);
+  ASSERT_TRUE(factory.generate(FileHandleKey(filename, 1)).fromCache());
+
+  // Rewrite the file at the same path. The handle cached for the previous
+  // version is not returned for the new modification time.
+  remove(filename.c_str());
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foobar");
+  }
+  auto newFileHandle = factory.generate(FileHandleKey(filename, 2));
+  ASSERT_FALSE(newFileHandle.fromCache());
+  ASSERT_EQ(newFileHandle->file->size(), 6);
+  ASSERT_NE(newFileHandle->uuid.id(), fileHandle->uuid.id());
+  ASSERT_EQ(fileHandle->file->size(), 3);
+
+  // Clean up
+  remove(filename.c_str());
+}
@@ -170,6 +170,13 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// The fraction of free memory in the variable width storage of a hash
+  /// aggregation above which the storage is compacted by moving the
+  /// accumulators into new memory. The value is in the range of [0, 1]. 0
+  /// disables the compaction.
+  static constexpr const char* kAggregationCompactionFreeRatio =
+      "aggregation_compaction_free_ratio";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -244,6 +251,20 @@ class QueryConfig {
   static constexpr const char* kMixedGroupedModeHashJoinSpillEnabled =
       "mixed_grouped_mode_hash_join_spill_enabled";
 
+  /// If true and the hash build side has spilled, the last hash build operator
+  /// reloads as many spilled partitions into the join table as the memory
+  /// arbitrator allows before handing it over to the probe side. Only the probe
+  /// rows of the partitions that stay on disk are spilled.
+  static constexpr const char* kJoinHybridSpillEnabled =
+      "join_hybrid_spill_enabled";
+
+  /// The estimated ratio of the memory needed to hold a reloaded spill
+  /// partition in the join table to its spilled file size. It accounts for the
+  /// row container overhead and the hash table built on top of it. Only applies
+  /// if "join_hybrid_spill_enabled" is set.
+  static constexpr const char* kJoinHybridSpillReloadMemoryRatio =
+      "join_hybrid_spill_reload_memory_ratio";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -315,6 +336,22 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// If true, the spill files are written asynchronously on the spill executor
+  /// so that the serialization of the next write buffer overlaps with the
+  /// write of the previous one, and the spill readers read and deserialize the
+  /// next batch of each spill file ahead on the spill executor. This holds up
+  /// to two serialized write buffers per spill writer and two deserialized
+  /// batches per spill reader in memory. It has no effect if the query has no
+  /// spill executor.
+  static constexpr const char* kSpillAsyncIoEnabled = "spill_async_io_enabled";
+
+  /// If true, the hash join build spills its table rows in the RowContainer's
+  /// serialized row layout, and restores them by copying each row back into
+  /// the new RowContainer instead of decoding the spilled columns and storing
+  /// them again.
+  static constexpr const char* kSpillRowFormatEnabled =
+      "spill_row_format_enabled";
+
   /// Default offset spill start partition bit. It is used with
   /// 'kJoinSpillPartitionBits' or 'kAggregationSpillPartitionBits' together to
   /// calculate the spilling partition number for join spill or aggregation
@@ -396,6 +433,13 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// If true, the hash probe emits the projected build side columns as lazy
+  /// vectors backed by the matched table rows. The values are only copied out
+  /// of the table for the rows which are accessed by the downstream
+  /// operators, e.g. the ones that pass a downstream filter.
+  static constexpr const char* kHashProbeLazyBuildColumnsEnabled =
+      "hash_probe_lazy_build_columns_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
@@ -448,6 +492,15 @@ class QueryConfig {
   static constexpr const char* kPrefixSortMaxStringPrefixLength =
       "prefixsort_max_string_prefix_length";
 
+  /// Minimum number of rows buffered by an OrderBy operator to sort them in
+  /// parallel on the query executor. The rows are sorted as multiple runs which
+  /// are then merged by key ranges in parallel. Use 0 to disable parallel sort.
+  static constexpr const char* kParallelSortMinRows = "parallel_sort_min_rows";
+
+  /// The number of sorted runs and merged key ranges used by parallel sort.
+  static constexpr const char* kParallelSortParallelism =
+      "parallel_sort_parallelism";
+
   /// Enable query tracing flag.
   static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
 
@@ -656,6 +709,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  double aggregationCompactionFreeRatio() const {
+    return get<double>(kAggregationCompactionFreeRatio, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -819,6 +876,14 @@ class QueryConfig {
     return get<bool>(kMixedGroupedModeHashJoinSpillEnabled, false);
   }
 
+  bool joinHybridSpillEnabled() const {
+    return get<bool>(kJoinHybridSpillEnabled, false);
+  }
+
+  double joinHybridSpillReloadMemoryRatio() const {
+    return get<double>(kJoinHybridSpillReloadMemoryRatio, 2.0);
+  }
+
   bool orderBySpillEnabled() const {
     return get<bool>(kOrderBySpillEnabled, true);
   }
@@ -886,6 +951,14 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  bool spillAsyncIoEnabled() const {
+    return get<bool>(kSpillAsyncIoEnabled, false);
+  }
+
+  bool spillRowFormatEnabled() const {
+    return get<bool>(kSpillRowFormatEnabled, false);
+  }
+
   int32_t minSpillableReservationPct() const {
     constexpr int32_t kDefaultPct = 5;
     return get<int32_t>(kMinSpillableReservationPct, kDefaultPct);
@@ -987,6 +1060,10 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, false);
   }
 
+  bool hashProbeLazyBuildColumnsEnabled() const {
+    return get<bool>(kHashProbeLazyBuildColumnsEnabled, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
@@ -1035,6 +1112,14 @@ class QueryConfig {
     return get<uint32_t>(kPrefixSortMaxStringPrefixLength, 16);
   }
 
+  uint64_t parallelSortMinRows() const {
+    return get<uint64_t>(kParallelSortMinRows, 0);
+  }
+
+  uint32_t parallelSortParallelism() const {
+    return get<uint32_t>(kParallelSortParallelism, 8);
+  }
+
   double scaleWriterRebalanceMaxMemoryUsageRatio() const {
     return get<double>(kScaleWriterRebalanceMaxMemoryUsageRatio, 0.7);
   }
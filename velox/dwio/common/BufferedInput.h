@@ -149,6 +149,14 @@ class BufferedInput {
     return nullptr;
   }
 
+  /// Returns the id of the file in fileIds(), e.g. the uuid of its FileHandle,
+  /// or std::nullopt if the file has no such id. A file rewritten at the same
+  /// path gets a new id if its modification time is known, so data derived
+  /// from the file may be shared across readers under this id.
+  virtual std::optional<uint64_t> fileNum() const {
+    return std::nullopt;
+  }
+
   virtual uint64_t nextFetchSize() const;
 
  protected:
@@ -21,6 +21,8 @@
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 
+DECLARE_int32(cache_prefetch_min_pct);
+
 using ::facebook::velox::common::Region;
 
 namespace facebook::velox::dwio::common {
@@ -242,6 +244,11 @@ void CacheInputStream::loadSync(const Region& region) {
     // missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
     entry->setTrackingId(trackingId_);
+    // A stream that the scan references but seldom reads is not expected to
+    // be reused. The cache keeps it in probation if the policy has segments.
+    entry->setLowReuse(
+        tracker_ != nullptr &&
+        !tracker_->shouldPrefetch(trackingId_, FLAGS_cache_prefetch_min_pct));
     if (loadFromSsd(region, *entry)) {
       return;
     }
@@ -282,11 +289,11 @@ bool CacheInputStream::loadFromSsd(
     return false;
   }
 
-  if (ssdPin.run().size() < entry.size()) {
+  if (ssdPin.run().uncompressedSize() < entry.size()) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
-        ssdPin.run().size());
+        ssdPin.run().uncompressedSize());
     return false;
   }
 
@@ -171,6 +171,10 @@ class CachedBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
   uint64_t nextFetchSize() const override {
     VELOX_NYI();
   }
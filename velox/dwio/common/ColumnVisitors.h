@@ -1363,6 +1363,29 @@ class StringDictionaryColumnVisitor
       int32_t* filterHits,
       int32_t* values,
       int32_t& numValues) {
+    if constexpr (DictSuper::hasFilter() && TFilter::deterministic) {
+      if (delta == 0 && !DictSuper::inDict()) {
+        // All rows of the run have the same dictionary index. Test it once and
+        // take or drop the run as a whole.
+        auto& cached = DictSuper::filterCache()[value];
+        if (cached == FilterResult::kUnknown) {
+          cached = applyFilter(super::filter_, valueInDictionary(value))
+              ? FilterResult::kSuccess
+              : FilterResult::kFailure;
+        }
+        if (cached == FilterResult::kSuccess) {
+          auto* begin =
+              (scatter ? scatterRows : super::rows_) + super::rowIndex_;
+          std::copy(begin, begin + numRows, filterHits + numValues);
+          if constexpr (!std::is_same_v<typename super::Extract, DropValues>) {
+            std::fill(values + numValues, values + numValues + numRows, value);
+          }
+          numValues += numRows;
+        }
+        super::rowIndex_ += numRows;
+        return;
+      }
+    }
     constexpr int32_t kWidth = xsimd::batch<int32_t>::size;
     for (auto i = 0; i < numRows; i += kWidth) {
       ((xsimd::load_unaligned(super::rows_ + super::rowIndex_ + i) -
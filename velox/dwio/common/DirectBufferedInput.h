@@ -200,6 +200,10 @@ class DirectBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
   uint64_t nextFetchSize() const override {
     VELOX_NYI();
   }
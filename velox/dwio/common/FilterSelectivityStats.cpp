@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FilterSelectivityStats.h"
+
+namespace facebook::velox::common {
+
+namespace {
+folly::Synchronized<
+    folly::F14FastMap<std::string, std::weak_ptr<FilterSelectivityStats>>>&
+registry() {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::weak_ptr<FilterSelectivityStats>>>
+      stats;
+  return stats;
+}
+} // namespace
+
+// static
+std::shared_ptr<FilterSelectivityStats> FilterSelectivityStats::getOrCreate(
+    const std::string& scanId) {
+  return registry().withWLock([&](auto& registry) {
+    auto& entry = registry[scanId];
+    auto stats = entry.lock();
+    if (!stats) {
+      stats.reset(new FilterSelectivityStats(scanId));
+      entry = stats;
+    }
+    return stats;
+  });
+}
+
+FilterSelectivityStats::~FilterSelectivityStats() {
+  registry().withWLock([&](auto& registry) {
+    auto it = registry.find(scanId_);
+    // A new instance may already be registered if the last reference to this
+    // one was dropped concurrently with getOrCreate().
+    if (it != registry.end() && it->second.expired()) {
+      registry.erase(it);
+    }
+  });
+}
+
+SelectivityInfo FilterSelectivityStats::add(
+    const std::string& path,
+    const SelectivityInfo& delta) {
+  return selectivity_.withWLock([&](auto& selectivity) {
+    auto& total = selectivity[path];
+    total += delta;
+    return total;
+  });
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SelectivityInfo.h"
+
+namespace facebook::velox::common {
+
+/// Filter selectivity of the columns of one scan, shared by the ScanSpecs of
+/// all drivers of the scan. Each driver reads different splits, so a scan of
+/// many small splits learns its filter order from the rows of all of them
+/// rather than from the few batches of the current split. The measured time
+/// covers reading and decoding the column as well as evaluating the filter.
+class FilterSelectivityStats {
+ public:
+  /// Returns the stats for 'scanId', creating them if no ScanSpec of the scan
+  /// currently holds them. See ConnectorQueryCtx::scanId().
+  static std::shared_ptr<FilterSelectivityStats> getOrCreate(
+      const std::string& scanId);
+
+  ~FilterSelectivityStats();
+
+  const std::string& scanId() const {
+    return scanId_;
+  }
+
+  /// Adds 'delta' to the selectivity of the filter on the field at 'path' and
+  /// returns the total over all drivers.
+  SelectivityInfo add(const std::string& path, const SelectivityInfo& delta);
+
+ private:
+  explicit FilterSelectivityStats(std::string scanId)
+      : scanId_(std::move(scanId)) {}
+
+  const std::string scanId_;
+  folly::Synchronized<folly::F14FastMap<std::string, SelectivityInfo>>
+      selectivity_;
+};
+
+} // namespace facebook::velox::common
@@ -449,6 +449,8 @@ class ReaderOptions : public io::ReaderOptions {
   static constexpr uint64_t kDefaultFooterEstimatedSize = 1024 * 1024; // 1MB
   static constexpr uint64_t kDefaultFilePreloadThreshold =
       1024 * 1024 * 8; // 8MB
+  static constexpr uint64_t kDefaultReadAheadBytes =
+      1024 * 1024 * 8; // 8MB
 
   explicit ReaderOptions(velox::memory::MemoryPool* pool)
       : io::ReaderOptions(pool),
@@ -526,6 +528,36 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Enables skipping of the pages whose min/max and null counts in the page
+  /// index (Parquet ColumnIndex and OffsetIndex) show that no row can pass the
+  /// filters. Only the surviving pages are read.
+  ReaderOptions& setPageIndexFilterEnabled(bool enabled) {
+    pageIndexFilterEnabled_ = enabled;
+    return *this;
+  }
+
+  /// Enables skipping of the row groups whose Bloom filters show that no value
+  /// of an equality or IN filter is present.
+  ReaderOptions& setBloomFilterEnabled(bool enabled) {
+    bloomFilterEnabled_ = enabled;
+    return *this;
+  }
+
+  /// Sets the maximum number of data pages of a column chunk that are
+  /// decompressed ahead of the page being decoded, on the decoding executor
+  /// of the row reader. 0 disables read-ahead.
+  ReaderOptions& setReadAheadPages(int32_t pages) {
+    readAheadPages_ = pages;
+    return *this;
+  }
+
+  /// Sets the maximum compressed plus decompressed size of the pages read ahead
+  /// per column.
+  ReaderOptions& setReadAheadBytes(uint64_t bytes) {
+    readAheadBytes_ = bytes;
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -573,6 +605,22 @@ class ReaderOptions : public io::ReaderOptions {
     return adjustTimestampToTimezone_;
   }
 
+  bool pageIndexFilterEnabled() const {
+    return pageIndexFilterEnabled_;
+  }
+
+  bool bloomFilterEnabled() const {
+    return bloomFilterEnabled_;
+  }
+
+  int32_t readAheadPages() const {
+    return readAheadPages_;
+  }
+
+  uint64_t readAheadBytes() const {
+    return readAheadBytes_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -636,6 +684,10 @@ class ReaderOptions : public io::ReaderOptions {
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
   const tz::TimeZone* sessionTimezone_{nullptr};
   bool adjustTimestampToTimezone_{false};
+  bool pageIndexFilterEnabled_{false};
+  bool bloomFilterEnabled_{false};
+  int32_t readAheadPages_{0};
+  uint64_t readAheadBytes_{kDefaultReadAheadBytes};
   bool selectiveNimbleReaderEnabled_{false};
   bool allowEmptyFile_{false};
 };
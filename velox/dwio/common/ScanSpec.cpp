@@ -48,10 +48,12 @@ bool ScanSpec::compareTimeToDropValue(
     const std::shared_ptr<ScanSpec>& left,
     const std::shared_ptr<ScanSpec>& right) {
   if (left->hasFilter() && right->hasFilter()) {
+    const auto& leftSelectivity = left->orderingSelectivity();
+    const auto& rightSelectivity = right->orderingSelectivity();
     if (!disableStatsBasedFilterReorder_ &&
-        (left->selectivity_.numIn() || right->selectivity_.numIn())) {
-      return left->selectivity_.timeToDropValue() <
-          right->selectivity_.timeToDropValue();
+        (leftSelectivity.numIn() || rightSelectivity.numIn())) {
+      return leftSelectivity.timeToDropValue() <
+          rightSelectivity.timeToDropValue();
     }
     // Integer filters are before other filters if there is no
     // history data.
@@ -86,6 +88,9 @@ uint64_t ScanSpec::newRead() {
   // non-empty filter stats. Hence we need to avoid stats triggered filter
   // reordering even on the first read if 'disableStatsBasedFilterReorder_' is
   // set.
+  if (filterSelectivityStats_ && !disableStatsBasedFilterReorder_) {
+    publishSelectivity();
+  }
   if (numReads_ == 0 ||
       (!disableStatsBasedFilterReorder_ &&
        !std::is_sorted(
@@ -117,6 +122,33 @@ void ScanSpec::reorder() {
       });
 }
 
+void ScanSpec::setFilterSelectivityStats(
+    std::shared_ptr<FilterSelectivityStats> stats) {
+  for (auto& child : children_) {
+    child->selectivityPath_ = selectivityPath_.empty()
+        ? child->fieldName_
+        : fmt::format("{}.{}", selectivityPath_, child->fieldName_);
+    child->setFilterSelectivityStats(stats);
+  }
+  filterSelectivityStats_ = std::move(stats);
+}
+
+void ScanSpec::publishSelectivity() {
+  for (auto& child : children_) {
+    if (!child->filterSelectivityStats_ || !child->hasFilter()) {
+      continue;
+    }
+    child->sharedSelectivity_ = child->filterSelectivityStats_->add(
+        child->selectivityPath_,
+        child->selectivity_ - child->publishedSelectivity_);
+    child->publishedSelectivity_ = child->selectivity_;
+  }
+}
+
+const SelectivityInfo& ScanSpec::orderingSelectivity() const {
+  return sharedSelectivity_.numIn() > 0 ? sharedSelectivity_ : selectivity_;
+}
+
 void ScanSpec::enableFilterInSubTree(bool value) {
   filterDisabled_ = !value;
   for (auto& child : children_) {
@@ -198,6 +230,8 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
       // received.
       child->filter_ = std::move(otherChild->filter_);
       child->selectivity_ = otherChild->selectivity_;
+      child->publishedSelectivity_ = otherChild->publishedSelectivity_;
+      child->sharedSelectivity_ = otherChild->sharedSelectivity_;
     }
   }
 }
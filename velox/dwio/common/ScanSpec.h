@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/dwio/common/FilterSelectivityStats.h"
 #include "velox/dwio/common/MetadataFilter.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/type/Filter.h"
@@ -382,9 +383,24 @@ class ScanSpec {
     return disableStatsBasedFilterReorder_;
   }
 
+  /// Shares the filter selectivity of 'this' and its descendants with the
+  /// other ScanSpecs of the same scan through 'stats'. Filters are then
+  /// ordered by the selectivity observed by all of them. Must be called after
+  /// the children are added.
+  void setFilterSelectivityStats(
+      std::shared_ptr<FilterSelectivityStats> stats);
+
  private:
   void reorder();
 
+  // Adds the selectivity observed by the children with filters since the last
+  // call to 'filterSelectivityStats_' and fetches the totals of the scan.
+  void publishSelectivity();
+
+  // Returns the selectivity that orders the filter of 'this' among its
+  // siblings.
+  const SelectivityInfo& orderingSelectivity() const;
+
   void enableFilterInSubTree(bool value);
 
   bool compareTimeToDropValue(
@@ -436,6 +452,15 @@ class ScanSpec {
 
   SelectivityInfo selectivity_;
 
+  // Set if the selectivity is shared with other ScanSpecs of the scan under
+  // the key 'selectivityPath_'. 'publishedSelectivity_' is the part of
+  // 'selectivity_' already added to the shared stats and
+  // 'sharedSelectivity_' is the total of the scan at the last publication.
+  std::shared_ptr<FilterSelectivityStats> filterSelectivityStats_;
+  std::string selectivityPath_;
+  SelectivityInfo publishedSelectivity_;
+  SelectivityInfo sharedSelectivity_;
+
   std::vector<std::shared_ptr<ScanSpec>> children_;
   // Read-only copy of children, not subject to reordering. Used when
   // asynchronously constructing reader trees for read-ahead, while
@@ -536,6 +536,13 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of Parquet data pages decompressed ahead of decoding on an
+  // executor.
+  int64_t readAheadPages{0};
+
+  // Time spent waiting for pages decompressed ahead of decoding.
+  int64_t readAheadWaitNanos{0};
 };
 
 struct RuntimeStatistics {
@@ -554,6 +561,9 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Number of rows skipped based on page level statistics.
+  int64_t skippedPageRows{0};
+
   int64_t footerBufferOverread{0};
 
   int64_t numStripes{0};
@@ -579,6 +589,9 @@ struct RuntimeStatistics {
     if (processedStrides > 0) {
       result.emplace("processedStrides", RuntimeCounter(processedStrides));
     }
+    if (skippedPageRows > 0) {
+      result.emplace("skippedPageRows", RuntimeCounter(skippedPageRows));
+    }
     if (footerBufferOverread > 0) {
       result.emplace(
           "footerBufferOverread",
@@ -592,6 +605,18 @@ struct RuntimeStatistics {
           "flattenStringDictionaryValues",
           RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues));
     }
+    if (columnReaderStatistics.readAheadPages > 0) {
+      result.emplace(
+          "readAheadPages",
+          RuntimeCounter(columnReaderStatistics.readAheadPages));
+    }
+    if (columnReaderStatistics.readAheadWaitNanos > 0) {
+      result.emplace(
+          "readAheadWaitNanos",
+          RuntimeCounter(
+              columnReaderStatistics.readAheadWaitNanos,
+              RuntimeCounter::Unit::kNanos));
+    }
     return result;
   }
 };
@@ -642,6 +642,38 @@ std::unique_ptr<Compressor> createCompressor(
   return nullptr;
 }
 
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind::CompressionKind_ZLIB:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, false);
+    case CompressionKind::CompressionKind_GZIP:
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
+    case CompressionKind::CompressionKind_SNAPPY:
+      return std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind::CompressionKind_LZO:
+      return std::make_unique<LzoDecompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_LZ4:
+      return std::make_unique<Lz4Decompressor>(
+          blockSize,
+          options.format.lz4_lzo.isHadoopFrameFormat,
+          streamDebugInfo);
+    case CompressionKind::CompressionKind_ZSTD:
+      return std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+    default:
+      DWIO_RAISE("Unknown compression codec ", kind);
+  }
+  return nullptr;
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     CompressionKind kind,
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -694,28 +726,9 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
       decompressor = std::make_unique<ZlibDecompressor>(
           blockSize, options.format.zlib.windowBits, streamDebugInfo, true);
       break;
-    case CompressionKind::CompressionKind_SNAPPY:
-      decompressor =
-          std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZO:
-      decompressor = std::make_unique<LzoDecompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_LZ4:
-      decompressor = std::make_unique<Lz4Decompressor>(
-          blockSize,
-          options.format.lz4_lzo.isHadoopFrameFormat,
-          streamDebugInfo);
-      break;
-    case CompressionKind::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
-      break;
     default:
-      DWIO_RAISE("Unknown compression codec ", kind);
+      decompressor =
+          createBlockDecompressor(kind, blockSize, options, streamDebugInfo);
   }
   return std::make_unique<PagedInputStream>(
       std::move(input),
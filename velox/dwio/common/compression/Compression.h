@@ -110,6 +110,19 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     bool useRawDecompression = false,
     size_t compressedLength = 0);
 
+/**
+ * Create a decompressor that decompresses a whole block from memory to memory.
+ * Unlike createDecompressor(), it does not allocate from a memory pool.
+ * @param kind The compression type to implement, other than NONE
+ * @param blockSize The maximum decompressed size of a block
+ * @param options The compression options to use
+ */
+std::unique_ptr<Decompressor> createBlockDecompressor(
+    facebook::velox::common::CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo);
+
 /**
  * Create a compressor for the given compression kind.
  * @param kind The compression type to implement
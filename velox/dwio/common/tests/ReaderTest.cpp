@@ -60,6 +60,56 @@ TEST_F(ReaderTest, getOrCreateChild) {
       "Field not found: c. Available fields are: c.0, c.1.");
 }
 
+TEST_F(ReaderTest, sharedFilterSelectivity) {
+  auto makeScanSpec = [] {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addField("c0", 0)->setFilter(
+        common::createBigintValues({1, 3}, false));
+    spec->addField("c1", 1)->setFilter(
+        common::createBigintValues({2, 4}, false));
+    spec->setFilterSelectivityStats(
+        common::FilterSelectivityStats::getOrCreate("task.0"));
+    return spec;
+  };
+  auto firstSpec = makeScanSpec();
+  auto secondSpec = makeScanSpec();
+  firstSpec->newRead();
+  secondSpec->newRead();
+  ASSERT_EQ(secondSpec->children()[0]->fieldName(), "c0");
+
+  // The first driver sees that 'c1' drops all rows quickly while 'c0' drops
+  // none. The second driver orders its filters by that. The time of 'c1' is
+  // within the time of 'c0', which also waits for the clock to advance, so
+  // 'c1' is cheaper per dropped row at any clock resolution.
+  {
+    auto& c0Selectivity = firstSpec->childByName("c0")->selectivity();
+    SelectivityTimer c0Timer(c0Selectivity, 100);
+    {
+      SelectivityTimer c1Timer(
+          firstSpec->childByName("c1")->selectivity(), 100);
+    }
+    const auto startClocks = folly::hardware_timestamp();
+    while (folly::hardware_timestamp() == startClocks) {
+    }
+    c0Selectivity.addOutput(100);
+  }
+  firstSpec->newRead();
+  secondSpec->newRead();
+  ASSERT_EQ(firstSpec->children()[0]->fieldName(), "c1");
+  ASSERT_EQ(secondSpec->children()[0]->fieldName(), "c1");
+
+  auto stats = common::FilterSelectivityStats::getOrCreate("task.0");
+  ASSERT_EQ(stats->add("c0", {}).numIn(), 100);
+  ASSERT_EQ(stats->add("c1", {}).numIn(), 100);
+
+  // The stats are dropped with the last ScanSpec of the scan.
+  firstSpec.reset();
+  secondSpec.reset();
+  stats.reset();
+  stats = common::FilterSelectivityStats::getOrCreate("task.0");
+  ASSERT_EQ(stats->add("c0", {}).numIn(), 0);
+}
+
 TEST_F(ReaderTest, projectColumnsFilterStruct) {
   constexpr int kSize = 10;
   auto input = makeRowVector({
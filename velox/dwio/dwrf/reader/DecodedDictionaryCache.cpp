@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::dwrf {
+
+namespace {
+DecodedDictionaryCache*& instance() {
+  static DecodedDictionaryCache* cache{nullptr};
+  return cache;
+}
+} // namespace
+
+size_t DecodedDictionaryKeyHash::operator()(
+    const DecodedDictionaryKey& key) const {
+  return folly::hash::hash_combine(
+      key.fileNum, key.fileSize, key.stripeOffset, key.encodingKey.hash());
+}
+
+DecodedDictionaryCache::DecodedDictionaryCache(
+    uint64_t maxBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : pool_(std::move(pool)), cache_(maxBytes) {
+  VELOX_CHECK_NOT_NULL(pool_);
+}
+
+// static
+DecodedDictionaryCache* DecodedDictionaryCache::getInstance() {
+  return instance();
+}
+
+// static
+void DecodedDictionaryCache::setInstance(DecodedDictionaryCache* cache) {
+  instance() = cache;
+}
+
+std::optional<dwio::common::DictionaryValues> DecodedDictionaryCache::find(
+    const DecodedDictionaryKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* values = cache_.get(key);
+  if (values == nullptr) {
+    return std::nullopt;
+  }
+  // The copy holds references to the buffers, so the entry need not stay
+  // pinned.
+  dwio::common::DictionaryValues result = *values;
+  cache_.release(key);
+  return result;
+}
+
+void DecodedDictionaryCache::insert(
+    const DecodedDictionaryKey& key,
+    const dwio::common::DictionaryValues& values) {
+  const auto size = (values.values ? values.values->capacity() : 0) +
+      (values.strings ? values.strings->capacity() : 0);
+  auto entry = std::make_unique<dwio::common::DictionaryValues>(values);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, entry.get(), size)) {
+    entry.release();
+  }
+}
+
+SimpleLRUCacheStats DecodedDictionaryCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+} // namespace facebook::velox::dwrf
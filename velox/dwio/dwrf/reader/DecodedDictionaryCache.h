@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/dwrf/common/Common.h"
+
+namespace facebook::velox::dwrf {
+
+/// Identifies the stripe dictionary of one column in one version of a file.
+struct DecodedDictionaryKey {
+  /// Id of the file version. See BufferedInput::fileNum().
+  uint64_t fileNum;
+  uint64_t fileSize;
+  /// File offset of the stripe.
+  uint64_t stripeOffset;
+  EncodingKey encodingKey;
+
+  bool operator==(const DecodedDictionaryKey& other) const {
+    return fileNum == other.fileNum && fileSize == other.fileSize &&
+        stripeOffset == other.stripeOffset &&
+        encodingKey == other.encodingKey;
+  }
+};
+
+struct DecodedDictionaryKeyHash {
+  size_t operator()(const DecodedDictionaryKey& key) const;
+};
+
+/// Process-wide cache of decoded string stripe dictionaries. Scans of the same
+/// stripe share the StringViews and the string bytes of the dictionary instead
+/// of each reading and decoding the dictionary streams. The cached buffers are
+/// allocated from the pool of the cache and stay valid while referenced by
+/// vectors after eviction, so the cache must outlive all readers using it.
+///
+/// Readers consult the cache only if one is installed with setInstance().
+class DecodedDictionaryCache {
+ public:
+  /// 'maxBytes' bounds the size of the values and strings of the cached
+  /// dictionaries. 'pool' is a leaf pool that the cached dictionaries are
+  /// allocated from.
+  DecodedDictionaryCache(
+      uint64_t maxBytes,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  static DecodedDictionaryCache* getInstance();
+
+  static void setInstance(DecodedDictionaryCache* cache);
+
+  /// Returns the dictionary for 'key' or std::nullopt if it is not cached.
+  std::optional<dwio::common::DictionaryValues> find(
+      const DecodedDictionaryKey& key);
+
+  /// Adds 'values' under 'key'. 'values' must be allocated from pool(). Does
+  /// nothing if 'key' is already cached or 'values' does not fit.
+  void insert(
+      const DecodedDictionaryKey& key,
+      const dwio::common::DictionaryValues& values);
+
+  memory::MemoryPool& pool() const {
+    return *pool_;
+  }
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  mutable std::mutex mutex_;
+  SimpleLRUCache<
+      DecodedDictionaryKey,
+      dwio::common::DictionaryValues,
+      std::equal_to<DecodedDictionaryKey>,
+      DecodedDictionaryKeyHash>
+      cache_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -50,27 +50,37 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dictVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  const auto lenId = StripeStreamsUtil::getStreamForKind(
-      stripe,
-      encodingKey,
-      proto::Stream_Kind_LENGTH,
-      proto::orc::Stream_Kind_LENGTH);
-  bool lenVInts = stripe.getUseVInts(lenId);
-  lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
-      stripe.getStream(lenId, params.streamLabels().label(), false),
-      version_,
-      *memoryPool_,
-      lenVInts,
-      dwio::common::INT_BYTE_SIZE);
+  // A stripe dictionary decoded by an earlier scan of the stripe is reused,
+  // and its streams are then not read.
+  dictionaryKey_ = stripe.decodedDictionaryKey(encodingKey);
+  if (dictionaryKey_.has_value()) {
+    dictionaryCache_ = DecodedDictionaryCache::getInstance();
+    cachedDictionary_ = dictionaryCache_->find(dictionaryKey_.value());
+  }
 
-  blobStream_ = stripe.getStream(
-      StripeStreamsUtil::getStreamForKind(
-          stripe,
-          encodingKey,
-          proto::Stream_Kind_DICTIONARY_DATA,
-          proto::orc::Stream_Kind_DICTIONARY_DATA),
-      params.streamLabels().label(),
-      false);
+  if (!cachedDictionary_.has_value()) {
+    const auto lenId = StripeStreamsUtil::getStreamForKind(
+        stripe,
+        encodingKey,
+        proto::Stream_Kind_LENGTH,
+        proto::orc::Stream_Kind_LENGTH);
+    bool lenVInts = stripe.getUseVInts(lenId);
+    lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
+        stripe.getStream(lenId, params.streamLabels().label(), false),
+        version_,
+        *memoryPool_,
+        lenVInts,
+        dwio::common::INT_BYTE_SIZE);
+
+    blobStream_ = stripe.getStream(
+        StripeStreamsUtil::getStreamForKind(
+            stripe,
+            encodingKey,
+            proto::Stream_Kind_DICTIONARY_DATA,
+            proto::orc::Stream_Kind_DICTIONARY_DATA),
+        params.streamLabels().label(),
+        false);
+  }
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
@@ -115,10 +125,11 @@ uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
 void SelectiveStringDictionaryColumnReader::loadDictionary(
     SeekableInputStream& data,
     IntDecoder</*isSigned*/ false>& lengthDecoder,
-    DictionaryValues& values) {
+    DictionaryValues& values,
+    memory::MemoryPool* pool) {
   // read lengths from length reader
   dwio::common::ensureCapacity<StringView>(
-      values.values, values.numValues, memoryPool_);
+      values.values, values.numValues, pool);
   // The lengths are read in the low addresses of the string views array.
   auto* lengths = values.values->asMutable<int32_t>();
   lengthDecoder.nextLengths(lengths, values.numValues);
@@ -127,7 +138,7 @@ void SelectiveStringDictionaryColumnReader::loadDictionary(
     stringsBytes += lengths[i];
   }
   // read bytes from underlying string
-  values.strings = AlignedBuffer::allocate<char>(stringsBytes, memoryPool_);
+  values.strings = AlignedBuffer::allocate<char>(stringsBytes, pool);
   data.readFully(values.strings->asMutable<char>(), stringsBytes);
   // fill the values with StringViews over the strings. 'strings' will
   // exist even if 'stringsBytes' is 0, which can happen if the only
@@ -162,7 +173,10 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
     strideDictLengthDecoder_->seekToRowGroup(pp);
 
     loadDictionary(
-        *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
+        *strideDictStream_,
+        *strideDictLengthDecoder_,
+        scanState_.dictionary2,
+        memoryPool_);
   }
   lastStrideIndex_ = nextStride;
   dictionaryValues_ = nullptr;
@@ -318,7 +332,22 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   ClockTimer timer{initTimeClocks_};
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  if (cachedDictionary_.has_value()) {
+    VELOX_CHECK_EQ(
+        cachedDictionary_->numValues, scanState_.dictionary.numValues);
+    scanState_.dictionary = std::move(cachedDictionary_.value());
+    cachedDictionary_.reset();
+  } else if (dictionaryCache_ != nullptr) {
+    loadDictionary(
+        *blobStream_,
+        *lengthDecoder_,
+        scanState_.dictionary,
+        &dictionaryCache_->pool());
+    dictionaryCache_->insert(dictionaryKey_.value(), scanState_.dictionary);
+  } else {
+    loadDictionary(
+        *blobStream_, *lengthDecoder_, scanState_.dictionary, memoryPool_);
+  }
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
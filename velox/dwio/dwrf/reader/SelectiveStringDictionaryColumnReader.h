@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 namespace facebook::velox::dwrf {
@@ -73,11 +74,12 @@ class SelectiveStringDictionaryColumnReader
   void readWithVisitor(TVisitor visitor);
 
   // Fills 'values' from 'data' and 'lengthDecoder'. The count of
-  // values is in 'values.numValues'.
+  // values is in 'values.numValues'. The buffers are allocated from 'pool'.
   void loadDictionary(
       dwio::common::SeekableInputStream& data,
       dwio::common::IntDecoder</*isSigned*/ false>& lengthDecoder,
-      dwio::common::DictionaryValues& values);
+      dwio::common::DictionaryValues& values,
+      memory::MemoryPool* pool);
   void ensureInitialized();
 
   void makeFlat(VectorPtr* result);
@@ -103,6 +105,12 @@ class SelectiveStringDictionaryColumnReader
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
   bool initialized_{false};
   int64_t numRowsScanned_;
+
+  // Set if the stripe dictionary is shared through the DecodedDictionaryCache.
+  // 'cachedDictionary_' is the dictionary found in the cache, if any.
+  std::optional<DecodedDictionaryKey> dictionaryKey_;
+  DecodedDictionaryCache* dictionaryCache_{nullptr};
+  std::optional<dwio::common::DictionaryValues> cachedDictionary_;
 };
 
 template <typename TVisitor>
@@ -371,6 +371,23 @@ bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
   return info.getUseVInts();
 }
 
+std::optional<DecodedDictionaryKey> StripeStreamsImpl::decodedDictionaryKey(
+    const EncodingKey& ek) const {
+  if (DecodedDictionaryCache::getInstance() == nullptr) {
+    return std::nullopt;
+  }
+  // The file name does not identify the file contents, e.g. a file can be
+  // rewritten at the same path and in memory files have no name. Only files
+  // with a versioned id are cached.
+  const auto& input = readState_->readerBase->bufferedInput();
+  const auto fileNum = input.fileNum();
+  if (!fileNum.has_value() || input.getReadFile() == nullptr) {
+    return std::nullopt;
+  }
+  return DecodedDictionaryKey{
+      fileNum.value(), input.getReadFile()->size(), stripeStart_, ek};
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream>
 StripeStreamsImpl::getIndexStreamFromCache(
     const StreamInformation& info) const {
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/StripeReaderBase.h"
@@ -149,6 +150,14 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Returns the key of the stripe dictionary of 'ek' in the process-wide
+  /// DecodedDictionaryCache, or std::nullopt if decoded dictionaries of this
+  /// stripe are not cached.
+  virtual std::optional<DecodedDictionaryKey> decodedDictionaryKey(
+      const EncodingKey& /*ek*/) const {
+    return std::nullopt;
+  }
+
   /// visit all streams of given node and execute visitor logic
   /// return number of streams visited
   virtual uint32_t visitStreamsOfNode(
@@ -338,6 +347,9 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->footer().rowIndexStride();
   }
 
+  std::optional<DecodedDictionaryKey> decodedDictionaryKey(
+      const EncodingKey& ek) const override;
+
  private:
   const StreamInformation& getStreamInfo(
       const DwrfStreamIdentifier& si,
@@ -17,6 +17,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
+#include "folly/ScopeGuard.h"
 #include "folly/executors/CPUThreadPoolExecutor.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -24,6 +25,7 @@
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/dwio/dwrf/common/Common.h"
+#include "velox/dwio/dwrf/reader/DecodedDictionaryCache.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 #include "velox/dwio/dwrf/test/utils/E2EWriterTestUtil.h"
@@ -2077,6 +2079,24 @@ void verifyRowNumbers(
   ASSERT_EQ(numRows, expectedNumRows);
 }
 
+// BufferedInput with a file id like the ones for the files opened through a
+// FileHandle.
+class FileNumBufferedInput : public BufferedInput {
+ public:
+  FileNumBufferedInput(
+      std::shared_ptr<ReadFile> readFile,
+      memory::MemoryPool& pool,
+      uint64_t fileNum)
+      : BufferedInput(std::move(readFile), pool), fileNum_(fileNum) {}
+
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
+ private:
+  const uint64_t fileNum_;
+};
+
 std::pair<std::unique_ptr<dwrf::Writer>, std::unique_ptr<DwrfReader>>
 createWriterReader(
     const std::vector<VectorPtr>& batches,
@@ -2084,7 +2104,8 @@ createWriterReader(
     const std::shared_ptr<dwrf::Config>& config =
         std::make_shared<dwrf::Config>(),
     std::function<std::unique_ptr<DWRFFlushPolicy>()> flushPolicy =
-        E2EWriterTestUtil::simpleFlushPolicyFactory(true)) {
+        E2EWriterTestUtil::simpleFlushPolicyFactory(true),
+    std::optional<uint64_t> fileNum = std::nullopt) {
   auto sink =
       std::make_unique<MemorySink>(1 << 20, FileSink::Options{.pool = pool});
   auto* sinkPtr = sink.get();
@@ -2095,8 +2116,14 @@ createWriterReader(
       config,
       std::move(flushPolicy));
   std::string data(sinkPtr->data(), sinkPtr->size());
-  auto input = std::make_unique<BufferedInput>(
-      std::make_shared<InMemoryReadFile>(std::move(data)), *pool);
+  auto readFile = std::make_shared<InMemoryReadFile>(std::move(data));
+  std::unique_ptr<BufferedInput> input;
+  if (fileNum.has_value()) {
+    input = std::make_unique<FileNumBufferedInput>(
+        std::move(readFile), *pool, fileNum.value());
+  } else {
+    input = std::make_unique<BufferedInput>(std::move(readFile), *pool);
+  }
   dwio::common::ReaderOptions readerOpts(pool);
   readerOpts.setFileFormat(FileFormat::DWRF);
   auto reader = DwrfReader::create(std::move(input), readerOpts);
@@ -2523,6 +2550,79 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, decodedDictionaryCache) {
+  DecodedDictionaryCache cache(
+      1 << 20, memory::memoryManager()->addLeafPool("decodedDictionaryCache"));
+  DecodedDictionaryCache::setInstance(&cache);
+  SCOPE_EXIT {
+    DecodedDictionaryCache::setInstance(nullptr);
+  };
+
+  std::vector<std::string> dictionary;
+  for (int i = 0; i < 26; ++i) {
+    dictionary.emplace_back(20 + i, 'a' + i);
+  }
+  auto indices = allocateIndices(200, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (int i = 0; i < 200; ++i) {
+    rawIndices[i] = i % dictionary.size();
+  }
+  auto batch = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr, indices, 200, makeFlatVector(dictionary)),
+  });
+  auto rowType = asRowType(batch->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto scan = [&](std::optional<uint64_t> fileNum) {
+    auto [writer, reader] = createWriterReader(
+        {batch},
+        pool(),
+        std::make_shared<dwrf::Config>(),
+        E2EWriterTestUtil::simpleFlushPolicyFactory(false),
+        fileNum);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto actual = BaseVector::create(rowType, 0, pool());
+    EXPECT_EQ(rowReader->next(200, actual), 200);
+    assertEqualVectors(batch, actual);
+    return actual;
+  };
+
+  // A file without an id is not cached as its name does not identify its
+  // contents.
+  scan(std::nullopt);
+  scan(std::nullopt);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numElements, 0);
+  ASSERT_EQ(stats.numLookups, 0);
+
+  std::vector<VectorPtr> results;
+  for (int i = 0; i < 2; ++i) {
+    results.push_back(scan(1));
+  }
+  stats = cache.stats();
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_EQ(stats.numLookups, 2);
+  ASSERT_EQ(stats.numHits, 1);
+
+  // The second scan uses the strings decoded by the first one.
+  auto dictionaryValues = [](const VectorPtr& result) {
+    auto* c0 = result->as<RowVector>()->childAt(0)->loadedVector();
+    EXPECT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+    return c0->valueVector()->asFlatVector<StringView>()->rawValues();
+  };
+  ASSERT_EQ(dictionaryValues(results[0]), dictionaryValues(results[1]));
+
+  // Another version of the file does not hit the dictionary of the first.
+  auto other = scan(2);
+  stats = cache.stats();
+  ASSERT_EQ(stats.numElements, 2);
+  ASSERT_EQ(stats.numHits, 1);
+  ASSERT_NE(dictionaryValues(other), dictionaryValues(results[0]));
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
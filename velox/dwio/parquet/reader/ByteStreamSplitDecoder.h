@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/memory/RawVector.h"
+#include "velox/dwio/common/DecoderUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/arrow/util/ByteStreamSplitInternal.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for BYTE_STREAM_SPLIT encoded FLOAT, DOUBLE, INT32 and INT64
+/// pages. The page holds one stream per byte of the value type, the k-th
+/// stream has the k-th byte of every value. Values are transposed back a
+/// block at a time with the SIMD kernels shared with the writer. Skipping
+/// only moves the position since the values have a fixed width.
+class ByteStreamSplitDecoder {
+ public:
+  ByteStreamSplitDecoder(
+      const char* start,
+      const char* end,
+      thrift::Type::type physicalType)
+      : data_(reinterpret_cast<const uint8_t*>(start)),
+        physicalType_(physicalType),
+        byteWidth_(
+            physicalType == thrift::Type::DOUBLE ||
+                    physicalType == thrift::Type::INT64
+                ? 8
+                : 4),
+        numValues_((end - start) / byteWidth_) {
+    VELOX_CHECK_EQ(
+        (end - start) % byteWidth_,
+        0,
+        "BYTE_STREAM_SPLIT page size is not a multiple of the value width");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(
+        position_ + numValues,
+        numValues_,
+        "Skipping past the end of a BYTE_STREAM_SPLIT page");
+    position_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    if constexpr (!hasNulls) {
+      if (isFastPathType<typename Visitor::DataType>() &&
+          dwio::common::useFastPath<Visitor, false>(visitor)) {
+        fastPath(visitor);
+        return;
+      }
+    }
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(
+            readValue<typename Visitor::DataType>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  // Number of values transposed at a time for value by value access.
+  static constexpr int32_t kBlockSize = 128;
+
+  // True if values of type T can be decoded directly into the result.
+  template <typename T>
+  bool isFastPathType() const {
+    if constexpr (std::is_same_v<T, float>) {
+      return physicalType_ == thrift::Type::FLOAT;
+    } else if constexpr (std::is_same_v<T, double>) {
+      return physicalType_ == thrift::Type::DOUBLE;
+    } else {
+      return false;
+    }
+  }
+
+  // Transposes 'numValues' values starting at value 'begin' into 'out'.
+  void decode(int64_t begin, int64_t numValues, void* out) const {
+    if (byteWidth_ == 4) {
+      arrow::ByteStreamSplitDecode<uint32_t>(
+          data_ + begin, numValues, numValues_, static_cast<uint32_t*>(out));
+    } else {
+      arrow::ByteStreamSplitDecode<uint64_t>(
+          data_ + begin, numValues, numValues_, static_cast<uint64_t*>(out));
+    }
+  }
+
+  template <typename T>
+  T readValue() {
+    if (position_ < blockBegin_ || position_ >= blockEnd_) {
+      VELOX_CHECK_LT(
+          position_,
+          numValues_,
+          "Reading past the end of a BYTE_STREAM_SPLIT page");
+      blockBegin_ = position_;
+      blockEnd_ = std::min<int64_t>(position_ + kBlockSize, numValues_);
+      decode(blockBegin_, blockEnd_ - blockBegin_, block_);
+    }
+    const auto* value = block_ + (position_ - blockBegin_) * byteWidth_;
+    ++position_;
+    switch (physicalType_) {
+      case thrift::Type::FLOAT:
+        return static_cast<T>(loadAs<float>(value));
+      case thrift::Type::DOUBLE:
+        return static_cast<T>(loadAs<double>(value));
+      case thrift::Type::INT32:
+        return static_cast<T>(loadAs<int32_t>(value));
+      default:
+        return static_cast<T>(loadAs<int64_t>(value));
+    }
+  }
+
+  template <typename T>
+  static T loadAs(const uint8_t* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+  }
+
+  // Decodes the values for all rows of 'visitor' straight into the result
+  // and applies the filter to them in a batch.
+  template <typename Visitor>
+  void fastPath(Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool filterOnly =
+        std::is_same_v<typename Visitor::Extract, dwio::common::DropValues>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+
+    const auto* rows = visitor.rows();
+    const auto numRows = visitor.numRows();
+    const auto firstRow = rows[0];
+    const auto lastRow = rows[numRows - 1];
+    VELOX_CHECK_LE(
+        position_ + lastRow + 1,
+        numValues_,
+        "Reading past the end of a BYTE_STREAM_SPLIT page");
+    auto* values = visitor.rawValues(numRows);
+    if (lastRow - firstRow + 1 == numRows) {
+      decode(position_ + firstRow, numRows, values);
+    } else {
+      // Transpose the covered range and gather the values of the rows.
+      scratch_.resize((lastRow - firstRow + 1) * sizeof(T));
+      auto* range = reinterpret_cast<T*>(scratch_.data());
+      decode(position_ + firstRow, lastRow - firstRow + 1, range);
+      for (auto i = 0; i < numRows; ++i) {
+        values[i] = range[rows[i] - firstRow];
+      }
+    }
+    position_ += lastRow + 1;
+
+    int32_t numValues = 0;
+    dwio::common::processFixedWidthRun<T, filterOnly, false, Visitor::dense>(
+        folly::Range<const int32_t*>(rows, numRows),
+        0,
+        numRows,
+        hasHook ? velox::iota(
+                      numRows,
+                      visitor.innerNonNullRows(),
+                      visitor.numValuesBias())
+                : nullptr,
+        values,
+        hasFilter ? visitor.outputRows(numRows) : nullptr,
+        numValues,
+        visitor.filter(),
+        visitor.hook());
+    visitor.setNumValues(hasFilter ? numValues : numRows);
+  }
+
+  const uint8_t* const data_;
+  const thrift::Type::type physicalType_;
+  const int32_t byteWidth_;
+  // Number of values in the page, which is also the size of each stream.
+  const int64_t numValues_;
+  // Index of the next value to read.
+  int64_t position_{0};
+  // Range of values transposed into 'block_'.
+  int64_t blockBegin_{0};
+  int64_t blockEnd_{0};
+  alignas(16) uint8_t block_[kBlockSize * sizeof(int64_t)];
+  raw_vector<char> scratch_;
+};
+
+} // namespace facebook::velox::parquet
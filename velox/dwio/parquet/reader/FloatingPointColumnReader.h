@@ -36,6 +36,12 @@ class FloatingPointColumnReader
       ParquetParams& params,
       common::ScanSpec& scanSpec);
 
+  bool hasBulkPath() const override {
+    // BYTE_STREAM_SPLIT has a fast path only for pages without nulls.
+    return base::hasBulkPath() &&
+        !this->formatData_->template as<ParquetData>().isByteStreamSplit();
+  }
+
   void seekToRowGroup(int64_t index) override {
     base::seekToRowGroup(index);
     this->scanState().clear();
@@ -256,6 +256,57 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasColumnIndex() const {
+  auto chunk = thriftColumnChunkPtr(ptr_);
+  return chunk->__isset.column_index_offset &&
+      chunk->__isset.column_index_length && chunk->column_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasColumnIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasOffsetIndex() const {
+  auto chunk = thriftColumnChunkPtr(ptr_);
+  return chunk->__isset.offset_index_offset &&
+      chunk->__isset.offset_index_length && chunk->offset_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasOffsetIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilter() const {
+  auto chunk = thriftColumnChunkPtr(ptr_);
+  return chunk->__isset.meta_data &&
+      chunk->meta_data.__isset.bloom_filter_offset &&
+      chunk->meta_data.bloom_filter_offset > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilter());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::bloomFilterLength() const {
+  VELOX_CHECK(hasBloomFilter());
+  const auto& metaData = thriftColumnChunkPtr(ptr_)->meta_data;
+  return metaData.__isset.bloom_filter_length ? metaData.bloom_filter_length
+                                              : 0;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
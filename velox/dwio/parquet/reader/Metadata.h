@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+} // namespace thrift
+
+/// Returns the ColumnStatistics of 'type' described by 'columnChunkStats' for
+/// 'numRowsInRowGroup' rows. Used for both column chunk and page statistics.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -74,6 +85,38 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the ColumnIndex of the chunk.
+  bool hasColumnIndex() const;
+
+  /// File offset of the ColumnIndex. Must check for its presence using
+  /// hasColumnIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the serialized ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// Check the presence of the OffsetIndex of the chunk.
+  bool hasOffsetIndex() const;
+
+  /// File offset of the OffsetIndex. Must check for its presence using
+  /// hasOffsetIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the serialized OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of a Bloom filter for the chunk.
+  bool hasBloomFilter() const;
+
+  /// File offset of the Bloom filter header. Must check for its presence
+  /// using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
+  /// Size of the Bloom filter header and bitset in bytes, or 0 if the writer
+  /// did not record it. The size is then only known from the header. Must
+  /// check for its presence using hasBloomFilter().
+  int32_t bloomFilterLength() const;
+
  private:
   const void* ptr_;
 };
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+T deserialize(const char* data, int32_t size) {
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+} // namespace
+
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    const auto begin = std::max(left[i].begin, right[j].begin);
+    const auto end = std::min(left[i].end, right[j].end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (left[i].end < right[j].end) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+int64_t numRowsInRanges(const RowRanges& ranges) {
+  int64_t numRows = 0;
+  for (const auto& range : ranges) {
+    numRows += range.end - range.begin;
+  }
+  return numRows;
+}
+
+// static
+std::unique_ptr<RowGroupPageIndex> RowGroupPageIndex::read(
+    const thrift::RowGroup& rowGroup,
+    const std::vector<uint32_t>& columns,
+    dwio::common::BufferedInput& input) {
+  auto pageIndex = std::make_unique<RowGroupPageIndex>();
+  int64_t begin = std::numeric_limits<int64_t>::max();
+  int64_t end = 0;
+  for (auto column : columns) {
+    VELOX_CHECK_LT(column, rowGroup.columns.size());
+    ColumnChunkMetaDataPtr chunk(&rowGroup.columns[column]);
+    if (chunk.hasColumnIndex()) {
+      begin = std::min(begin, chunk.columnIndexOffset());
+      end = std::max(
+          end, chunk.columnIndexOffset() + chunk.columnIndexLength());
+    }
+    if (chunk.hasOffsetIndex()) {
+      begin = std::min(begin, chunk.offsetIndexOffset());
+      end = std::max(
+          end, chunk.offsetIndexOffset() + chunk.offsetIndexLength());
+    }
+  }
+  if (end <= begin) {
+    return pageIndex;
+  }
+
+  // The indexes of all columns are usually adjacent, so they are read with
+  // one IO.
+  auto stream =
+      input.read(begin, end - begin, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> buffer(end - begin);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      end - begin, stream.get(), buffer.data(), bufferStart, bufferEnd);
+
+  for (auto column : columns) {
+    ColumnChunkMetaDataPtr chunk(&rowGroup.columns[column]);
+    if (chunk.hasColumnIndex()) {
+      pageIndex->columnIndexes_[column] = deserialize<thrift::ColumnIndex>(
+          buffer.data() + chunk.columnIndexOffset() - begin,
+          chunk.columnIndexLength());
+    }
+    if (chunk.hasOffsetIndex()) {
+      pageIndex->offsetIndexes_[column] = deserialize<thrift::OffsetIndex>(
+          buffer.data() + chunk.offsetIndexOffset() - begin,
+          chunk.offsetIndexLength());
+    }
+  }
+  return pageIndex;
+}
+
+const thrift::ColumnIndex* RowGroupPageIndex::columnIndex(
+    uint32_t column) const {
+  auto it = columnIndexes_.find(column);
+  return it == columnIndexes_.end() ? nullptr : &it->second;
+}
+
+const thrift::OffsetIndex* RowGroupPageIndex::offsetIndex(
+    uint32_t column) const {
+  auto it = offsetIndexes_.find(column);
+  return it == offsetIndexes_.end() ? nullptr : &it->second;
+}
+
+SparseChunkInputStream::SparseChunkInputStream(std::vector<Range> ranges)
+    : ranges_(std::move(ranges)) {
+  for (size_t i = 1; i < ranges_.size(); ++i) {
+    VELOX_CHECK_GE(
+        ranges_[i].offset, ranges_[i - 1].offset + ranges_[i - 1].length);
+  }
+}
+
+bool SparseChunkInputStream::Next(const void** data, int32_t* size) {
+  while (current_ < ranges_.size() &&
+         position_ >= ranges_[current_].offset + ranges_[current_].length) {
+    ++current_;
+  }
+  if (current_ == ranges_.size()) {
+    return false;
+  }
+  auto& range = ranges_[current_];
+  VELOX_CHECK_GE(
+      position_,
+      range.offset,
+      "Reading bytes of a column chunk that are not loaded");
+  if (!range.stream->Next(data, size)) {
+    return false;
+  }
+  position_ += *size;
+  return true;
+}
+
+void SparseChunkInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_LT(current_, ranges_.size());
+  ranges_[current_].stream->BackUp(count);
+  position_ -= count;
+}
+
+bool SparseChunkInputStream::SkipInt64(int64_t count) {
+  const auto target = position_ + count;
+  while (current_ < ranges_.size()) {
+    auto& range = ranges_[current_];
+    if (target < range.offset + range.length) {
+      if (target > range.offset) {
+        // The stream of 'range' is at 'position_' if 'position_' is inside
+        // 'range' and at the start of 'range' otherwise.
+        range.stream->SkipInt64(target - std::max(position_, range.offset));
+      }
+      break;
+    }
+    ++current_;
+  }
+  position_ = target;
+  return current_ < ranges_.size();
+}
+
+void SparseChunkInputStream::seekToPosition(
+    dwio::common::PositionProvider& /*position*/) {
+  VELOX_UNSUPPORTED("SparseChunkInputStream does not support seeking");
+}
+
+std::string SparseChunkInputStream::getName() const {
+  return fmt::format(
+      "SparseChunkInputStream {} ranges, position {}",
+      ranges_.size(),
+      position_);
+}
+
+} // namespace facebook::velox::parquet
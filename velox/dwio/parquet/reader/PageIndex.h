@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+namespace facebook::velox::dwio::common {
+class BufferedInput;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Range of rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Sorted, non-overlapping ranges of rows in a row group.
+using RowRanges = std::vector<RowRange>;
+
+/// Returns the rows that are in both 'left' and 'right'.
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right);
+
+/// Returns the number of rows in 'ranges'.
+int64_t numRowsInRanges(const RowRanges& ranges);
+
+/// The ColumnIndex and OffsetIndex of column chunks of a row group. These are
+/// stored outside of the row group, typically next to the footer.
+class RowGroupPageIndex {
+ public:
+  /// Reads the page indexes of 'columns' of 'rowGroup' from 'input' with a
+  /// single read covering all of them. Columns without a page index are left
+  /// out.
+  static std::unique_ptr<RowGroupPageIndex> read(
+      const thrift::RowGroup& rowGroup,
+      const std::vector<uint32_t>& columns,
+      dwio::common::BufferedInput& input);
+
+  /// Returns the ColumnIndex of 'column' or nullptr if not present.
+  const thrift::ColumnIndex* columnIndex(uint32_t column) const;
+
+  /// Returns the OffsetIndex of 'column' or nullptr if not present.
+  const thrift::OffsetIndex* offsetIndex(uint32_t column) const;
+
+  bool empty() const {
+    return columnIndexes_.empty() && offsetIndexes_.empty();
+  }
+
+ private:
+  folly::F14FastMap<uint32_t, thrift::ColumnIndex> columnIndexes_;
+  folly::F14FastMap<uint32_t, thrift::OffsetIndex> offsetIndexes_;
+};
+
+/// Input stream over the enqueued page ranges of a column chunk. Offsets are
+/// relative to the start of the chunk. The bytes between the ranges are never
+/// loaded. They can be skipped over but not read.
+class SparseChunkInputStream : public dwio::common::SeekableInputStream {
+ public:
+  struct Range {
+    int64_t offset;
+    int64_t length;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+
+  /// 'ranges' are sorted by offset and do not overlap.
+  explicit SparseChunkInputStream(std::vector<Range> ranges);
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool SkipInt64(int64_t count) override;
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override;
+
+  size_t positionSize() const override {
+    return 1;
+  }
+
+ private:
+  std::vector<Range> ranges_;
+  // Index of the range containing or following 'position_'.
+  size_t current_{0};
+  // Offset of the next byte to return, relative to the chunk start.
+  int64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
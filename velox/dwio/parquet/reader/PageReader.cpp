@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
@@ -38,6 +39,26 @@ struct __attribute__((__packed__)) Int96Timestamp {
   uint64_t nanos;
 };
 
+PageReader::~PageReader() {
+  if (readAheadDecompression_) {
+    readAheadDecompression_->close();
+  }
+  for (auto& page : readAheadPages_) {
+    if (page.decompression) {
+      page.decompression->close();
+    }
+  }
+}
+
+void PageReader::setReadAhead(const PageReadAheadOptions& options) {
+  if (options.executor == nullptr || options.maxPages <= 0 || !isTopLevel_ ||
+      !pageLocations_.empty() ||
+      codec_ == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  readAhead_ = options;
+}
+
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
@@ -50,7 +71,10 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
-    PageHeader pageHeader = readPageHeader();
+    if (row != kRepDefOnly) {
+      skipToPageOfRow(row);
+    }
+    PageHeader pageHeader = nextPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
     switch (pageHeader.type) {
@@ -81,9 +105,176 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::skipToPageOfRow(int64_t row) {
+  if (pageLocations_.empty() ||
+      static_cast<int64_t>(pageStart_) < pageLocations_.front().offset) {
+    return;
+  }
+  auto it = std::upper_bound(
+      pageLocations_.begin(),
+      pageLocations_.end(),
+      row,
+      [](int64_t target, const thrift::PageLocation& location) {
+        return target < location.first_row_index;
+      });
+  VELOX_CHECK(it != pageLocations_.begin());
+  --it;
+  if (it->offset <= static_cast<int64_t>(pageStart_)) {
+    return;
+  }
+  skipBytes(
+      it->offset - pageStart_, inputStream_.get(), bufferStart_, bufferEnd_);
+  pageStart_ = it->offset;
+  rowOfPage_ = it->first_row_index;
+  numRowsInPage_ = 0;
+}
+
+PageHeader PageReader::nextPageHeader() {
+  if (readAhead_.maxPages == 0) {
+    return readPageHeader();
+  }
+  fillReadAhead(pageStart_);
+  if (readAheadPages_.empty()) {
+    return readPageHeader();
+  }
+  if (readAheadDecompression_) {
+    // The data of the previous page was not needed.
+    readAheadDecompression_->close();
+    readAheadDecompression_.reset();
+  }
+  auto page = std::move(readAheadPages_.front());
+  readAheadPages_.pop_front();
+  readAheadBytes_ -= page.size;
+  pageStart_ = page.pageStart;
+  pageDataStart_ = page.pageDataStart;
+  readAheadData_ = std::move(page.data);
+  readAheadDecompression_ = std::move(page.decompression);
+  if (readAheadData_) {
+    // 'inputStream_' is after the current page. Keep the pages ahead of it
+    // decompressing while it is decoded.
+    fillReadAhead(pageDataStart_ + page.header.compressed_page_size);
+  }
+  return std::move(page.header);
+}
+
+void PageReader::fillReadAhead(uint64_t streamOffset) {
+  if (!readAheadPages_.empty()) {
+    const auto& last = readAheadPages_.back();
+    if (!last.data) {
+      // The data of 'last' is next in 'inputStream_'.
+      return;
+    }
+    streamOffset = last.pageDataStart + last.header.compressed_page_size;
+  }
+  const auto maxPages = static_cast<size_t>(readAhead_.maxPages);
+  while (readAheadPages_.size() < maxPages &&
+         static_cast<int64_t>(streamOffset) < chunkSize_ &&
+         (readAheadPages_.empty() || readAheadBytes_ < readAhead_.maxBytes)) {
+    ReadAheadPage page;
+    uint64_t headerSize;
+    page.header = parsePageHeader(headerSize);
+    page.pageStart = streamOffset;
+    page.pageDataStart = streamOffset + headerSize;
+    streamOffset = page.pageDataStart + page.header.compressed_page_size;
+    if (page.header.type != thrift::PageType::DATA_PAGE &&
+        page.header.type != thrift::PageType::DATA_PAGE_V2) {
+      readAheadPages_.push_back(std::move(page));
+      return;
+    }
+    const auto compressedSize = page.header.compressed_page_size;
+    page.data = AlignedBuffer::allocate<char>(compressedSize, &pool_);
+    dwio::common::readBytes(
+        compressedSize,
+        inputStream_.get(),
+        page.data->asMutable<char>(),
+        bufferStart_,
+        bufferEnd_);
+    page.size = compressedSize;
+    startDecompression(page);
+    readAheadBytes_ += page.size;
+    if (readAhead_.stats) {
+      ++readAhead_.stats->readAheadPages;
+    }
+    readAheadPages_.push_back(std::move(page));
+  }
+}
+
+void PageReader::startDecompression(ReadAheadPage& page) {
+  const auto& header = page.header;
+  // A V2 page has uncompressed repdefs before the possibly compressed data.
+  int32_t levelsSize = 0;
+  if (header.type == thrift::PageType::DATA_PAGE_V2) {
+    const auto& v2Header = header.data_page_header_v2;
+    if (!v2Header.__isset.is_compressed || !v2Header.is_compressed) {
+      return;
+    }
+    levelsSize = v2Header.repetition_levels_byte_length +
+        v2Header.definition_levels_byte_length;
+    if (header.compressed_page_size - levelsSize <= 0) {
+      return;
+    }
+  }
+  const uint32_t compressedSize = header.compressed_page_size - levelsSize;
+  const uint32_t uncompressedSize = header.uncompressed_page_size - levelsSize;
+  // The output buffer and the decompressor are made here so that
+  // 'readAhead_.executor' only decompresses into memory allocated on this
+  // thread, with no intermediate copy.
+  auto decompressed = AlignedBuffer::allocate<char>(uncompressedSize, &pool_);
+  page.size += uncompressedSize;
+  const auto streamDebugInfo =
+      fmt::format("Page Reader: Stream {}", inputStream_->getName());
+  std::shared_ptr<dwio::common::compression::Decompressor> decompressor =
+      dwio::common::compression::createBlockDecompressor(
+          codec_,
+          uncompressedSize,
+          getParquetDecompressionOptions(codec_),
+          streamDebugInfo);
+  page.decompression = std::make_shared<AsyncSource<BufferPtr>>(
+      [data = page.data,
+       decompressed,
+       decompressor = std::move(decompressor),
+       levelsSize,
+       compressedSize,
+       uncompressedSize,
+       streamDebugInfo]() {
+        const auto size = decompressor->decompress(
+            data->as<char>() + levelsSize,
+            compressedSize,
+            decompressed->asMutable<char>(),
+            uncompressedSize);
+        VELOX_CHECK_EQ(
+            size,
+            uncompressedSize,
+            "Decompressed size mismatch. {}",
+            streamDebugInfo);
+        return std::make_unique<BufferPtr>(decompressed);
+      });
+  readAhead_.executor->add(
+      [decompression = page.decompression]() { decompression->prepare(); });
+}
+
+void PageReader::skipPageData(int32_t size) {
+  if (readAheadData_) {
+    readAheadData_.reset();
+    if (readAheadDecompression_) {
+      readAheadDecompression_->close();
+      readAheadDecompression_.reset();
+    }
+    return;
+  }
+  dwio::common::skipBytes(size, inputStream_.get(), bufferStart_, bufferEnd_);
+}
+
 PageHeader PageReader::readPageHeader() {
   TestValue::adjust(
       "facebook::velox::parquet::PageReader::readPageHeader", this);
+  uint64_t headerSize;
+  auto pageHeader = parsePageHeader(headerSize);
+  pageDataStart_ = pageStart_ + headerSize;
+  return pageHeader;
+}
+
+PageHeader PageReader::parsePageHeader(uint64_t& headerSize) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
     int32_t size;
@@ -98,14 +289,15 @@ PageHeader PageReader::readPageHeader() {
   apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
       transport);
   PageHeader pageHeader;
-  uint64_t readBytes;
-  readBytes = pageHeader.read(&protocol);
-
-  pageDataStart_ = pageStart_ + readBytes;
+  headerSize = pageHeader.read(&protocol);
   return pageHeader;
 }
 
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
+  if (readAheadData_) {
+    copy = std::move(readAheadData_);
+    return copy->as<char>();
+  }
   if (bufferEnd_ == bufferStart_) {
     const void* buffer = nullptr;
     int32_t bufferSize = 0;
@@ -133,11 +325,41 @@ const char* PageReader::decompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  if (readAheadDecompression_) {
+    uint64_t waitNanos{0};
+    std::unique_ptr<BufferPtr> decompressed;
+    {
+      NanosecondTimer timer(&waitNanos);
+      decompressed = readAheadDecompression_->move();
+    }
+    readAheadDecompression_.reset();
+    if (readAhead_.stats) {
+      readAhead_.stats->readAheadWaitNanos += waitNanos;
+    }
+    VELOX_CHECK_NOT_NULL(decompressed);
+    decompressedData_ = std::move(*decompressed);
+    return decompressedData_->as<char>();
+  }
+  dwio::common::ensureCapacity<char>(
+      decompressedData_, uncompressedSize, &pool_);
+  decompress(
+      pageData,
+      compressedSize,
+      uncompressedSize,
+      decompressedData_->asMutable<char>(),
+      fmt::format("Page Reader: Stream {}", inputStream_->getName()));
+  return decompressedData_->as<char>();
+}
+
+void PageReader::decompress(
+    const char* input,
+    uint32_t compressedSize,
+    uint32_t uncompressedSize,
+    char* output,
+    const std::string& streamDebugInfo) const {
   std::unique_ptr<dwio::common::SeekableInputStream> inputStream =
       std::make_unique<dwio::common::SeekableArrayInputStream>(
-          pageData, compressedSize, 0);
-  auto streamDebugInfo =
-      fmt::format("Page Reader: Stream {}", inputStream_->getName());
+          input, compressedSize, 0);
   std::unique_ptr<dwio::common::SeekableInputStream> decompressedStream =
       dwio::common::compression::createDecompressor(
           codec_,
@@ -149,13 +371,7 @@ const char* PageReader::decompressData(
           nullptr,
           true,
           compressedSize);
-
-  dwio::common::ensureCapacity<char>(
-      decompressedData_, uncompressedSize, &pool_);
-  decompressedStream->readFully(
-      decompressedData_->asMutable<char>(), uncompressedSize);
-
-  return decompressedData_->as<char>();
+  decompressedStream->readFully(output, uncompressedSize);
 }
 
 void PageReader::setPageRowInfo(bool forRepDef) {
@@ -208,12 +424,7 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    dwio::common::skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
-
+    skipPageData(pageHeader.compressed_page_size);
     return;
   }
   pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
@@ -264,11 +475,7 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   setPageRowInfo(row == kRepDefOnly);
   if (row != kRepDefOnly && numRowsInPage_ != kRowsUnknown &&
       numRowsInPage_ + rowOfPage_ <= row) {
-    skipBytes(
-        pageHeader.compressed_page_size,
-        inputStream_.get(),
-        bufferStart_,
-        bufferEnd_);
+    skipPageData(pageHeader.compressed_page_size);
     return;
   }
 
@@ -515,15 +722,31 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
-void PageReader::makeFilterCache(dwio::common::ScanState& state) {
+void PageReader::makeFilterCache(
+    dwio::common::ScanState& state,
+    const common::Filter* filter) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
   state.filterCache.resize(state.dictionary.numValues);
+  state.rawState.filterCache = state.filterCache.data();
+  if (filter != nullptr && filter->isDeterministic() &&
+      type_->parquetType_ == thrift::Type::BYTE_ARRAY &&
+      state.dictionary.numValues <= numRowsInPage_) {
+    // The dictionary is small compared to the data. Test each entry once so
+    // that the index runs of the data pages are filtered by lookup alone.
+    auto* values = state.dictionary.values->as<StringView>();
+    for (auto i = 0; i < state.dictionary.numValues; ++i) {
+      state.filterCache[i] =
+          filter->testBytes(values[i].data(), values[i].size())
+          ? dwio::common::FilterResult::kSuccess
+          : dwio::common::FilterResult::kFailure;
+    }
+    return;
+  }
   simd::memset(
       state.filterCache.data(),
       dwio::common::FilterResult::kUnknown,
       state.filterCache.size());
-  state.rawState.filterCache = state.filterCache.data();
 }
 
 namespace {
@@ -739,6 +962,29 @@ void PageReader::makeDecoder() {
           VELOX_UNSUPPORTED("RLE decoder only supports BOOLEAN");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType == thrift::Type::BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_ =
+            std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+        break;
+      }
+      VELOX_UNSUPPORTED(
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_, pageData_ + encodedDataSize_, parquetType);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT, DOUBLE, INT32 "
+              "and INT64");
+      }
+      break;
     case Encoding::DELTA_BYTE_ARRAY:
       if (parquetType == thrift::Type::BYTE_ARRAY) {
         deltaByteArrDecoder_ =
@@ -778,6 +1024,10 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (isByteStreamSplit()) {
+    byteStreamSplitDecoder_->skip(toSkip);
+  } else if (isDeltaLengthByteArray()) {
+    deltaLengthByteArrDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -912,7 +1162,7 @@ bool PageReader::rowsForPage(
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        makeFilterCache(scanState, reader.scanSpec()->filter());
       }
       scanState.updateRawState();
     }
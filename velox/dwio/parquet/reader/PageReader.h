@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
@@ -23,6 +24,7 @@
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/common/RleEncodingInternal.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
@@ -31,6 +33,24 @@
 
 namespace facebook::velox::parquet {
 
+/// Options for decompressing the data pages of a column chunk ahead of the
+/// page being decoded.
+struct PageReadAheadOptions {
+  /// Runs the decompression of the pages ahead. No read-ahead if nullptr.
+  folly::Executor* executor{nullptr};
+
+  /// Maximum number of pages read ahead. No read-ahead if 0.
+  int32_t maxPages{0};
+
+  /// Maximum compressed plus decompressed bytes of the pages read ahead. At
+  /// least one page is read ahead regardless.
+  uint64_t maxBytes{0};
+
+  /// Receives the number of pages read ahead and the time spent waiting for
+  /// them. Only updated on the thread using the PageReader.
+  dwio::common::ColumnReaderStatistics* stats{nullptr};
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -73,9 +93,27 @@ class PageReader {
         nullConcatenation_(pool_),
         sessionTimezone_(sessionTimezone) {}
 
+  ~PageReader();
+
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Sets the locations of the data pages of the column chunk from its
+  /// OffsetIndex, with offsets relative to the start of the chunk. A skip then
+  /// jumps directly to the page containing the target row without reading the
+  /// headers of the pages in between. Only for top level columns.
+  void setPageLocations(std::vector<thrift::PageLocation> pageLocations) {
+    VELOX_CHECK(isTopLevel_);
+    pageLocations_ = std::move(pageLocations);
+  }
+
+  /// Enables decompressing the data pages ahead of the page being decoded on
+  /// 'options.executor'. The compressed pages are copied out of the input
+  /// stream. No-op unless the column chunk is compressed and the column is top
+  /// level and has no page locations, since read-ahead requires that the
+  /// pages are read in order.
+  void setReadAhead(const PageReadAheadOptions& options);
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -135,6 +173,14 @@ class PageReader {
     return encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY;
   }
 
+  bool isDeltaLengthByteArray() const {
+    return encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+  }
+
+  bool isByteStreamSplit() const {
+    return encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -145,11 +191,40 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  // Positions 'inputStream_' at the start of the last data page in
+  // 'pageLocations_' starting at or before 'row' if that is after the current
+  // page. No-op if there are no page locations or the dictionary page is not
+  // read yet.
+  void skipToPageOfRow(int64_t row);
+
   const tz::TimeZone* sessionTimezone() const {
     return sessionTimezone_;
   }
 
  private:
+  // A page whose header and data are read from 'inputStream_' ahead of the
+  // current page.
+  struct ReadAheadPage {
+    thrift::PageHeader header;
+
+    // Offset of the page header from start of ColumnChunk.
+    uint64_t pageStart{0};
+
+    // Offset of first byte after the page header.
+    uint64_t pageDataStart{0};
+
+    // Copy of the page data. nullptr for a page other than a data page, whose
+    // data is read from 'inputStream_' when the page is reached.
+    BufferPtr data;
+
+    // Decompresses 'data' on 'readAhead_.executor'. nullptr if the page is
+    // not compressed.
+    std::shared_ptr<AsyncSource<BufferPtr>> decompression;
+
+    // Bytes of 'data' and the decompressed data.
+    uint64_t size{0};
+  };
+
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
   static constexpr int64_t kRepDefOnly = -1;
@@ -167,8 +242,13 @@ class PageReader {
   // current page.
   int32_t skipNulls(int32_t numRows);
 
-  // Initializes a filter result cache for the dictionary in 'state'.
-  void makeFilterCache(dwio::common::ScanState& state);
+  // Initializes a filter result cache for the dictionary in 'state'. If the
+  // dictionary holds strings and has no more entries than the current page has
+  // rows, 'filter' is evaluated for all entries up front. Otherwise the
+  // entries are evaluated as they are first hit.
+  void makeFilterCache(
+      dwio::common::ScanState& state,
+      const common::Filter* filter);
 
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
@@ -183,6 +263,26 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Returns the header of the next page. Takes the page from
+  // 'readAheadPages_' if read-ahead is on.
+  thrift::PageHeader nextPageHeader();
+
+  // Parses the PageHeader at 'inputStream_' and sets 'headerSize' to its size.
+  thrift::PageHeader parsePageHeader(uint64_t& headerSize);
+
+  // Reads pages from 'inputStream_' into 'readAheadPages_' and starts their
+  // decompression until reaching the limits in 'readAhead_' or a page other
+  // than a data page. 'streamOffset' is the offset of 'inputStream_' from
+  // start of ColumnChunk if 'readAheadPages_' is empty.
+  void fillReadAhead(uint64_t streamOffset);
+
+  // Schedules the decompression of 'page' on 'readAhead_.executor'. The
+  // output buffer and the decompressor are created on the calling thread.
+  void startDecompression(ReadAheadPage& page);
+
+  // Skips the data of the current page.
+  void skipPageData(int32_t size);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -223,6 +323,15 @@ class PageReader {
       uint32_t compressedSize,
       uint32_t uncompressedSize);
 
+  // Decompresses 'compressedSize' bytes at 'input' into 'uncompressedSize'
+  // bytes at 'output'. May be called on 'readAhead_.executor'.
+  void decompress(
+      const char* input,
+      uint32_t compressedSize,
+      uint32_t uncompressedSize,
+      char* output,
+      const std::string& streamDebugInfo) const;
+
   template <typename T>
   T readField(const char* FOLLY_NONNULL& ptr) {
     T data = *reinterpret_cast<const T*>(ptr);
@@ -280,6 +389,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         nullsFromFastPath = false;
         deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        nullsFromFastPath = false;
+        byteStreamSplitDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -290,6 +402,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -312,6 +426,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         nullsFromFastPath = false;
         deltaByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -322,6 +439,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
         deltaByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -457,6 +576,23 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Locations of the data pages from the OffsetIndex of the column chunk.
+  // Offsets are from start of ColumnChunk. Empty if there is no page index.
+  std::vector<thrift::PageLocation> pageLocations_;
+
+  // Read-ahead settings. Read-ahead is on if 'readAhead_.maxPages' > 0.
+  PageReadAheadOptions readAhead_;
+
+  // Pages read ahead of the current page, in ColumnChunk order.
+  std::deque<ReadAheadPage> readAheadPages_;
+
+  // Sum of the sizes of 'readAheadPages_'.
+  uint64_t readAheadBytes_{0};
+
+  // Data and pending decompression of the current page if it was read ahead.
+  BufferPtr readAheadData_;
+  std::shared_ptr<AsyncSource<BufferPtr>> readAheadDecompression_;
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
@@ -511,6 +647,8 @@ class PageReader {
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
   std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   std::unique_ptr<RleBpDataDecoder> rleBooleanDecoder_;
   // Add decoders for other encodings here.
 };
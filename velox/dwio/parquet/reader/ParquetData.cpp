@@ -16,16 +16,190 @@
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetStatsContext.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+
+// Upper bound for the size of a serialized BloomFilterHeader. The header has
+// the bitset size and three single-member unions.
+constexpr int64_t kMaxBloomFilterHeaderSize = 64;
+
+// Returns the size of the Bloom filter header at 'offset' plus the size of
+// the bitset in the header.
+int64_t readBloomFilterLength(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int64_t fileLength) {
+  const auto headerReadSize =
+      std::min<int64_t>(kMaxBloomFilterHeaderSize, fileLength - offset);
+  auto headerStream = input.read(
+      offset, headerReadSize, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> headerBuffer(headerReadSize);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      headerReadSize,
+      headerStream.get(),
+      headerBuffer.data(),
+      bufferStart,
+      bufferEnd);
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(
+          headerBuffer.data(), headerReadSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = header.read(&protocol);
+  VELOX_CHECK_GT(header.numBytes, 0, "Invalid Bloom filter size");
+  return headerSize + header.numBytes;
+}
+
+bool isBloomFilterTestable(const common::Filter& filter) {
+  if (filter.testNull()) {
+    // Nulls are not recorded in the Bloom filter.
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesRange:
+      return static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Computes the Bloom filter hashes of 'values' stored as 'physicalType' into
+// 'hashes'. Returns false if the values cannot be hashed for 'physicalType'.
+bool hashBigints(
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    const std::vector<int64_t>& values,
+    std::vector<uint64_t>& hashes) {
+  if (physicalType == thrift::Type::INT64) {
+    hashes.resize(values.size());
+    bloomFilter.hashes(values.data(), values.size(), hashes.data());
+    return true;
+  }
+  if (physicalType != thrift::Type::INT32) {
+    return false;
+  }
+  // The hash is over the 32 bit value in the file. Values that do not fit in
+  // 32 bits, signed or unsigned, cannot be in the column.
+  std::vector<int32_t> narrowValues;
+  narrowValues.reserve(values.size());
+  for (auto value : values) {
+    if (value >= std::numeric_limits<int32_t>::min() &&
+        value <= std::numeric_limits<uint32_t>::max()) {
+      narrowValues.push_back(static_cast<int32_t>(value));
+    }
+  }
+  hashes.resize(narrowValues.size());
+  bloomFilter.hashes(narrowValues.data(), narrowValues.size(), hashes.data());
+  return true;
+}
+
+bool hashStrings(
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    const std::vector<ByteArray>& values,
+    std::vector<uint64_t>& hashes) {
+  if (physicalType != thrift::Type::BYTE_ARRAY) {
+    return false;
+  }
+  hashes.resize(values.size());
+  bloomFilter.hashes(values.data(), values.size(), hashes.data());
+  return true;
+}
+
+} // namespace
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  if (!isBloomFilterTestable(filter)) {
+    return true;
+  }
+  // The values of the filter are hashed in a batch and then probed. This
+  // keeps the hashing of long IN lists in a tight loop.
+  std::vector<uint64_t> hashes;
+  bool supported = false;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      supported = hashBigints(
+          bloomFilter,
+          physicalType,
+          {static_cast<const common::BigintRange&>(filter).lower()},
+          hashes);
+      break;
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      supported = hashBigints(
+          bloomFilter,
+          physicalType,
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values(),
+          hashes);
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      supported = hashBigints(
+          bloomFilter,
+          physicalType,
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values(),
+          hashes);
+      break;
+    case common::FilterKind::kBytesRange:
+      supported = hashStrings(
+          bloomFilter,
+          physicalType,
+          {ByteArray(static_cast<const common::BytesRange&>(filter).lower())},
+          hashes);
+      break;
+    case common::FilterKind::kBytesValues: {
+      const auto& values =
+          static_cast<const common::BytesValues&>(filter).values();
+      std::vector<ByteArray> byteArrays;
+      byteArrays.reserve(values.size());
+      for (const auto& value : values) {
+        byteArrays.emplace_back(value);
+      }
+      supported = hashStrings(bloomFilter, physicalType, byteArrays, hashes);
+      break;
+    }
+    default:
+      break;
+  }
+  if (!supported) {
+    return true;
+  }
+  for (auto hash : hashes) {
+    if (bloomFilter.findHash(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
+  auto readAhead = readAhead_;
+  readAhead.stats = &runtimeStatistics();
   return std::make_unique<ParquetData>(
-      type, metaData_, pool(), sessionTimezone_);
+      type, metaData_, pool(), sessionTimezone_, readAhead);
 }
 
 void ParquetData::filterRowGroups(
@@ -89,11 +263,107 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+bool ParquetData::bloomFilterMatches(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    const common::Filter* filter) const {
+  if (!filter || !type_->parquetType_.has_value() ||
+      !isBloomFilterTestable(*filter)) {
+    return true;
+  }
+  auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  if (!chunk.hasBloomFilter()) {
+    return true;
+  }
+  const auto offset = chunk.bloomFilterOffset();
+  const auto fileLength = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileLength, "Bloom filter offset out of range");
+  int64_t length = chunk.bloomFilterLength();
+  if (length == 0) {
+    // The writer did not record the size. It is in the header, which is read
+    // first so that only the filter itself is read and cached.
+    length = readBloomFilterLength(input, offset, fileLength);
+  }
+  VELOX_CHECK_LE(
+      offset + length,
+      fileLength,
+      "Bloom filter extends past the end of the file");
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  auto bloomFilter = BlockSplitBloomFilter::deserialize(stream.get(), pool_);
+  return testBloomFilter(*filter, bloomFilter, type_->parquetType_.value());
+}
+
+bool ParquetData::pageMatches(
+    const thrift::ColumnIndex& columnIndex,
+    int32_t page,
+    int64_t numRows,
+    common::Filter* filter) const {
+  thrift::Statistics pageStats;
+  if (!columnIndex.null_pages[page]) {
+    pageStats.__set_min_value(columnIndex.min_values[page]);
+    pageStats.__set_max_value(columnIndex.max_values[page]);
+  }
+  if (columnIndex.__isset.null_counts) {
+    pageStats.__set_null_count(columnIndex.null_counts[page]);
+  } else if (columnIndex.null_pages[page]) {
+    pageStats.__set_null_count(numRows);
+  }
+  const auto& type = type_->type();
+  auto columnStats = buildColumnStatisticsFromThrift(pageStats, *type, numRows);
+  return testFilter(filter, columnStats.get(), numRows, type);
+}
+
+std::optional<RowRanges> ParquetData::filterPages(
+    uint32_t index,
+    const RowGroupPageIndex& pageIndex,
+    common::Filter* filter) const {
+  // The page index postdates the writer bugs that make
+  // ParquetStatsContext::shouldIgnoreStatistics() skip the chunk statistics of
+  // old files, so its min/max values are always used.
+  if (!filter || !supportsPageSkipping()) {
+    return std::nullopt;
+  }
+  const auto* columnIndex = pageIndex.columnIndex(type_->column());
+  const auto* offsetIndex = pageIndex.offsetIndex(type_->column());
+  if (!columnIndex || !offsetIndex) {
+    return std::nullopt;
+  }
+  const auto& locations = offsetIndex->page_locations;
+  const auto numPages = locations.size();
+  if (numPages == 0 || columnIndex->null_pages.size() != numPages ||
+      columnIndex->min_values.size() != numPages ||
+      columnIndex->max_values.size() != numPages ||
+      (columnIndex->__isset.null_counts &&
+       columnIndex->null_counts.size() != numPages)) {
+    return std::nullopt;
+  }
+  const auto numRows = fileMetaDataPtr_.rowGroup(index).numRows();
+  RowRanges ranges;
+  for (auto i = 0; i < numPages; ++i) {
+    const auto begin = locations[i].first_row_index;
+    const auto end =
+        i + 1 < numPages ? locations[i + 1].first_row_index : numRows;
+    if (begin >= end || !pageMatches(*columnIndex, i, end - begin, filter)) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == begin) {
+      ranges.back().end = end;
+    } else {
+      ranges.push_back({begin, end});
+    }
+  }
+  return ranges;
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
-    dwio::common::BufferedInput& input) {
+    dwio::common::BufferedInput& input,
+    const thrift::OffsetIndex* offsetIndex,
+    const RowRanges* rowRanges) {
   auto chunk = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
   streams_.resize(fileMetaDataPtr_.numRowGroups());
+  pageLocations_.resize(fileMetaDataPtr_.numRowGroups());
   VELOX_CHECK(
       chunk.hasMetadata(),
       "ColumnMetaData does not exist for schema Id ",
@@ -106,15 +376,79 @@ void ParquetData::enqueueRowGroup(
     chunkReadOffset = chunk.dictionaryPageOffset();
   }
 
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  if (offsetIndex && rowRanges && supportsPageSkipping() &&
+      !offsetIndex->page_locations.empty() &&
+      offsetIndex->page_locations.front().offset >= chunkReadOffset) {
+    enqueuePages(index, input, chunkReadOffset, *offsetIndex, *rowRanges, id);
+    return;
+  }
+  pageLocations_[index].clear();
+
   uint64_t readSize =
       (chunk.compression() == common::CompressionKind::CompressionKind_NONE)
       ? chunk.totalUncompressedSize()
       : chunk.totalCompressedSize();
 
-  auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
 }
 
+void ParquetData::enqueuePages(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    uint64_t chunkReadOffset,
+    const thrift::OffsetIndex& offsetIndex,
+    const RowRanges& rowRanges,
+    const dwio::common::StreamIdentifier& id) {
+  const auto& locations = offsetIndex.page_locations;
+  const auto numRows = fileMetaDataPtr_.rowGroup(index).numRows();
+  // Byte ranges to read, relative to the file start.
+  std::vector<std::pair<int64_t, int64_t>> regions;
+  const auto addRegion = [&](int64_t begin, int64_t end) {
+    if (!regions.empty() && regions.back().second == begin) {
+      regions.back().second = end;
+    } else {
+      regions.emplace_back(begin, end);
+    }
+  };
+  // The dictionary page precedes the first data page.
+  if (locations.front().offset > chunkReadOffset) {
+    addRegion(chunkReadOffset, locations.front().offset);
+  }
+  auto& pageLocations = pageLocations_[index];
+  pageLocations.clear();
+  size_t range = 0;
+  for (auto i = 0; i < locations.size(); ++i) {
+    const auto& location = locations[i];
+    auto relative = location;
+    relative.offset -= chunkReadOffset;
+    pageLocations.push_back(relative);
+
+    const auto begin = location.first_row_index;
+    const auto end =
+        i + 1 < locations.size() ? locations[i + 1].first_row_index : numRows;
+    while (range < rowRanges.size() && rowRanges[range].end <= begin) {
+      ++range;
+    }
+    if (range < rowRanges.size() && rowRanges[range].begin < end) {
+      addRegion(
+          location.offset, location.offset + location.compressed_page_size);
+    }
+  }
+
+  std::vector<SparseChunkInputStream::Range> ranges;
+  ranges.reserve(regions.size());
+  for (const auto& [begin, end] : regions) {
+    ranges.push_back(
+        {static_cast<int64_t>(begin - chunkReadOffset),
+         end - begin,
+         input.enqueue(
+             {static_cast<uint64_t>(begin), static_cast<uint64_t>(end - begin)},
+             &id)});
+  }
+  streams_[index] = std::make_unique<SparseChunkInputStream>(std::move(ranges));
+}
+
 dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
@@ -127,6 +461,11 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(int64_t index) {
       metadata.compression(),
       metadata.totalCompressedSize(),
       sessionTimezone_);
+  if (index < pageLocations_.size() && !pageLocations_[index].empty()) {
+    reader_->setPageLocations(std::move(pageLocations_[index]));
+    pageLocations_[index].clear();
+  }
+  reader_->setReadAhead(readAhead_);
   return dwio::common::PositionProvider(empty);
 }
 
@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -26,10 +27,22 @@ class ScanSpec;
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
+class StreamIdentifier;
 } // namespace facebook::velox::dwio::common
 
 namespace facebook::velox::parquet {
 
+class BloomFilter;
+
+/// True if some value accepted by 'filter' may be in 'bloomFilter' of a
+/// column chunk with 'physicalType'. Only single value and IN filters on
+/// integers and strings are checked. Other filters and filters that accept
+/// nulls return true.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType);
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -37,11 +50,13 @@ class ParquetParams : public dwio::common::FormatParams {
       dwio::common::ColumnReaderStatistics& stats,
       const FileMetaDataPtr metaData,
       const tz::TimeZone* sessionTimezone,
-      TimestampPrecision timestampPrecision)
+      TimestampPrecision timestampPrecision,
+      const PageReadAheadOptions& readAhead = {})
       : FormatParams(pool, stats),
         metaData_(metaData),
         sessionTimezone_(sessionTimezone),
-        timestampPrecision_(timestampPrecision) {}
+        timestampPrecision_(timestampPrecision),
+        readAhead_(readAhead) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
@@ -54,6 +69,7 @@ class ParquetParams : public dwio::common::FormatParams {
   const FileMetaDataPtr metaData_;
   const tz::TimeZone* sessionTimezone_;
   const TimestampPrecision timestampPrecision_;
+  const PageReadAheadOptions readAhead_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -63,17 +79,49 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      const PageReadAheadOptions& readAhead = {})
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1),
-        sessionTimezone_(sessionTimezone) {}
-
-  /// Prepares to read data for 'index'th row group.
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+        sessionTimezone_(sessionTimezone),
+        readAhead_(readAhead) {}
+
+  /// Prepares to read data for 'index'th row group. If 'offsetIndex' and
+  /// 'rowRanges' are given, only the data pages containing rows in
+  /// 'rowRanges' are enqueued. The rows outside of 'rowRanges' must then be
+  /// skipped.
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const thrift::OffsetIndex* offsetIndex = nullptr,
+      const RowRanges* rowRanges = nullptr);
+
+  /// Returns the rows of 'index'th row group that may pass 'filter' according
+  /// to the min/max values and null counts of the pages in 'pageIndex'.
+  /// Returns std::nullopt if there is no usable page index for the column.
+  std::optional<RowRanges> filterPages(
+      uint32_t index,
+      const RowGroupPageIndex& pageIndex,
+      common::Filter* filter) const;
+
+  /// True if 'filter' may have hits in 'index'th row group according to the
+  /// Bloom filter of the column chunk, which is read from 'input'. Returns
+  /// true if there is no Bloom filter or 'filter' cannot be checked against
+  /// it.
+  bool bloomFilterMatches(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const common::Filter* filter) const;
+
+  /// True if the column can be read page by page using the OffsetIndex, i.e.
+  /// each value is a top level row.
+  bool supportsPageSkipping() const {
+    return maxRepeat_ == 0 && maxDefine_ <= 1;
+  }
 
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
@@ -196,6 +244,14 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->isDeltaByteArray();
   }
 
+  bool isDeltaLengthByteArray() const {
+    return reader_->isDeltaLengthByteArray();
+  }
+
+  bool isByteStreamSplit() const {
+    return reader_->isByteStreamSplit();
+  }
+
   bool parentNullsInLeaves() const override {
     return true;
   }
@@ -208,6 +264,24 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// Enqueues the dictionary page and the data pages of 'index'th row group
+  /// that contain rows in 'rowRanges'.
+  void enqueuePages(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      uint64_t chunkReadOffset,
+      const thrift::OffsetIndex& offsetIndex,
+      const RowRanges& rowRanges,
+      const dwio::common::StreamIdentifier& id);
+
+  /// True if 'filter' may have hits in the 'page'th page of 'columnIndex'.
+  /// The page has 'numRows' rows.
+  bool pageMatches(
+      const thrift::ColumnIndex& columnIndex,
+      int32_t page,
+      int64_t numRows,
+      common::Filter* filter) const;
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -215,11 +289,15 @@ class ParquetData : public dwio::common::FormatData {
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+  // Locations of the data pages for each of 'streams_' that covers only some
+  // pages of the column chunk. Offsets are relative to the chunk start.
+  std::vector<std::vector<thrift::PageLocation>> pageLocations_;
 
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
   const tz::TimeZone* sessionTimezone_;
+  const PageReadAheadOptions readAhead_;
   std::unique_ptr<PageReader> reader_;
 
   // Nulls derived from leaf repdefs for non-leaf readers.
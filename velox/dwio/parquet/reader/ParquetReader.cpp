@@ -996,6 +996,10 @@ void ReaderBase::scheduleRowGroups(
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
     if (!inputs_[thisGroup]) {
+      if (options_.pageIndexFilterEnabled()) {
+        reader.filterPages(
+            thisGroup, fileMetaData_->row_groups[thisGroup], *input_);
+      }
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
   }
@@ -1057,12 +1061,17 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     parquetStatsContext_ = ParquetStatsContext(readerBase_->version());
+    PageReadAheadOptions readAhead;
+    readAhead.executor = options_.decodingExecutor().get();
+    readAhead.maxPages = readerBase_->options().readAheadPages();
+    readAhead.maxBytes = readerBase_->options().readAheadBytes();
     ParquetParams params(
         pool_,
         columnReaderStats_,
         readerBase_->fileMetaData(),
         readerBase->sessionTimezone(),
-        options_.timestampPrecision());
+        options_.timestampPrecision(),
+        readAhead);
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -1111,6 +1120,15 @@ class ParquetRowReader::Impl {
           (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i));
       auto isEmpty = rowGroups_[i].num_rows == 0;
 
+      // Row groups that survive the statistics are checked against the Bloom
+      // filters, which need an IO.
+      if (rowGroupInRange && !isExcluded && !isEmpty &&
+          readerBase_->options().bloomFilterEnabled() &&
+          !static_cast<StructColumnReader&>(*columnReader_)
+               .bloomFilterMatches(i, readerBase_->bufferedInput())) {
+        isExcluded = true;
+      }
+
       // Add a row group to read if it is within range and not empty and not in
       // the excluded list.
       if (rowGroupInRange && !isExcluded && !isEmpty) {
@@ -1133,9 +1151,14 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      if (skipToNextRowRange()) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -1145,7 +1168,10 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    const auto endOfRange = rowRanges_ != nullptr
+        ? (*rowRanges_)[nextRowRange_].end
+        : rowsInCurrentRowGroup_;
+    return std::min<uint64_t>(size, endOfRange - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -1185,6 +1211,11 @@ class ParquetRowReader::Impl {
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.skippedPageRows += skippedPageRows_;
+    stats.columnReaderStatistics.readAheadPages +=
+        columnReaderStats_.readAheadPages;
+    stats.columnReaderStatistics.readAheadWaitNanos +=
+        columnReaderStats_.readAheadWaitNanos;
   }
 
   void resetFilterCaches() {
@@ -1211,6 +1242,34 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    rowRanges_ = static_cast<StructColumnReader&>(*columnReader_).rowRanges();
+    nextRowRange_ = 0;
+    return true;
+  }
+
+  // Moves to the first row at or after the current row that the page index
+  // does not exclude. Returns false if there is no such row in the current row
+  // group.
+  bool skipToNextRowRange() {
+    if (rowRanges_ == nullptr) {
+      return true;
+    }
+    const int64_t row = currentRowInGroup_;
+    while (nextRowRange_ < rowRanges_->size() &&
+           (*rowRanges_)[nextRowRange_].end <= row) {
+      ++nextRowRange_;
+    }
+    if (nextRowRange_ == rowRanges_->size()) {
+      skippedPageRows_ += rowsInCurrentRowGroup_ - currentRowInGroup_;
+      currentRowInGroup_ = rowsInCurrentRowGroup_;
+      return false;
+    }
+    const auto begin = (*rowRanges_)[nextRowRange_].begin;
+    if (begin > row) {
+      columnReader_->seekTo(begin, false);
+      skippedPageRows_ += begin - row;
+      currentRowInGroup_ = begin;
+    }
     return true;
   }
 
@@ -1229,6 +1288,13 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
   uint32_t skippedStrides_{0};
+  // Rows of the current row group that may pass the filters according to the
+  // page index. nullptr if all rows are read.
+  const RowRanges* rowRanges_{nullptr};
+  // Index of the first range in 'rowRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t nextRowRange_{0};
+  int64_t skippedPageRows_{0};
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
@@ -32,6 +32,7 @@ class StringColumnReader : public dwio::common::SelectiveColumnReader {
   bool hasBulkPath() const override {
     //  Non-dictionary encodings do not have fast path.
     return !formatData_->as<ParquetData>().isDeltaByteArray() &&
+        !formatData_->as<ParquetData>().isDeltaLengthByteArray() &&
         scanState_.dictionary.values != nullptr;
   }
 
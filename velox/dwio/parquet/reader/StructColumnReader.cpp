@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
 namespace facebook::velox::common {
@@ -26,6 +27,14 @@ class ScanSpec;
 
 namespace facebook::velox::parquet {
 
+namespace {
+bool isLeafReader(const dwio::common::SelectiveColumnReader& reader) {
+  const auto kind = reader.fileType().type()->kind();
+  return kind != TypeKind::ROW && kind != TypeKind::ARRAY &&
+      kind != TypeKind::MAP;
+}
+} // namespace
+
 StructColumnReader::StructColumnReader(
     const dwio::common::ColumnReaderOptions& columnReaderOptions,
     const TypePtr& requestedType,
@@ -126,6 +135,66 @@ std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
   return newInput;
 }
 
+bool StructColumnReader::filterPages(
+    uint32_t index,
+    const thrift::RowGroup& rowGroup,
+    dwio::common::BufferedInput& input) {
+  std::vector<uint32_t> columns;
+  bool hasFilter = false;
+  for (auto* child : children_) {
+    if (isLeafReader(*child) &&
+        child->formatData().as<ParquetData>().supportsPageSkipping()) {
+      columns.push_back(child->fileType().column());
+      hasFilter |= child->scanSpec()->filter() != nullptr;
+    }
+  }
+  if (!hasFilter) {
+    return false;
+  }
+  auto pageIndex = RowGroupPageIndex::read(rowGroup, columns, input);
+  if (pageIndex->empty()) {
+    return false;
+  }
+
+  const auto numRows = rowGroup.num_rows;
+  RowRanges ranges{{0, numRows}};
+  for (auto* child : children_) {
+    if (!isLeafReader(*child)) {
+      continue;
+    }
+    auto childRanges = child->formatData().as<ParquetData>().filterPages(
+        index, *pageIndex, child->scanSpec()->filter());
+    if (childRanges.has_value()) {
+      ranges = intersectRowRanges(ranges, childRanges.value());
+    }
+  }
+  if (numRowsInRanges(ranges) == numRows) {
+    return false;
+  }
+  pageIndexes_[index] = std::move(pageIndex);
+  rowRanges_[index] = std::move(ranges);
+  return true;
+}
+
+bool StructColumnReader::bloomFilterMatches(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  for (auto* child : children_) {
+    if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
+      if (!structChild->bloomFilterMatches(index, input)) {
+        return false;
+      }
+      continue;
+    }
+    if (isLeafReader(*child) &&
+        !child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, input, child->scanSpec()->filter())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool StructColumnReader::isRowGroupBuffered(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -137,7 +206,22 @@ bool StructColumnReader::isRowGroupBuffered(
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
+  const RowGroupPageIndex* pageIndex = nullptr;
+  const RowRanges* ranges = nullptr;
+  auto it = pageIndexes_.find(index);
+  if (it != pageIndexes_.end()) {
+    pageIndex = it->second.get();
+    ranges = &rowRanges_.at(index);
+  }
   for (auto& child : children_) {
+    if (pageIndex && isLeafReader(*child)) {
+      child->formatData().as<ParquetData>().enqueueRowGroup(
+          index,
+          input,
+          pageIndex->offsetIndex(child->fileType().column()),
+          ranges);
+      continue;
+    }
     if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
       structChild->enqueueRowGroup(index, input);
     } else if (auto listChild = dynamic_cast<ListColumnReader*>(child)) {
@@ -148,6 +232,7 @@ void StructColumnReader::enqueueRowGroup(
       child->formatData().as<ParquetData>().enqueueRowGroup(index, input);
     }
   }
+  pageIndexes_.erase(index);
 }
 
 void StructColumnReader::seekToRowGroup(int64_t index) {
@@ -158,6 +243,12 @@ void StructColumnReader::seekToRowGroup(int64_t index) {
   for (auto& child : children_) {
     child->seekToRowGroup(index);
   }
+  currentRowRanges_.reset();
+  auto it = rowRanges_.find(index);
+  if (it != rowRanges_.end()) {
+    currentRowRanges_ = std::move(it->second);
+    rowRanges_.erase(it);
+  }
 }
 
 void StructColumnReader::seekToEndOfPresetNulls() {
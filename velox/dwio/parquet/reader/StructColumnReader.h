@@ -19,6 +19,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SelectiveStructColumnReader.h"
 #include "velox/dwio/parquet/common/LevelConversion.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
@@ -51,6 +52,30 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Reads the page index of 'index'th row group 'rowGroup' from 'input' and
+  /// computes
+  /// the rows that may pass the filters on the top level columns. A following
+  /// loadRowGroup() then enqueues only the pages containing these rows for
+  /// the columns that have an OffsetIndex. Returns false if no page can be
+  /// skipped.
+  bool filterPages(
+      uint32_t index,
+      const thrift::RowGroup& rowGroup,
+      dwio::common::BufferedInput& input);
+
+  /// Checks the filters of the leaf columns against their Bloom filters in
+  /// 'index'th row group. The Bloom filters are read from 'input'. Returns
+  /// false if some filter cannot pass any row of the row group.
+  bool bloomFilterMatches(uint32_t index, dwio::common::BufferedInput& input);
+
+  /// Returns the rows of the current row group that may pass the filters or
+  /// nullptr if all rows are read. Only set for the root reader after
+  /// filterPages().
+  const RowRanges* rowRanges() const {
+    return currentRowRanges_.has_value() ? &currentRowRanges_.value()
+                                         : nullptr;
+  }
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -95,6 +120,16 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   LevelInfo levelInfo_;
+
+  // Page index and surviving rows of the row groups for which filterPages()
+  // found pages to skip. Removed when the row group is read.
+  folly::F14FastMap<uint32_t, std::unique_ptr<RowGroupPageIndex>>
+      pageIndexes_;
+  folly::F14FastMap<uint32_t, RowRanges> rowRanges_;
+
+  // Surviving rows of the current row group. std::nullopt if all rows are
+  // read.
+  std::optional<RowRanges> currentRowRanges_;
 };
 
 } // namespace facebook::velox::parquet
@@ -395,3 +395,74 @@ TEST_F(BloomFilterTest, TestBloomFilterHashes) {
         << "Hash with seed 0 Error: " << i;
   }
 }
+
+TEST_F(BloomFilterTest, FilterValuesTest) {
+  BlockSplitBloomFilter bigintBloomFilter(leafPool_.get());
+  bigintBloomFilter.init(1 << 16);
+  BlockSplitBloomFilter intBloomFilter(leafPool_.get());
+  intBloomFilter.init(1 << 16);
+  for (int32_t i = 0; i < 1000; ++i) {
+    bigintBloomFilter.insertHash(bigintBloomFilter.hash(int64_t(i) * 7));
+    intBloomFilter.insertHash(intBloomFilter.hash(-i * 7));
+  }
+  BlockSplitBloomFilter stringBloomFilter(leafPool_.get());
+  stringBloomFilter.init(1 << 16);
+  for (auto i = 0; i < 1000; ++i) {
+    auto value = fmt::format("user-{}", i);
+    ByteArray byteArray(value);
+    stringBloomFilter.insertHash(stringBloomFilter.hash(&byteArray));
+  }
+
+  // Single values.
+  common::BigintRange hit(70, 70, false);
+  common::BigintRange miss(71, 71, false);
+  EXPECT_TRUE(testBloomFilter(hit, bigintBloomFilter, thrift::Type::INT64));
+  EXPECT_FALSE(testBloomFilter(miss, bigintBloomFilter, thrift::Type::INT64));
+  common::BigintRange intHit(-70, -70, false);
+  EXPECT_TRUE(testBloomFilter(intHit, intBloomFilter, thrift::Type::INT32));
+  EXPECT_FALSE(testBloomFilter(intHit, intBloomFilter, thrift::Type::INT64));
+
+  // IN lists, both hash table and bitmask based.
+  auto sparseMiss =
+      common::createBigintValues({1'000'001, 2'000'003, 3'000'005}, false);
+  EXPECT_FALSE(
+      testBloomFilter(*sparseMiss, bigintBloomFilter, thrift::Type::INT64));
+  auto sparseHit =
+      common::createBigintValues({1'000'001, 2'000'003, 6993}, false);
+  EXPECT_TRUE(
+      testBloomFilter(*sparseHit, bigintBloomFilter, thrift::Type::INT64));
+  auto denseMiss = common::createBigintValues({1, 2, 3, 4, 5, 6}, false);
+  EXPECT_FALSE(
+      testBloomFilter(*denseMiss, bigintBloomFilter, thrift::Type::INT64));
+  auto denseHit = common::createBigintValues({1, 2, 3, 4, 5, 6, 7}, false);
+  EXPECT_TRUE(
+      testBloomFilter(*denseHit, bigintBloomFilter, thrift::Type::INT64));
+
+  // Values out of the 32 bit range cannot be in an INT32 column.
+  auto outOfRange = common::createBigintValues(
+      {std::numeric_limits<int64_t>::min(), 1LL << 40}, false);
+  EXPECT_FALSE(
+      testBloomFilter(*outOfRange, intBloomFilter, thrift::Type::INT32));
+
+  // Strings.
+  common::BytesRange stringHit(
+      "user-17", false, false, "user-17", false, false, false);
+  EXPECT_TRUE(
+      testBloomFilter(stringHit, stringBloomFilter, thrift::Type::BYTE_ARRAY));
+  common::BytesValues stringMiss({"user-1000", "user-1001", "admin"}, false);
+  EXPECT_FALSE(
+      testBloomFilter(stringMiss, stringBloomFilter, thrift::Type::BYTE_ARRAY));
+  common::BytesValues stringIn({"user-1000", "user-999"}, false);
+  EXPECT_TRUE(
+      testBloomFilter(stringIn, stringBloomFilter, thrift::Type::BYTE_ARRAY));
+
+  // Filters that pass nulls, ranges and mismatching physical types are not
+  // checked.
+  auto nullAllowed = common::createBigintValues({1, 2, 3}, true);
+  EXPECT_TRUE(
+      testBloomFilter(*nullAllowed, bigintBloomFilter, thrift::Type::INT64));
+  common::BigintRange range(1, 6, false);
+  EXPECT_TRUE(testBloomFilter(range, bigintBloomFilter, thrift::Type::INT64));
+  EXPECT_TRUE(
+      testBloomFilter(stringMiss, stringBloomFilter, thrift::Type::INT64));
+}
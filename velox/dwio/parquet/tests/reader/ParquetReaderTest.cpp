@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -1161,6 +1163,87 @@ TEST_F(ParquetReaderTest, filterRowGroups) {
   EXPECT_EQ(reader->numberOfRows(), 10ULL);
 }
 
+TEST_F(ParquetReaderTest, bloomFilterRowGroups) {
+  // bloom_filter.parquet has one column a: BIGINT in 3 row groups of 100 rows
+  // with min/max statistics and a Bloom filter each. Row group i has the even
+  // numbers from i * 1'000 to i * 1'000 + 198. bloom_filter_no_length.parquet
+  // has the same data but does not record the sizes of the Bloom filters in
+  // the column chunk metadata.
+  auto rowType = ROW({"a"}, {BIGINT()});
+  // The numbers of row groups read and skipped.
+  using Strides = std::pair<int64_t, int64_t>;
+  const auto read = [&](const std::string& fileName,
+                        std::unique_ptr<Filter> filter,
+                        bool bloomFilterEnabled,
+                        const std::vector<int64_t>& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setFooterEstimatedSize(1'024);
+    readerOptions.setBloomFilterEnabled(bloomFilterEnabled);
+    auto reader = createReader(getExampleFilePath(fileName), readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 300);
+
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(std::move(filter));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<int64_t> values;
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    while (rowReader->next(1'000, result) > 0) {
+      auto* column =
+          result->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < result->size(); ++i) {
+        values.push_back(column->valueAt(i));
+      }
+    }
+    EXPECT_EQ(values, expected);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return Strides(stats.processedStrides, stats.skippedStrides);
+  };
+
+  for (const auto& fileName :
+       {"bloom_filter.parquet", "bloom_filter_no_length.parquet"}) {
+    SCOPED_TRACE(fileName);
+    // 1'001 is in the range of the second row group but not in the data. Only
+    // the Bloom filter skips that row group.
+    ASSERT_EQ(
+        read(
+            fileName,
+            std::make_unique<BigintRange>(1'001, 1'001, false),
+            false,
+            {}),
+        Strides(1, 2));
+    ASSERT_EQ(
+        read(
+            fileName,
+            std::make_unique<BigintRange>(1'001, 1'001, false),
+            true,
+            {}),
+        Strides(0, 3));
+
+    // The Bloom filter of the row group with the value matches.
+    ASSERT_EQ(
+        read(
+            fileName,
+            std::make_unique<BigintRange>(1'002, 1'002, false),
+            true,
+            {1'002}),
+        Strides(1, 2));
+
+    // An IN list is checked value by value. 1'003 is not in the second row
+    // group and 2'198 is in the third one.
+    ASSERT_EQ(
+        read(
+            fileName,
+            createBigintValues({500, 1'003, 2'198}, false),
+            true,
+            {2'198}),
+        Strides(1, 2));
+  }
+}
+
 TEST_F(ParquetReaderTest, parseLongTagged) {
   // This is a case for long with annonation read
   const std::string sample(getExampleFilePath("tagged_long.parquet"));
@@ -1266,6 +1349,136 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  auto rowType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
+  constexpr int64_t kRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<double>(kRows, [](auto row) { return row * 0.5; }),
+  });
+
+  // Write small pages with a page index so that a selective filter on the
+  // sorted column 'a' matches few pages.
+  const auto filePath =
+      fmt::format("{}/page_index.parquet", tempPath_->getPath());
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.batchSize = 100;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 5'000; }),
+      makeFlatVector<double>(
+          100, [](auto row) { return (row + 5'000) * 0.5; }),
+  });
+
+  const auto readFiltered = [&](bool pageIndexFilterEnabled,
+                                RuntimeStatistics& stats) {
+    auto file = std::make_shared<LocalReadFile>(filePath);
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFilePreloadThreshold(0);
+    readerOptions.setFooterEstimatedSize(1'024);
+    readerOptions.setPageIndexFilterEnabled(pageIndexFilterEnabled);
+    auto reader = std::make_unique<ParquetReader>(
+        std::make_unique<BufferedInput>(file, *leafPool_), readerOptions);
+
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("a")->setFilter(
+        std::make_unique<BigintRange>(5'000, 5'099, false));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+    rowReader->updateRuntimeStats(stats);
+    return file->bytesRead();
+  };
+
+  RuntimeStatistics stats;
+  const auto bytesReadWithoutPageIndex = readFiltered(false, stats);
+  EXPECT_EQ(stats.skippedPageRows, 0);
+
+  RuntimeStatistics pageIndexStats;
+  const auto bytesReadWithPageIndex = readFiltered(true, pageIndexStats);
+  EXPECT_GT(pageIndexStats.skippedPageRows, kRows / 2);
+  EXPECT_LT(pageIndexStats.skippedPageRows, kRows - 100);
+  EXPECT_LT(bytesReadWithPageIndex, bytesReadWithoutPageIndex);
+}
+
+TEST_F(ParquetReaderTest, readAheadPages) {
+  auto rowType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  constexpr int64_t kRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows,
+          [](auto row) { return fmt::format("value {}", row % 1'000); },
+          [](auto row) { return row % 11 == 0; }),
+  });
+
+  // Write many small compressed pages per column chunk.
+  const auto filePath =
+      fmt::format("{}/read_ahead.parquet", tempPath_->getPath());
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = rootPool_.get();
+  writerOptions.compressionKind = common::CompressionKind::CompressionKind_ZSTD;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.batchSize = 100;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), writerOptions, rowType);
+  writer->write(data);
+  writer->close();
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  const auto read = [&](int32_t readAheadPages,
+                        uint64_t readAheadBytes,
+                        std::unique_ptr<common::Filter> filter,
+                        const RowVectorPtr& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setReadAheadPages(readAheadPages);
+    readerOptions.setReadAheadBytes(readAheadBytes);
+    auto reader = createReader(filePath, readerOptions);
+
+    auto scanSpec = makeScanSpec(rowType);
+    if (filter) {
+      scanSpec->childByName("a")->setFilter(std::move(filter));
+    }
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    rowReaderOpts.setDecodingExecutor(executor);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.columnReaderStatistics.readAheadPages;
+  };
+
+  EXPECT_EQ(read(0, 0, nullptr, data), 0);
+  EXPECT_GT(read(4, 8 << 20, nullptr, data), 0);
+  // A byte limit below the page size still reads one page ahead.
+  EXPECT_GT(read(4, 1, nullptr, data), 0);
+
+  // The pages before the filtered range are skipped.
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 9'000; }),
+      makeFlatVector<std::string>(
+          100,
+          [](auto row) { return fmt::format("value {}", row % 1'000); },
+          [](auto row) { return (row + 9'000) % 11 == 0; }),
+  });
+  EXPECT_GT(
+      read(
+          2,
+          8 << 20,
+          std::make_unique<BigintRange>(9'000, 9'099, false),
+          expected),
+      0);
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -427,6 +427,72 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, nativeWrite) {
+  const auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6"},
+          {INTEGER(),
+           VARCHAR(),
+           BIGINT(),
+           DOUBLE(),
+           BOOLEAN(),
+           SMALLINT(),
+           DATE()});
+  constexpr vector_size_t kRows = 1'000;
+  const auto data = makeRowVector(
+      schema->names(),
+      {
+          makeFlatVector<int32_t>(
+              kRows, [](auto row) { return row; }, nullEvery(7)),
+          wrapInDictionary(
+              makeIndicesInReverse(kRows),
+              makeFlatVector<std::string>(
+                  kRows,
+                  [](auto row) {
+                    return fmt::format("a long string value {}", row % 13);
+                  },
+                  nullEvery(5))),
+          makeConstant<int64_t>(42, kRows),
+          makeNullConstant(TypeKind::DOUBLE, kRows),
+          makeFlatVector<bool>(
+              kRows, [](auto row) { return row % 3 == 0; }, nullEvery(11)),
+          BaseVector::wrapInDictionary(
+              makeNulls(kRows, nullEvery(6)),
+              makeIndices(kRows, [](auto row) { return row / 2; }),
+              kRows,
+              makeFlatVector<int16_t>(kRows, [](auto row) { return row; })),
+          makeFlatVector<int32_t>(
+              kRows, [](auto row) { return row * 10; }, nullptr, DATE()),
+      });
+
+  for (const bool enableNativeWrite : {false, true}) {
+    SCOPED_TRACE(fmt::format("enableNativeWrite {}", enableNativeWrite));
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    parquet::WriterOptions writerOptions;
+    writerOptions.memoryPool = leafPool_.get();
+    writerOptions.enableNativeWrite = enableNativeWrite;
+    writerOptions.flushPolicyFactory = [] {
+      return std::make_unique<DefaultFlushPolicy>(300, 1L << 30);
+    };
+
+    auto writer = std::make_unique<parquet::Writer>(
+        std::move(sink), writerOptions, rootPool_, schema);
+    writer->write(data);
+    writer->close();
+
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_EQ(reader->numberOfRows(), kRows);
+    ASSERT_EQ(reader->fileMetaData().numRowGroups(), 4);
+    ASSERT_EQ(*reader->rowType(), *schema);
+
+    auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+    assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+  }
+}
+
 TEST_F(ParquetWriterTest, testPageSizeAndBatchSizeConfiguration) {
   const auto schema = ROW({"c0"}, {SMALLINT()});
   constexpr int64_t kRows = 10'000;
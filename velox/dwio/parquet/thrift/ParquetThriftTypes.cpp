@@ -4770,6 +4770,11 @@ void ColumnMetaData::__set_bloom_filter_offset(const int64_t val) {
   this->bloom_filter_offset = val;
   __isset.bloom_filter_offset = true;
 }
+
+void ColumnMetaData::__set_bloom_filter_length(const int32_t val) {
+  this->bloom_filter_length = val;
+  __isset.bloom_filter_length = true;
+}
 std::ostream& operator<<(std::ostream& out, const ColumnMetaData& obj) {
   obj.printTo(out);
   return out;
@@ -4963,6 +4968,14 @@ uint32_t ColumnMetaData::read(::apache::thrift::protocol::TProtocol* iprot) {
           xfer += iprot->skip(ftype);
         }
         break;
+      case 15:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->bloom_filter_length);
+          this->__isset.bloom_filter_length = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
       default:
         xfer += iprot->skip(ftype);
         break;
@@ -5114,6 +5127,12 @@ uint32_t ColumnMetaData::write(
     xfer += oprot->writeI64(this->bloom_filter_offset);
     xfer += oprot->writeFieldEnd();
   }
+  if (this->__isset.bloom_filter_length) {
+    xfer += oprot->writeFieldBegin(
+        "bloom_filter_length", ::apache::thrift::protocol::T_I32, 15);
+    xfer += oprot->writeI32(this->bloom_filter_length);
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
@@ -5135,6 +5154,7 @@ void swap(ColumnMetaData& a, ColumnMetaData& b) {
   swap(a.statistics, b.statistics);
   swap(a.encoding_stats, b.encoding_stats);
   swap(a.bloom_filter_offset, b.bloom_filter_offset);
+  swap(a.bloom_filter_length, b.bloom_filter_length);
   swap(a.__isset, b.__isset);
 }
 
@@ -5153,6 +5173,7 @@ ColumnMetaData::ColumnMetaData(const ColumnMetaData& other108) {
   statistics = other108.statistics;
   encoding_stats = other108.encoding_stats;
   bloom_filter_offset = other108.bloom_filter_offset;
+  bloom_filter_length = other108.bloom_filter_length;
   __isset = other108.__isset;
 }
 ColumnMetaData& ColumnMetaData::operator=(const ColumnMetaData& other109) {
@@ -5170,6 +5191,7 @@ ColumnMetaData& ColumnMetaData::operator=(const ColumnMetaData& other109) {
   statistics = other109.statistics;
   encoding_stats = other109.encoding_stats;
   bloom_filter_offset = other109.bloom_filter_offset;
+  bloom_filter_length = other109.bloom_filter_length;
   __isset = other109.__isset;
   return *this;
 }
@@ -5202,6 +5224,9 @@ void ColumnMetaData::printTo(std::ostream& out) const {
   out << ", " << "bloom_filter_offset=";
   (__isset.bloom_filter_offset ? (out << to_string(bloom_filter_offset))
                                : (out << "<null>"));
+  out << ", " << "bloom_filter_length=";
+  (__isset.bloom_filter_length ? (out << to_string(bloom_filter_length))
+                               : (out << "<null>"));
   out << ")";
 }
 
@@ -2421,13 +2421,15 @@ typedef struct _ColumnMetaData__isset {
         dictionary_page_offset(false),
         statistics(false),
         encoding_stats(false),
-        bloom_filter_offset(false) {}
+        bloom_filter_offset(false),
+        bloom_filter_length(false) {}
   bool key_value_metadata : 1;
   bool index_page_offset : 1;
   bool dictionary_page_offset : 1;
   bool statistics : 1;
   bool encoding_stats : 1;
   bool bloom_filter_offset : 1;
+  bool bloom_filter_length : 1;
 } _ColumnMetaData__isset;
 
 /**
@@ -2446,7 +2448,8 @@ class ColumnMetaData : public virtual ::apache::thrift::TBase {
         data_page_offset(0),
         index_page_offset(0),
         dictionary_page_offset(0),
-        bloom_filter_offset(0) {}
+        bloom_filter_offset(0),
+        bloom_filter_length(0) {}
 
   virtual ~ColumnMetaData() noexcept;
   /**
@@ -2514,6 +2517,14 @@ class ColumnMetaData : public virtual ::apache::thrift::TBase {
    * Byte offset from beginning of file to Bloom filter data. *
    */
   int64_t bloom_filter_offset;
+  /**
+   * Size of Bloom filter data including the serialized header, in bytes.
+   * Added in 2.10 so readers may not read this field from old files and
+   * it can be obtained after the BloomFilterHeader has been deserialized.
+   * Writers should write this field so readers can read the bloom filter
+   * in a single I/O.
+   */
+  int32_t bloom_filter_length;
 
   _ColumnMetaData__isset __isset;
 
@@ -2545,6 +2556,8 @@ class ColumnMetaData : public virtual ::apache::thrift::TBase {
 
   void __set_bloom_filter_offset(const int64_t val);
 
+  void __set_bloom_filter_length(const int32_t val);
+
   bool operator==(const ColumnMetaData& rhs) const {
     if (!(type == rhs.type))
       return false;
@@ -2594,6 +2607,12 @@ class ColumnMetaData : public virtual ::apache::thrift::TBase {
         __isset.bloom_filter_offset &&
         !(bloom_filter_offset == rhs.bloom_filter_offset))
       return false;
+    if (__isset.bloom_filter_length != rhs.__isset.bloom_filter_length)
+      return false;
+    else if (
+        __isset.bloom_filter_length &&
+        !(bloom_filter_length == rhs.bloom_filter_length))
+      return false;
     return true;
   }
   bool operator!=(const ColumnMetaData& rhs) const {
@@ -17,19 +17,26 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
 #include <arrow/table.h>
 #include "velox/common/base/Pointers.h"
 #include "velox/common/config/Config.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::ArrowWriterProperties;
+using facebook::velox::parquet::arrow::ColumnWriter;
 using facebook::velox::parquet::arrow::Compression;
+using facebook::velox::parquet::arrow::TypedColumnWriter;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
@@ -97,7 +104,93 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// Adapts a Velox memory pool to the Arrow MemoryPool interface so that the
+// buffers of the Parquet column writers are accounted to the writer's pool.
+// Allocation failures surface as Velox exceptions like any other allocation
+// of the writer.
+class ArrowMemoryPool : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPool(memory::MemoryPool& pool) : pool_(pool) {}
+
+  using ::arrow::MemoryPool::Allocate;
+  using ::arrow::MemoryPool::Free;
+  using ::arrow::MemoryPool::Reallocate;
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    *out = reinterpret_cast<uint8_t*>(
+        pool_.allocate(size, static_cast<uint32_t>(alignment)));
+    bytesAllocated_ += size;
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    if (*ptr == zeroSizeArea()) {
+      return Allocate(newSize, alignment, ptr);
+    }
+    if (newSize == 0) {
+      Free(*ptr, oldSize, alignment);
+      *ptr = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    VELOX_CHECK_LE(alignment, pool_.alignment());
+    *ptr = reinterpret_cast<uint8_t*>(pool_.reallocate(*ptr, oldSize, newSize));
+    bytesAllocated_ += newSize - oldSize;
+    totalBytesAllocated_ += std::max<int64_t>(newSize - oldSize, 0);
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (buffer == zeroSizeArea()) {
+      return;
+    }
+    pool_.free(buffer, size);
+    bytesAllocated_ -= size;
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytesAllocated_;
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  // Returned for zero-size allocations, like Arrow's own pools do.
+  static uint8_t* zeroSizeArea() {
+    alignas(memory::MemoryAllocator::kMaxAlignment) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool& pool_;
+  std::atomic<int64_t> bytesAllocated_{0};
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
 struct ArrowContext {
+  // Declared first so that it outlives everything allocated from it.
+  std::unique_ptr<ArrowMemoryPool> pool;
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
   std::shared_ptr<WriterProperties> properties;
@@ -105,6 +198,12 @@ struct ArrowContext {
   int64_t stagingBytes = 0;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // columns, Vectors staged by the native write path.
+  std::vector<std::vector<VectorPtr>> stagingVectors;
+  // Scratch for the definition levels and the gathered values of the native
+  // write path.
+  BufferPtr levels;
+  BufferPtr values;
 };
 
 Compression::type getArrowParquetCompression(
@@ -128,9 +227,11 @@ namespace {
 
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
-    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
+    const std::unique_ptr<DefaultFlushPolicy>& flushPolicy,
+    ::arrow::MemoryPool* pool) {
   auto builder = WriterProperties::Builder();
   WriterProperties::Builder* properties = &builder;
+  properties = properties->memory_pool(pool);
   if (options.enableDictionary.value_or(
           facebook::velox::parquet::arrow::DEFAULT_IS_DICTIONARY_ENABLED)) {
     properties = properties->enable_dictionary();
@@ -157,6 +258,10 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
   properties = properties->enable_store_decimal_as_integer();
+  if (options.enablePageIndex.value_or(
+          facebook::velox::parquet::arrow::DEFAULT_IS_PAGE_INDEX_ENABLED)) {
+    properties = properties->enable_write_page_index();
+  }
   if (options.useParquetDataPageV2.value_or(false)) {
     properties =
         properties->data_page_version(arrow::ParquetDataPageVersion::V2);
@@ -306,6 +411,255 @@ std::optional<int64_t> getParquetBatchSize(
   return std::nullopt;
 }
 
+std::optional<bool> isParquetEnableNativeWrite(
+    const config::ConfigBase& config,
+    const char* configKey) {
+  try {
+    if (const auto enableNativeWrite = config.get<bool>(configKey)) {
+      return enableNativeWrite.value();
+    }
+  } catch (const folly::ConversionError& e) {
+    VELOX_USER_FAIL(
+        "Invalid parquet writer enable native write option: {}", e.what());
+  }
+  return std::nullopt;
+}
+
+// Returns true if columns of 'type' can be encoded without the Arrow bridge.
+// Decimals, intervals and other custom types share the kind of these types
+// but are exported to different Arrow types, so the types must match exactly.
+bool isNativeWriteSupported(const Type& type) {
+  return type == *BOOLEAN() || type == *TINYINT() || type == *SMALLINT() ||
+      type == *INTEGER() || type.isDate() || type == *BIGINT() ||
+      type == *REAL() || type == *DOUBLE() || type == *VARCHAR() ||
+      type == *VARBINARY();
+}
+
+// Returns the Arrow type that exportToArrow() produces for 'type', which must
+// be supported by isNativeWriteSupported().
+std::shared_ptr<::arrow::DataType> toNativeWriteArrowType(const Type& type) {
+  if (type.isDate()) {
+    return ::arrow::date32();
+  }
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      return ::arrow::boolean();
+    case TypeKind::TINYINT:
+      return ::arrow::int8();
+    case TypeKind::SMALLINT:
+      return ::arrow::int16();
+    case TypeKind::INTEGER:
+      return ::arrow::int32();
+    case TypeKind::BIGINT:
+      return ::arrow::int64();
+    case TypeKind::REAL:
+      return ::arrow::float32();
+    case TypeKind::DOUBLE:
+      return ::arrow::float64();
+    case TypeKind::VARCHAR:
+      return ::arrow::utf8();
+    case TypeKind::VARBINARY:
+      return ::arrow::binary();
+    default:
+      VELOX_UNREACHABLE("Unsupported native write type: {}", type.toString());
+  }
+}
+
+// Returns space for 'size' values of T in 'buffer', reallocating it from
+// 'pool' if it is too small.
+template <typename T>
+T* scratch(BufferPtr& buffer, int64_t size, memory::MemoryPool* pool) {
+  const auto bytes = size * sizeof(T);
+  if (!buffer || buffer->capacity() < bytes) {
+    buffer = AlignedBuffer::allocate<char>(bytes, pool);
+  }
+  return buffer->asMutable<T>();
+}
+
+// Writes rows [begin, end) of 'decoded' into 'writer'. Flat values that have
+// the layout of the Parquet physical type are passed without a copy, together
+// with the Velox null bitmap, which has the same bit order as Arrow's validity
+// bitmap. Other values are gathered densely into 'values' first.
+template <typename DType, typename T>
+void writeValues(
+    DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end,
+    const int16_t* defLevels,
+    TypedColumnWriter<DType>& writer,
+    BufferPtr& values,
+    memory::MemoryPool* pool) {
+  using ParquetT = typename DType::c_type;
+  const auto numRows = end - begin;
+  if constexpr (std::is_same_v<T, ParquetT> && !std::is_same_v<T, bool>) {
+    if (decoded.isIdentityMapping()) {
+      const auto* rawValues = decoded.data<T>() + begin;
+      if (decoded.mayHaveNulls()) {
+        writer.WriteBatchSpaced(
+            numRows,
+            defLevels,
+            nullptr,
+            reinterpret_cast<const uint8_t*>(decoded.nulls()),
+            begin,
+            rawValues);
+      } else {
+        writer.WriteBatch(numRows, defLevels, nullptr, rawValues);
+      }
+      return;
+    }
+  }
+  auto* rawValues = scratch<ParquetT>(values, numRows, pool);
+  vector_size_t numValues = 0;
+  for (auto row = begin; row < end; ++row) {
+    if (decoded.isNullAt(row)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = decoded.valueAt<StringView>(row);
+      rawValues[numValues++] = ParquetT(
+          value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+    } else {
+      rawValues[numValues++] = decoded.valueAt<T>(row);
+    }
+  }
+  writer.WriteBatch(numRows, defLevels, nullptr, rawValues);
+}
+
+template <typename DType>
+TypedColumnWriter<DType>& asTypedWriter(ColumnWriter* writer) {
+  auto* typedWriter = dynamic_cast<TypedColumnWriter<DType>*>(writer);
+  VELOX_CHECK_NOT_NULL(typedWriter, "Unexpected Parquet column writer type");
+  return *typedWriter;
+}
+
+// Writes rows [begin, end) of 'decoded' into the column chunk of 'writer'.
+void writeRows(
+    DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end,
+    ColumnWriter* writer,
+    ArrowContext& context,
+    memory::MemoryPool* pool) {
+  int16_t* defLevels = nullptr;
+  if (writer->descr()->max_definition_level() > 0) {
+    defLevels = scratch<int16_t>(context.levels, end - begin, pool);
+    for (auto row = begin; row < end; ++row) {
+      defLevels[row - begin] = decoded.isNullAt(row) ? 0 : 1;
+    }
+  }
+  auto& values = context.values;
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::BOOLEAN:
+      return writeValues<arrow::BooleanType, bool>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::BooleanType>(writer),
+          values,
+          pool);
+    case TypeKind::TINYINT:
+      return writeValues<arrow::Int32Type, int8_t>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::Int32Type>(writer),
+          values,
+          pool);
+    case TypeKind::SMALLINT:
+      return writeValues<arrow::Int32Type, int16_t>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::Int32Type>(writer),
+          values,
+          pool);
+    case TypeKind::INTEGER:
+      return writeValues<arrow::Int32Type, int32_t>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::Int32Type>(writer),
+          values,
+          pool);
+    case TypeKind::BIGINT:
+      return writeValues<arrow::Int64Type, int64_t>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::Int64Type>(writer),
+          values,
+          pool);
+    case TypeKind::REAL:
+      return writeValues<arrow::FloatType, float>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::FloatType>(writer),
+          values,
+          pool);
+    case TypeKind::DOUBLE:
+      return writeValues<arrow::DoubleType, double>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::DoubleType>(writer),
+          values,
+          pool);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return writeValues<arrow::ByteArrayType, StringView>(
+          decoded,
+          begin,
+          end,
+          defLevels,
+          asTypedWriter<arrow::ByteArrayType>(writer),
+          values,
+          pool);
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type for native Parquet write: {}",
+          decoded.base()->type()->toString());
+  }
+}
+
+// Writes 'numRows' rows starting at row 'offset' of the staged 'vectors' of a
+// column into the column chunk of 'writer'.
+void writeColumnChunk(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t numRows,
+    ColumnWriter* writer,
+    ArrowContext& context,
+    memory::MemoryPool* pool) {
+  const auto endRow = offset + numRows;
+  int64_t vectorOffset = 0;
+  for (const auto& vector : vectors) {
+    if (vectorOffset >= endRow) {
+      break;
+    }
+    const auto begin = std::max(offset, vectorOffset);
+    const auto end = std::min<int64_t>(endRow, vectorOffset + vector->size());
+    if (begin < end) {
+      DecodedVector decoded(*vector);
+      writeRows(
+          decoded,
+          begin - vectorOffset,
+          end - vectorOffset,
+          writer,
+          context,
+          pool);
+    }
+    vectorOffset += vector->size();
+  }
+}
+
 } // namespace
 
 Writer::Writer(
@@ -334,10 +688,17 @@ Writer::Writer(
   options_.timestampTimeZone = options.parquetWriteTimestampTimeZone;
   common::testutil::TestValue::adjust(
       "facebook::velox::parquet::Writer::Writer", &options_);
-  arrowContext_->properties =
-      getArrowParquetWriterOptions(options, flushPolicy_);
+  arrowContext_->pool = std::make_unique<ArrowMemoryPool>(*generalPool_);
+  arrowContext_->properties = getArrowParquetWriterOptions(
+      options, flushPolicy_, arrowContext_->pool.get());
   setMemoryReclaimers();
   writeInt96AsTimestamp_ = options.writeInt96AsTimestamp;
+  if (options.enableNativeWrite.value_or(false)) {
+    nativeWrite_ = std::all_of(
+        schema_->children().begin(),
+        schema_->children().end(),
+        [](const auto& type) { return isNativeWriteSupported(*type); });
+  }
 }
 
 Writer::Writer(
@@ -364,37 +725,64 @@ void Writer::flush() {
           arrowContext_->writer,
           FileWriter::Open(
               *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
+              arrowContext_->pool.get(),
               stream_,
               arrowContext_->properties,
               arrowProperties));
     }
 
-    auto fields = arrowContext_->schema->fields();
-    std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
-    for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
-      auto dataType = fields.at(colIdx)->type();
-      auto chunk =
-          ::arrow::ChunkedArray::Make(
-              std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
-              .ValueOrDie();
-      chunks.push_back(chunk);
+    if (nativeWrite_) {
+      flushNative();
+    } else {
+      auto fields = arrowContext_->schema->fields();
+      std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
+      for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+        auto dataType = fields.at(colIdx)->type();
+        auto chunk =
+            ::arrow::ChunkedArray::Make(
+                std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
+                .ValueOrDie();
+        chunks.push_back(chunk);
+      }
+      auto table = ::arrow::Table::Make(
+          arrowContext_->schema,
+          std::move(chunks),
+          static_cast<int64_t>(arrowContext_->stagingRows));
+      PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
+          *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
     }
-    auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
-        std::move(chunks),
-        static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
     }
+    for (auto& vectors : arrowContext_->stagingVectors) {
+      vectors.clear();
+    }
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
   }
 }
 
+void Writer::flushNative() {
+  const auto numRows = static_cast<int64_t>(arrowContext_->stagingRows);
+  const auto rowsInRowGroup =
+      static_cast<int64_t>(flushPolicy_->rowsInRowGroup());
+  for (int64_t offset = 0; offset < numRows; offset += rowsInRowGroup) {
+    const auto rowGroupRows = std::min(rowsInRowGroup, numRows - offset);
+    PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(rowGroupRows));
+    auto* rowGroupWriter = arrowContext_->writer->row_group_writer();
+    for (const auto& vectors : arrowContext_->stagingVectors) {
+      writeColumnChunk(
+          vectors,
+          offset,
+          rowGroupRows,
+          rowGroupWriter->NextColumn(),
+          *arrowContext_,
+          generalPool_.get());
+    }
+  }
+}
+
 dwio::common::StripeProgress getStripeProgress(
     uint64_t stagingRows,
     int64_t stagingBytes) {
@@ -415,6 +803,11 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  if (nativeWrite_) {
+    writeNative(data);
+    return;
+  }
+
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
@@ -459,6 +852,40 @@ void Writer::write(const VectorPtr& data) {
   arrowContext_->stagingBytes += bytes;
 }
 
+void Writer::writeNative(const VectorPtr& data) {
+  if (!arrowContext_->schema) {
+    // The Arrow schema is still needed to open the Parquet file writer. The
+    // natively written types are all primitive so it is built from 'schema_'.
+    std::vector<std::shared_ptr<::arrow::Field>> fields;
+    fields.reserve(schema_->size());
+    for (auto i = 0; i < schema_->size(); ++i) {
+      fields.push_back(::arrow::field(
+          schema_->nameOf(i), toNativeWriteArrowType(*schema_->childAt(i))));
+    }
+    arrowContext_->schema = ::arrow::schema(std::move(fields));
+    arrowContext_->stagingVectors.resize(schema_->size());
+  }
+
+  auto input = BaseVector::loadedVectorShared(data);
+  if (input->encoding() != VectorEncoding::Simple::ROW) {
+    BaseVector::flattenVector(input);
+  }
+  auto bytes = data->estimateFlatSize();
+  auto numRows = data->size();
+  if (flushPolicy_->shouldFlush(getStripeProgress(
+          arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+    flush();
+  }
+
+  const auto& children = input->asUnchecked<RowVector>()->children();
+  for (auto i = 0; i < children.size(); ++i) {
+    arrowContext_->stagingVectors[i].push_back(
+        BaseVector::loadedVectorShared(children[i]));
+  }
+  arrowContext_->stagingRows += numRows;
+  arrowContext_->stagingBytes += bytes;
+}
+
 bool Writer::isCodecAvailable(common::CompressionKind compression) {
   return arrow::util::Codec::IsAvailable(
       getArrowParquetCompression(compression));
@@ -478,6 +905,7 @@ void Writer::close() {
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -578,6 +1006,15 @@ void WriterOptions::processConfigs(
         : getParquetBatchSize(
               connectorConfig, kParquetHiveConnectorWriteBatchSize);
   }
+
+  if (!enableNativeWrite) {
+    enableNativeWrite =
+        isParquetEnableNativeWrite(session, kParquetSessionEnableNativeWrite);
+    if (!enableNativeWrite) {
+      enableNativeWrite = isParquetEnableNativeWrite(
+          connectorConfig, kParquetHiveConnectorEnableNativeWrite);
+    }
+  }
 }
 
 } // namespace facebook::velox::parquet
@@ -111,6 +111,14 @@ struct WriterOptions : public dwio::common::WriterOptions {
   std::optional<int64_t> dictionaryPageSizeLimit;
   std::optional<bool> enableDictionary;
   std::optional<bool> useParquetDataPageV2;
+  /// Writes the ColumnIndex and OffsetIndex of the column chunks. Readers use
+  /// them to skip pages.
+  std::optional<bool> enablePageIndex;
+  /// Encodes flat, dictionary and constant vectors straight into the Parquet
+  /// column writers instead of exporting them through the Arrow bridge first.
+  /// Applies only to schemas whose columns are all booleans, integers, dates,
+  /// floating points or strings; other schemas always use the Arrow bridge.
+  std::optional<bool> enableNativeWrite;
 
   // Parsing session and hive configs.
 
@@ -140,6 +148,10 @@ struct WriterOptions : public dwio::common::WriterOptions {
       "hive.parquet.writer.batch_size";
   static constexpr const char* kParquetHiveConnectorWriteBatchSize =
       "hive.parquet.writer.batch-size";
+  static constexpr const char* kParquetSessionEnableNativeWrite =
+      "hive.parquet.writer.enable_native_write";
+  static constexpr const char* kParquetHiveConnectorEnableNativeWrite =
+      "hive.parquet.writer.enable-native-write";
 
   // Process hive connector and session configs.
   void processConfigs(
@@ -193,6 +205,13 @@ class Writer : public dwio::common::Writer {
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
 
+  // Stages the columns of 'data' as Velox vectors for flushNative().
+  void writeNative(const VectorPtr& data);
+
+  // Encodes the staged vectors directly into the Parquet column writers, one
+  // row group per 'rowsInRowGroup' rows.
+  void flushNative();
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -210,6 +229,10 @@ class Writer : public dwio::common::Writer {
 
   // Whether to write Int96 timestamps in Arrow Parquet write.
   bool writeInt96AsTimestamp_;
+
+  // Whether the vectors are written without the Arrow bridge. Set if
+  // 'enableNativeWrite' is on and all the columns of 'schema_' are supported.
+  bool nativeWrite_{false};
 };
 
 class ParquetWriterFactory : public dwio::common::WriterFactory {
@@ -986,6 +986,16 @@ void ByteStreamSplitEncoder<DoubleType>::Put(const ::arrow::Array& values) {
   PutImpl<::arrow::DoubleType>(values);
 }
 
+template <>
+void ByteStreamSplitEncoder<Int32Type>::Put(const ::arrow::Array& values) {
+  PutImpl<::arrow::Int32Type>(values);
+}
+
+template <>
+void ByteStreamSplitEncoder<Int64Type>::Put(const ::arrow::Array& values) {
+  PutImpl<::arrow::Int64Type>(values);
+}
+
 template <typename DType>
 void ByteStreamSplitEncoder<DType>::PutSpaced(
     const T* src,
@@ -4182,9 +4192,13 @@ std::unique_ptr<Encoder> MakeEncoder(
       case Type::DOUBLE:
         return std::make_unique<ByteStreamSplitEncoder<DoubleType>>(
             descr, pool);
+      case Type::INT32:
+        return std::make_unique<ByteStreamSplitEncoder<Int32Type>>(descr, pool);
+      case Type::INT64:
+        return std::make_unique<ByteStreamSplitEncoder<Int64Type>>(descr, pool);
       default:
         throw ParquetException(
-            "BYTE_STREAM_SPLIT only supports FLOAT and DOUBLE");
+            "BYTE_STREAM_SPLIT only supports FLOAT, DOUBLE, INT32 and INT64");
     }
   } else if (encoding == Encoding::DELTA_BINARY_PACKED) {
     switch (type_num) {
@@ -344,6 +344,10 @@ class FileWriterImpl : public FileWriter {
     return Status::OK();
   }
 
+  RowGroupWriter* row_group_writer() const override {
+    return row_group_writer_;
+  }
+
   Status Close() override {
     if (!closed_) {
       // Make idempotent
@@ -38,6 +38,7 @@ namespace facebook::velox::parquet::arrow {
 
 class FileMetaData;
 class ParquetFileWriter;
+class RowGroupWriter;
 
 namespace arrow {
 
@@ -115,6 +116,11 @@ class PARQUET_EXPORT FileWriter {
   /// \param chunk_size the number of rows in the next row group.
   virtual ::arrow::Status NewRowGroup(int64_t chunk_size) = 0;
 
+  /// \brief Return the row group started by the last NewRowGroup() call, or
+  /// nullptr if none was started. Its columns can be written directly through
+  /// RowGroupWriter::NextColumn() instead of WriteColumnChunk().
+  virtual RowGroupWriter* row_group_writer() const = 0;
+
   /// \brief Write ColumnChunk in row group using an array.
   virtual ::arrow::Status WriteColumnChunk(const ::arrow::Array& data) = 0;
 
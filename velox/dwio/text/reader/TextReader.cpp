@@ -0,0 +1,687 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <folly/Conv.h>
+#include <folly/container/F14Map.h>
+#include <simdjson.h>
+
+#include "velox/common/base/SimdUtil.h"
+#include "velox/common/encode/Base64.h"
+#include "velox/type/TimestampConversion.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+namespace {
+
+// Readable bytes kept after the data in the read buffer, as simdjson requires.
+constexpr uint64_t kPadding = SIMDJSON_PADDING;
+
+// Finds the positions of up to three delimiter characters in a buffer. Like the
+// structural index of simdjson, it compares a SIMD register worth of bytes
+// against all delimiters at a time and collects the set bits of the result.
+class DelimiterIndex {
+ public:
+  explicit DelimiterIndex(std::vector<char> delimiters)
+      : delimiters_(std::move(delimiters)) {
+    VELOX_CHECK(!delimiters_.empty() && delimiters_.size() <= 3);
+    for (auto delimiter : delimiters_) {
+      batches_.push_back(
+          xsimd::broadcast<uint8_t>(static_cast<uint8_t>(delimiter)));
+    }
+  }
+
+  // Appends the positions in [begin, end) of 'data' that hold a delimiter to
+  // 'positions'.
+  void index(
+      const char* data,
+      int64_t begin,
+      int64_t end,
+      std::vector<int64_t>& positions) const {
+    using Batch = xsimd::batch<uint8_t>;
+    auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    auto i = begin;
+    for (; i + static_cast<int64_t>(Batch::size) <= end; i += Batch::size) {
+      const auto batch = Batch::load_unaligned(bytes + i);
+      auto matches = batch == batches_[0];
+      for (auto j = 1; j < batches_.size(); ++j) {
+        matches = matches | (batch == batches_[j]);
+      }
+      using Mask = std::make_unsigned_t<decltype(simd::toBitMask(matches))>;
+      Mask bits = simd::toBitMask(matches);
+      while (bits != 0) {
+        positions.push_back(i + __builtin_ctzll(bits));
+        bits &= bits - 1;
+      }
+    }
+    for (; i < end; ++i) {
+      if (std::find(delimiters_.begin(), delimiters_.end(), data[i]) !=
+          delimiters_.end()) {
+        positions.push_back(i);
+      }
+    }
+  }
+
+ private:
+  const std::vector<char> delimiters_;
+  std::vector<xsimd::batch<uint8_t>> batches_;
+};
+
+bool isSupportedType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool equalsIgnoreCase(std::string_view left, std::string_view right) {
+  return left.size() == right.size() &&
+      std::equal(left.begin(), left.end(), right.begin(), [](char l, char r) {
+           return std::tolower(static_cast<unsigned char>(l)) ==
+               std::tolower(static_cast<unsigned char>(r));
+         });
+}
+
+// Removes the whitespace that simdjson leaves after a raw scalar token.
+std::string_view trimTrailingWhitespace(std::string_view text) {
+  while (!text.empty() &&
+         std::isspace(static_cast<unsigned char>(text.back()))) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// A column of the file that is parsed into 'vector'.
+struct TextColumn {
+  column_index_t channel;
+  TypePtr type;
+  VectorPtr vector;
+};
+
+} // namespace
+
+class TextRowReader::Impl {
+ public:
+  Impl(
+      std::shared_ptr<ReadFile> file,
+      dwio::common::FileFormat format,
+      const RowTypePtr& schema,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options);
+
+  int64_t nextRowNumber() {
+    return hasRow() ? rowsRead_ : kAtEnd;
+  }
+
+  int64_t nextReadSize(uint64_t size) {
+    return hasRow() ? static_cast<int64_t>(size) : kAtEnd;
+  }
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation);
+
+ private:
+  static constexpr int64_t kAtEnd = dwio::common::RowReader::kAtEnd;
+
+  // Returns false if no bytes are left in the buffer or the file.
+  bool hasData() {
+    return pos_ < size_ || readBlock();
+  }
+
+  // Returns true if a row of the split starts at 'pos_'. Skips the row that
+  // straddles the start of the split and the header rows on first call.
+  bool hasRow();
+
+  // Appends the next block of the file to the bytes of the buffer after
+  // 'pos_'. Returns false at end of file.
+  bool readBlock();
+
+  // Returns the row at 'pos_' and moves 'pos_' past its line break. Sets
+  // [firstDelimiter, endDelimiter) to the range of 'positions_' inside the row.
+  // Requires hasData().
+  std::string_view nextRow(size_t& firstDelimiter, size_t& endDelimiter);
+
+  void parseDelimitedRow(
+      std::string_view row,
+      size_t firstDelimiter,
+      size_t endDelimiter,
+      vector_size_t index);
+
+  // Sets the value of 'field' at 'index' from the bytes [begin, end) of the
+  // buffer. 'escaped' is set if the bytes contain escape characters.
+  void setField(
+      column_index_t field,
+      vector_size_t index,
+      int64_t begin,
+      int64_t end,
+      bool escaped);
+
+  void parseJsonRow(std::string_view row, vector_size_t index);
+
+  // Sets the value at 'index' of 'column' to 'text' converted to the column
+  // type, or to null if 'text' does not convert.
+  void setValue(TextColumn& column, vector_size_t index, std::string_view text);
+
+  template <typename T>
+  void
+  setNumber(TextColumn& column, vector_size_t index, std::string_view text);
+
+  memory::MemoryPool& pool_;
+  const std::shared_ptr<ReadFile> file_;
+  const uint64_t fileSize_;
+  const bool json_;
+  const RowTypePtr schema_;
+  const std::string nullString_;
+  const char fieldDelimiter_;
+  const std::optional<char> escapeChar_;
+  const bool lastColumnTakesRest_;
+  const uint64_t splitStart_;
+  // Rows starting at or after this file offset belong to the next split.
+  const uint64_t splitEnd_;
+  const uint64_t skipRows_;
+  // Bytes read from the file at a time.
+  const uint64_t readSize_;
+  std::shared_ptr<common::ScanSpec> scanSpec_;
+  std::unique_ptr<DelimiterIndex> delimiterIndex_;
+
+  // The parsed columns and, for each field of the row, the index of its
+  // column in 'columns_' or -1 if it is not read.
+  std::vector<TextColumn> columns_;
+  std::vector<int32_t> fieldColumns_;
+  // The last field of a row that is read. Fields after it are not split.
+  int32_t lastField_{-1};
+  folly::F14FastMap<std::string_view, int32_t> jsonColumns_;
+  simdjson::ondemand::parser jsonParser_;
+
+  bool started_{false};
+  int64_t rowsRead_{0};
+
+  // File offset of the next read and of the first byte of 'buffer_'.
+  uint64_t filePosition_{0};
+  uint64_t bufferOffset_{0};
+  BufferPtr buffer_;
+  char* data_{nullptr};
+  // Number of bytes in 'buffer_' and offset of the first unparsed one.
+  int64_t size_{0};
+  int64_t pos_{0};
+  // Offsets of the delimiters in 'buffer_'. The ones before 'nextPosition_'
+  // are in rows that have been parsed.
+  std::vector<int64_t> positions_;
+  size_t nextPosition_{0};
+  std::string unescaped_;
+};
+
+TextRowReader::Impl::Impl(
+    std::shared_ptr<ReadFile> file,
+    dwio::common::FileFormat format,
+    const RowTypePtr& schema,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options)
+    : pool_(readerOptions.memoryPool()),
+      file_(std::move(file)),
+      fileSize_(file_->size()),
+      json_(format == dwio::common::FileFormat::JSON),
+      schema_(schema),
+      nullString_(readerOptions.serDeOptions().nullString),
+      fieldDelimiter_(
+          static_cast<char>(readerOptions.serDeOptions().separators[0])),
+      escapeChar_(
+          readerOptions.serDeOptions().isEscaped
+              ? std::optional<char>(static_cast<char>(
+                    readerOptions.serDeOptions().escapeChar))
+              : std::nullopt),
+      lastColumnTakesRest_(readerOptions.serDeOptions().lastColumnTakesRest),
+      splitStart_(options.offset()),
+      splitEnd_(
+          options.length() < fileSize_ - std::min(splitStart_, fileSize_)
+              ? splitStart_ + options.length()
+              : fileSize_),
+      skipRows_(options.skipRows()),
+      readSize_(readerOptions.loadQuantum()),
+      scanSpec_(options.scanSpec()) {
+  VELOX_CHECK_GT(readSize_, 0);
+  if (!scanSpec_) {
+    scanSpec_ = std::make_shared<common::ScanSpec>("<root>");
+    scanSpec_->addAllChildFields(*schema_);
+  }
+  fieldColumns_.assign(schema_->size(), -1);
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->isConstant()) {
+      continue;
+    }
+    const auto channel = schema_->getChildIdx(childSpec->fieldName());
+    const auto& type = schema_->childAt(channel);
+    if (!isSupportedType(*type)) {
+      VELOX_NYI("{} is not supported yet in TextReader", type->toString());
+    }
+    fieldColumns_[channel] = columns_.size();
+    columns_.push_back({channel, type, nullptr});
+    lastField_ = std::max<int32_t>(lastField_, channel);
+    jsonColumns_[schema_->nameOf(channel)] = fieldColumns_[channel];
+  }
+  std::vector<char> delimiters{'\n'};
+  if (!json_) {
+    delimiters.push_back(fieldDelimiter_);
+    if (escapeChar_.has_value()) {
+      delimiters.push_back(escapeChar_.value());
+    }
+  }
+  delimiterIndex_ = std::make_unique<DelimiterIndex>(std::move(delimiters));
+}
+
+bool TextRowReader::Impl::hasRow() {
+  if (!started_) {
+    started_ = true;
+    size_t firstDelimiter;
+    size_t endDelimiter;
+    if (splitStart_ > 0) {
+      // The row that straddles the start of the split, or ends right before
+      // it, belongs to the previous split.
+      filePosition_ = splitStart_ - 1;
+      bufferOffset_ = filePosition_;
+      if (hasData()) {
+        nextRow(firstDelimiter, endDelimiter);
+      }
+    } else {
+      for (uint64_t i = 0; i < skipRows_ && hasData(); ++i) {
+        nextRow(firstDelimiter, endDelimiter);
+      }
+    }
+  }
+  return hasData() && bufferOffset_ + pos_ < splitEnd_;
+}
+
+bool TextRowReader::Impl::readBlock() {
+  if (filePosition_ >= fileSize_) {
+    return false;
+  }
+  const auto tail = size_ - pos_;
+  const auto readSize = std::min(readSize_, fileSize_ - filePosition_);
+  const auto capacity = tail + readSize + kPadding;
+  if (buffer_ && buffer_->capacity() >= capacity) {
+    if (tail > 0) {
+      ::memmove(data_, data_ + pos_, tail);
+    }
+  } else {
+    auto buffer = AlignedBuffer::allocate<char>(capacity, &pool_);
+    if (tail > 0) {
+      ::memcpy(buffer->asMutable<char>(), data_ + pos_, tail);
+    }
+    buffer_ = std::move(buffer);
+    data_ = buffer_->asMutable<char>();
+  }
+  file_->pread(filePosition_, readSize, data_ + tail);
+  ::memset(data_ + tail + readSize, 0, kPadding);
+
+  // The delimiters of the unparsed bytes move with them.
+  positions_.erase(positions_.begin(), positions_.begin() + nextPosition_);
+  for (auto& position : positions_) {
+    position -= pos_;
+  }
+  nextPosition_ = 0;
+  delimiterIndex_->index(data_, tail, tail + readSize, positions_);
+
+  bufferOffset_ += pos_;
+  filePosition_ += readSize;
+  size_ = tail + readSize;
+  pos_ = 0;
+  return true;
+}
+
+std::string_view TextRowReader::Impl::nextRow(
+    size_t& firstDelimiter,
+    size_t& endDelimiter) {
+  auto scanned = nextPosition_;
+  for (;;) {
+    for (; scanned < positions_.size(); ++scanned) {
+      const auto position = positions_[scanned];
+      if (data_[position] != '\n') {
+        continue;
+      }
+      std::string_view row(data_ + pos_, position - pos_);
+      if (!row.empty() && row.back() == '\r') {
+        row.remove_suffix(1);
+      }
+      firstDelimiter = nextPosition_;
+      endDelimiter = scanned;
+      pos_ = position + 1;
+      nextPosition_ = scanned + 1;
+      return row;
+    }
+    const auto consumed = nextPosition_;
+    if (!readBlock()) {
+      // The last row of the file has no line break.
+      std::string_view row(data_ + pos_, size_ - pos_);
+      firstDelimiter = nextPosition_;
+      endDelimiter = positions_.size();
+      pos_ = size_;
+      nextPosition_ = positions_.size();
+      return row;
+    }
+    scanned -= consumed;
+  }
+}
+
+uint64_t TextRowReader::Impl::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  if (!hasRow()) {
+    return 0;
+  }
+  const auto maxRows = static_cast<vector_size_t>(
+      std::min<uint64_t>(size, std::numeric_limits<vector_size_t>::max()));
+  for (auto& column : columns_) {
+    column.vector = BaseVector::create(column.type, maxRows, &pool_);
+  }
+  vector_size_t numRows = 0;
+  size_t firstDelimiter;
+  size_t endDelimiter;
+  while (numRows < maxRows && hasRow()) {
+    const auto row = nextRow(firstDelimiter, endDelimiter);
+    if (json_) {
+      parseJsonRow(row, numRows);
+    } else {
+      parseDelimitedRow(row, firstDelimiter, endDelimiter, numRows);
+    }
+    ++numRows;
+  }
+  rowsRead_ += numRows;
+
+  std::vector<VectorPtr> children(schema_->size());
+  for (auto& column : columns_) {
+    column.vector->resize(numRows);
+    children[column.channel] = std::move(column.vector);
+  }
+  auto rowVector = std::make_shared<RowVector>(
+      &pool_, schema_, nullptr, numRows, std::move(children));
+  result = projectColumns(rowVector, *scanSpec_, mutation);
+  return numRows;
+}
+
+void TextRowReader::Impl::parseDelimitedRow(
+    std::string_view row,
+    size_t firstDelimiter,
+    size_t endDelimiter,
+    vector_size_t index) {
+  const int64_t rowStart = row.data() - data_;
+  const int32_t lastField = schema_->size() - 1;
+  int64_t fieldStart = rowStart;
+  int32_t field = 0;
+  bool escaped = false;
+  for (auto i = firstDelimiter; i < endDelimiter && field <= lastField_; ++i) {
+    const auto position = positions_[i];
+    if (escapeChar_.has_value() && data_[position] == escapeChar_.value()) {
+      // The character after an escape is taken literally.
+      escaped = true;
+      if (i + 1 < endDelimiter && positions_[i + 1] == position + 1) {
+        ++i;
+      }
+      continue;
+    }
+    if (lastColumnTakesRest_ && field == lastField) {
+      continue;
+    }
+    setField(field, index, fieldStart, position, escaped);
+    ++field;
+    fieldStart = position + 1;
+    escaped = false;
+  }
+  if (field <= lastField_) {
+    setField(field, index, fieldStart, rowStart + row.size(), escaped);
+    ++field;
+  }
+  // Rows with fewer fields than the schema have nulls for the missing ones.
+  for (; field <= lastField_; ++field) {
+    if (fieldColumns_[field] >= 0) {
+      columns_[fieldColumns_[field]].vector->setNull(index, true);
+    }
+  }
+}
+
+void TextRowReader::Impl::setField(
+    column_index_t field,
+    vector_size_t index,
+    int64_t begin,
+    int64_t end,
+    bool escaped) {
+  if (field >= fieldColumns_.size() || fieldColumns_[field] < 0) {
+    return;
+  }
+  auto& column = columns_[fieldColumns_[field]];
+  std::string_view text(data_ + begin, end - begin);
+  if (text == nullString_) {
+    column.vector->setNull(index, true);
+    return;
+  }
+  if (escaped) {
+    unescaped_.clear();
+    for (auto i = 0; i < text.size(); ++i) {
+      if (text[i] == escapeChar_.value() && i + 1 < text.size()) {
+        ++i;
+      }
+      unescaped_.push_back(text[i]);
+    }
+    text = unescaped_;
+  }
+  setValue(column, index, text);
+}
+
+void TextRowReader::Impl::parseJsonRow(
+    std::string_view row,
+    vector_size_t index) {
+  for (auto& column : columns_) {
+    column.vector->setNull(index, true);
+  }
+  if (columns_.empty() || trimTrailingWhitespace(row).empty()) {
+    return;
+  }
+  // The bytes after the row in 'buffer_' serve as the padding of simdjson.
+  const auto capacity = buffer_->capacity() - (row.data() - data_);
+  try {
+    auto document = jsonParser_.iterate(row.data(), row.size(), capacity);
+    simdjson::ondemand::object object = document.get_object();
+    for (simdjson::ondemand::field field : object) {
+      const std::string_view key = field.unescaped_key();
+      auto it = jsonColumns_.find(key);
+      if (it == jsonColumns_.end()) {
+        continue;
+      }
+      auto& column = columns_[it->second];
+      simdjson::ondemand::value value = field.value();
+      const simdjson::ondemand::json_type type = value.type();
+      switch (type) {
+        case simdjson::ondemand::json_type::null:
+          column.vector->setNull(index, true);
+          break;
+        case simdjson::ondemand::json_type::string:
+          setValue(column, index, value.get_string());
+          break;
+        case simdjson::ondemand::json_type::number:
+        case simdjson::ondemand::json_type::boolean:
+          setValue(
+              column, index, trimTrailingWhitespace(value.raw_json_token()));
+          break;
+        default:
+          // Arrays and objects are read as JSON text.
+          setValue(column, index, simdjson::to_json_string(value));
+          break;
+      }
+    }
+  } catch (const simdjson::simdjson_error& e) {
+    VELOX_USER_FAIL(
+        "Invalid JSON row at offset {}: {}",
+        bufferOffset_ + (row.data() - data_),
+        e.what());
+  }
+}
+
+template <typename T>
+void TextRowReader::Impl::setNumber(
+    TextColumn& column,
+    vector_size_t index,
+    std::string_view text) {
+  const auto value = folly::tryTo<T>(folly::StringPiece(text));
+  if (value.hasValue()) {
+    column.vector->asUnchecked<FlatVector<T>>()->set(index, value.value());
+  } else {
+    column.vector->setNull(index, true);
+  }
+}
+
+void TextRowReader::Impl::setValue(
+    TextColumn& column,
+    vector_size_t index,
+    std::string_view text) {
+  switch (column.type->kind()) {
+    case TypeKind::BOOLEAN: {
+      auto* flat = column.vector->asUnchecked<FlatVector<bool>>();
+      if (equalsIgnoreCase(text, "true")) {
+        flat->set(index, true);
+      } else if (equalsIgnoreCase(text, "false")) {
+        flat->set(index, false);
+      } else {
+        flat->setNull(index, true);
+      }
+      break;
+    }
+    case TypeKind::TINYINT:
+      setNumber<int8_t>(column, index, text);
+      break;
+    case TypeKind::SMALLINT:
+      setNumber<int16_t>(column, index, text);
+      break;
+    case TypeKind::INTEGER:
+      if (column.type->isDate()) {
+        const auto days = util::fromDateString(
+            text.data(), text.size(), util::ParseMode::kPrestoCast);
+        if (days.hasValue()) {
+          column.vector->asUnchecked<FlatVector<int32_t>>()->set(
+              index, days.value());
+        } else {
+          column.vector->setNull(index, true);
+        }
+      } else {
+        setNumber<int32_t>(column, index, text);
+      }
+      break;
+    case TypeKind::BIGINT:
+      setNumber<int64_t>(column, index, text);
+      break;
+    case TypeKind::REAL:
+      setNumber<float>(column, index, text);
+      break;
+    case TypeKind::DOUBLE:
+      setNumber<double>(column, index, text);
+      break;
+    case TypeKind::TIMESTAMP: {
+      const auto timestamp = util::fromTimestampString(
+          text.data(), text.size(), util::TimestampParseMode::kLegacyCast);
+      if (timestamp.hasValue()) {
+        column.vector->asUnchecked<FlatVector<Timestamp>>()->set(
+            index, timestamp.value());
+      } else {
+        column.vector->setNull(index, true);
+      }
+      break;
+    }
+    case TypeKind::VARCHAR:
+      column.vector->asUnchecked<FlatVector<StringView>>()->set(
+          index, StringView(text.data(), text.size()));
+      break;
+    case TypeKind::VARBINARY: {
+      // Binary values are written in base64 by the TextWriter.
+      std::string decoded;
+      try {
+        decoded = encoding::Base64::decode(folly::StringPiece(text));
+      } catch (const VeloxException&) {
+        column.vector->setNull(index, true);
+        break;
+      }
+      column.vector->asUnchecked<FlatVector<StringView>>()->set(
+          index, StringView(decoded));
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<ReadFile> file,
+    dwio::common::FileFormat format,
+    const RowTypePtr& schema,
+    const dwio::common::ReaderOptions& readerOptions,
+    const dwio::common::RowReaderOptions& options)
+    : impl_(std::make_unique<Impl>(
+          std::move(file),
+          format,
+          schema,
+          readerOptions,
+          options)) {}
+
+TextRowReader::~TextRowReader() = default;
+
+int64_t TextRowReader::nextRowNumber() {
+  return impl_->nextRowNumber();
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  return impl_->nextReadSize(size);
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    velox::VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  return impl_->next(size, result, mutation);
+}
+
+TextReader::TextReader(
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options,
+    dwio::common::FileFormat format)
+    : options_(options),
+      format_(format),
+      input_(std::move(input)),
+      schema_(options.fileSchema()),
+      typeWithId_(
+          schema_ ? dwio::common::TypeWithId::create(schema_) : nullptr) {
+  VELOX_USER_CHECK_NOT_NULL(schema_, "Text reader requires a file schema");
+}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      input_->getReadFile(), format_, schema_, options_, options);
+}
+
+} // namespace facebook::velox::text
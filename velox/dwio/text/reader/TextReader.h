@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::text {
+
+/// Reads rows of a text file in the byte range of a split. A row belongs to
+/// the split whose range contains the first byte of the row, so that splits
+/// cut at arbitrary offsets cover each row exactly once. The file is read in
+/// blocks of ReaderOptions::loadQuantum() bytes. Row and field
+/// boundaries are found by comparing a SIMD register worth of bytes against
+/// the delimiters at a time. Only the columns referenced by the ScanSpec are
+/// parsed, and the ScanSpec filters are applied to the parsed columns.
+///
+/// FileFormat::TEXT files are delimited as described by the SerDeOptions of
+/// the reader. FileFormat::JSON files hold one JSON object per line whose keys
+/// are matched against the column names.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<ReadFile> file,
+      dwio::common::FileFormat format,
+      const RowTypePtr& schema,
+      const dwio::common::ReaderOptions& readerOptions,
+      const dwio::common::RowReaderOptions& options);
+
+  ~TextRowReader() override;
+
+  /// Returns the number of rows read so far from the split. Rows before the
+  /// start of the split are not counted.
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  uint64_t next(
+      uint64_t size,
+      velox::VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& stats) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Implements the reader interface for text files. Text files carry no schema,
+/// so the file schema must be set in the ReaderOptions.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options,
+      dwio::common::FileFormat format = dwio::common::FileFormat::TEXT);
+
+  ~TextReader() override = default;
+
+  /// The number of rows is not known without reading the whole file.
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const velox::RowTypePtr& rowType() const override {
+    return schema_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const dwio::common::ReaderOptions options_;
+  const dwio::common::FileFormat format_;
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
+  const RowTypePtr schema_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+};
+
+/// Creates TextReaders for either FileFormat::TEXT or FileFormat::JSON.
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  explicit TextReaderFactory(
+      dwio::common::FileFormat format = dwio::common::FileFormat::TEXT)
+      : ReaderFactory(format) {
+    VELOX_CHECK(
+        format == dwio::common::FileFormat::TEXT ||
+            format == dwio::common::FileFormat::JSON,
+        "Unsupported text file format: {}",
+        format);
+  }
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(
+        std::move(input), options, fileFormat());
+  }
+};
+
+} // namespace facebook::velox::text
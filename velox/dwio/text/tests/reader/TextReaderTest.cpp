@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/reader/TextReader.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+class TextReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Reads the rows of 'data' in the byte range [offset, offset + length) in
+  // batches of 'batchSize' rows. The file is read 'readSize' bytes at a time.
+  RowVectorPtr read(
+      const std::string& data,
+      const RowTypePtr& schema,
+      dwio::common::FileFormat format = dwio::common::FileFormat::TEXT,
+      const dwio::common::SerDeOptions& serDeOptions =
+          dwio::common::SerDeOptions(),
+      std::shared_ptr<common::ScanSpec> scanSpec = nullptr,
+      uint64_t offset = 0,
+      uint64_t length = std::numeric_limits<uint64_t>::max(),
+      uint64_t skipRows = 0,
+      uint64_t batchSize = 3,
+      int32_t readSize = io::ReaderOptions::kDefaultLoadQuantum) {
+    dwio::common::ReaderOptions readerOptions{pool()};
+    readerOptions.setLoadQuantum(readSize);
+    readerOptions.setFileSchema(schema);
+    readerOptions.setSerDeOptions(serDeOptions);
+    auto input = std::make_unique<dwio::common::BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), *pool());
+    TextReaderFactory factory(format);
+    auto reader = factory.createReader(std::move(input), readerOptions);
+
+    dwio::common::RowReaderOptions rowReaderOptions;
+    rowReaderOptions.range(offset, length);
+    rowReaderOptions.setSkipRows(skipRows);
+    if (!scanSpec) {
+      scanSpec = std::make_shared<common::ScanSpec>("<root>");
+      scanSpec->addAllChildFields(*schema);
+    }
+    rowReaderOptions.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (rowReader->next(batchSize, batch) > 0) {
+      if (!result) {
+        result = std::dynamic_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      result->append(batch.get());
+    }
+    EXPECT_EQ(
+        rowReader->nextReadSize(batchSize), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+};
+
+TEST_F(TextReaderTest, delimited) {
+  auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6"},
+          {BOOLEAN(),
+           INTEGER(),
+           BIGINT(),
+           DOUBLE(),
+           DATE(),
+           VARCHAR(),
+           VARBINARY()});
+  const std::string data =
+      "true\x01" "1\x01" "10\x01" "1.5\x01" "2024-01-02\x01" "abc\x01"
+      "aGVsbG8=\n"
+      "FALSE\x01\\N\x01" "20\x01" "2.5\x01\\N\x01"
+      "a string longer than inline\x01\\N\r\n"
+      "x\x01" "3\x01" "abc\x01\x01" "2024-03-04\x01\x01\n"
+      "true\x01" "4";
+  auto result = read(data, schema);
+
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6"},
+      {
+          makeNullableFlatVector<bool>({true, false, std::nullopt, true}),
+          makeNullableFlatVector<int32_t>({1, std::nullopt, 3, 4}),
+          makeNullableFlatVector<int64_t>(
+              {10, 20, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<double>(
+              {1.5, 2.5, std::nullopt, std::nullopt}),
+          makeNullableFlatVector<int32_t>(
+              {19724, std::nullopt, 19786, std::nullopt}, DATE()),
+          makeNullableFlatVector<StringView>(
+              {"abc", "a string longer than inline", "", std::nullopt}),
+          makeNullableFlatVector<StringView>(
+              {"hello", std::nullopt, "", std::nullopt}, VARBINARY()),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, escaped) {
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  auto result = read(
+      "a\\,b,c\\\\\n\\N,d",
+      schema,
+      dwio::common::FileFormat::TEXT,
+      serDeOptions);
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeNullableFlatVector<StringView>({"a,b", std::nullopt}),
+          makeFlatVector<StringView>({"c\\", "d"}),
+      });
+  test::assertEqualVectors(expected, result);
+
+  serDeOptions = dwio::common::SerDeOptions(',');
+  serDeOptions.lastColumnTakesRest = true;
+  result =
+      read("a,b,c\nd", schema, dwio::common::FileFormat::TEXT, serDeOptions);
+  expected = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<StringView>({"a", "d"}),
+          makeNullableFlatVector<StringView>({"b,c", std::nullopt}),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, splits) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  std::string data;
+  std::vector<int64_t> keys;
+  std::vector<std::string> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    keys.push_back(i);
+    values.push_back(std::string(i % 37, 'a' + i % 26));
+    data += fmt::format("{}\x01{}\n", i, values.back());
+  }
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(keys),
+          makeFlatVector<std::string>(values),
+      });
+
+  for (auto splitSize : {1, 7, 100, 4096, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("splitSize {}", splitSize));
+    auto result = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(schema, 0, pool()));
+    for (uint64_t offset = 0; offset < data.size(); offset += splitSize) {
+      auto split = read(
+          data,
+          schema,
+          dwio::common::FileFormat::TEXT,
+          dwio::common::SerDeOptions(),
+          nullptr,
+          offset,
+          splitSize,
+          0,
+          100);
+      if (split) {
+        result->append(split.get());
+      }
+    }
+    test::assertEqualVectors(expected, result);
+  }
+}
+
+TEST_F(TextReaderTest, rowsAcrossReadBlocks) {
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), VARCHAR()});
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  std::string data;
+  std::string jsonData;
+  std::vector<int64_t> keys;
+  std::vector<std::string> values;
+  std::vector<std::string> escapedValues;
+  for (auto i = 0; i < 200; ++i) {
+    keys.push_back(i);
+    values.push_back(std::string(i % 53, 'a' + i % 26));
+    escapedValues.push_back(fmt::format("x,{}", i));
+    data += fmt::format(
+        "{},{},x\\,{}{}", i, values.back(), i, i % 3 == 0 ? "\r\n" : "\n");
+    jsonData += fmt::format(
+        "{{\"c0\": {}, \"c1\": \"{}\", \"c2\": \"{}\"}}\n",
+        i,
+        values.back(),
+        escapedValues.back());
+  }
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2"},
+      {
+          makeFlatVector<int64_t>(keys),
+          makeFlatVector<std::string>(values),
+          makeFlatVector<std::string>(escapedValues),
+      });
+
+  // Rows, escapes and line breaks span one or more read blocks and the bytes
+  // left over from a block are carried over to the next one.
+  for (auto readSize : {1, 2, 3, 16, 61, 1024}) {
+    SCOPED_TRACE(fmt::format("readSize {}", readSize));
+    test::assertEqualVectors(
+        expected,
+        read(
+            data,
+            schema,
+            dwio::common::FileFormat::TEXT,
+            serDeOptions,
+            nullptr,
+            0,
+            std::numeric_limits<uint64_t>::max(),
+            0,
+            7,
+            readSize));
+    test::assertEqualVectors(
+        expected,
+        read(
+            jsonData,
+            schema,
+            dwio::common::FileFormat::JSON,
+            dwio::common::SerDeOptions(),
+            nullptr,
+            0,
+            std::numeric_limits<uint64_t>::max(),
+            0,
+            7,
+            readSize));
+
+    constexpr uint64_t kSplitSize = 97;
+    auto result = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(schema, 0, pool()));
+    for (uint64_t offset = 0; offset < data.size(); offset += kSplitSize) {
+      auto split = read(
+          data,
+          schema,
+          dwio::common::FileFormat::TEXT,
+          serDeOptions,
+          nullptr,
+          offset,
+          kSplitSize,
+          0,
+          7,
+          readSize);
+      if (split) {
+        result->append(split.get());
+      }
+    }
+    test::assertEqualVectors(expected, result);
+  }
+}
+
+TEST_F(TextReaderTest, skipRows) {
+  auto schema = ROW({"c0"}, {INTEGER()});
+  auto result = read(
+      "c0\nheader\n1\n2\n",
+      schema,
+      dwio::common::FileFormat::TEXT,
+      dwio::common::SerDeOptions(),
+      nullptr,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      2);
+  test::assertEqualVectors(
+      makeRowVector({"c0"}, {makeFlatVector<int32_t>({1, 2})}), result);
+}
+
+TEST_F(TextReaderTest, filterAndProject) {
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()});
+  std::string data;
+  for (auto i = 0; i < 20; ++i) {
+    data += fmt::format("{},{},s{}\n", i, i * 2, i);
+  }
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*schema);
+  scanSpec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(5, 7, false));
+  scanSpec->childByName("c0")->setProjectOut(false);
+  scanSpec->childByName("c1")->setProjectOut(false);
+  scanSpec->childByName("c2")->setChannel(0);
+  auto result = read(
+      data,
+      schema,
+      dwio::common::FileFormat::TEXT,
+      dwio::common::SerDeOptions(','),
+      scanSpec);
+  test::assertEqualVectors(
+      makeRowVector({"c2"}, {makeFlatVector<std::string>({"s5", "s6", "s7"})}),
+      result);
+}
+
+TEST_F(TextReaderTest, json) {
+  auto schema =
+      ROW({"a", "b", "c", "d"}, {BIGINT(), VARCHAR(), BOOLEAN(), VARCHAR()});
+  const std::string data =
+      "{\"a\": 1, \"b\": \"x\", \"c\": true, \"d\": [1, 2]}\n"
+      "{\"b\": \"y\\n\", \"e\": {\"f\": 1}, \"a\": null}\n"
+      "\n"
+      "{\"a\": 3, \"c\": false, \"d\": {\"g\": \"h\"}}";
+  auto result = read(data, schema, dwio::common::FileFormat::JSON);
+  auto expected = makeRowVector(
+      {"a", "b", "c", "d"},
+      {
+          makeNullableFlatVector<int64_t>({1, std::nullopt, std::nullopt, 3}),
+          makeNullableFlatVector<StringView>(
+              {"x", "y\n", std::nullopt, std::nullopt}),
+          makeNullableFlatVector<bool>(
+              {true, std::nullopt, std::nullopt, false}),
+          makeNullableFlatVector<StringView>(
+              {"[1,2]", std::nullopt, std::nullopt, "{\"g\":\"h\"}"}),
+      });
+  test::assertEqualVectors(expected, result);
+
+  VELOX_ASSERT_THROW(
+      read("{\"a\": 1,\n", schema, dwio::common::FileFormat::JSON),
+      "Invalid JSON row");
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -89,6 +89,22 @@ class Aggregate {
     return false;
   }
 
+  /// Returns true if relocateAccumulators() is supported, i.e. the
+  /// accumulators can be moved when the HashStringAllocator holding their
+  /// variable width state is compacted.
+  virtual bool supportsAccumulatorRelocation() const {
+    return false;
+  }
+
+  /// Replaces the references to the HashStringAllocator blocks held by the
+  /// accumulators in 'groups' with the blocks returned by 'relocator'. Called
+  /// from HashStringAllocator::compact(). See supportsAccumulatorRelocation().
+  virtual void relocateAccumulators(
+      folly::Range<char**> /*groups*/,
+      const HashStringAllocator::Relocator& /*relocator*/) {
+    VELOX_UNSUPPORTED("relocateAccumulators not supported");
+  }
+
   void setAllocator(HashStringAllocator* allocator) {
     setAllocatorInternal(allocator);
   }
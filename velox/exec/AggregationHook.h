@@ -143,6 +143,48 @@ class SumHook final : public AggregationHook {
   }
 };
 
+// Counts the non-null values of a column for count(x). The accumulator is a
+// never-null int64_t, so there is no null flag to clear.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  Kind kind() const final {
+    return kGeneric;
+  }
+
+  void addValue(vector_size_t row, int64_t /*value*/) final {
+    increment(row);
+  }
+
+  void addValue(vector_size_t row, int128_t /*value*/) final {
+    increment(row);
+  }
+
+  void addValue(vector_size_t row, float /*value*/) final {
+    increment(row);
+  }
+
+  void addValue(vector_size_t row, double /*value*/) final {
+    increment(row);
+  }
+
+  void addValue(vector_size_t row, folly::StringPiece /*value*/) final {
+    increment(row);
+  }
+
+ private:
+  inline void increment(vector_size_t row) {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+};
+
 template <typename TAggregate, typename UpdateSingleValue>
 class SimpleCallableHook final : public AggregationHook {
  public:
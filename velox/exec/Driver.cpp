@@ -144,7 +144,9 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.spillPrefixSortEnabled()
           ? std::optional<common::PrefixSortConfig>(prefixSortConfig())
           : std::nullopt,
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillAsyncIoEnabled(),
+      queryConfig.spillRowFormatEnabled());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -238,8 +240,7 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  driver->task()->driverExecutor()->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -62,6 +62,7 @@ GroupingSet::GroupingSet(
       isPartial_(isPartial),
       isRawInput_(isRawInput),
       queryConfig_(operatorCtx->task()->queryCtx()->queryConfig()),
+      compactionFreeRatio_(queryConfig_.aggregationCompactionFreeRatio()),
       aggregates_(std::move(aggregates)),
       masks_(extractMaskChannels(aggregates_)),
       ignoreNullKeys_(ignoreNullKeys),
@@ -309,6 +310,32 @@ void GroupingSet::addInputForActiveRows(
     }
     sortedAggregations_->addInput(groups, input);
   }
+
+  maybeCompactRows();
+}
+
+void GroupingSet::maybeCompactRows() {
+  // Do not bother with small amounts of memory.
+  constexpr int64_t kMinCompactionBytes = 16 << 20;
+  if (compactionFreeRatio_ <= 0 || table_ == nullptr) {
+    return;
+  }
+  const auto& stringAllocator = table_->rows()->stringAllocator();
+  if (stringAllocator.retainedSize() < kMinCompactionBytes ||
+      stringAllocator.freeRatio() <= compactionFreeRatio_) {
+    return;
+  }
+  compactRows();
+}
+
+int64_t GroupingSet::compactRows() {
+  if (compactionFreeRatio_ <= 0 || table_ == nullptr ||
+      !table_->rows()->canCompactStringAllocator()) {
+    return 0;
+  }
+  const auto freedBytes = table_->rows()->compactStringAllocator();
+  compactedBytes_ += freedBytes;
+  return freedBytes;
 }
 
 void GroupingSet::addRemainingInput() {
@@ -1135,7 +1162,11 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->asyncIoExecutor(),
+      spillConfig_->readAheadPool);
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -116,6 +116,17 @@ class GroupingSet {
   /// when no spill has occurred previously.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Moves the variable width data of the groups into new memory and releases
+  /// the fragmented memory if the compaction is enabled by
+  /// 'aggregation_compaction_free_ratio' and all the aggregates support
+  /// relocating their accumulators. Returns the number of bytes released.
+  int64_t compactRows();
+
+  /// Returns the total number of bytes released by compactRows() so far.
+  int64_t compactedBytes() const {
+    return compactedBytes_;
+  }
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<common::SpillStats> spilledStats() const;
 
@@ -163,6 +174,10 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Compacts the rows if the fraction of free memory in their variable width
+  // storage exceeds 'compactionFreeRatio_'.
+  void maybeCompactRows();
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -303,6 +318,10 @@ class GroupingSet {
   const bool isPartial_;
   const bool isRawInput_;
   const core::QueryConfig& queryConfig_;
+  const double compactionFreeRatio_;
+
+  // Total bytes released by compactRows().
+  int64_t compactedBytes_{0};
 
   std::vector<AggregateInfo> aggregates_;
   AggregationMasks masks_;
@@ -242,6 +242,10 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  if (groupingSet_->compactedBytes() > 0) {
+    runtimeStats[kCompactedBytes] = RuntimeMetric(
+        groupingSet_->compactedBytes(), RuntimeCounter::Unit::kBytes);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -478,8 +482,14 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    // Releasing the fragmented memory of the accumulators may be enough to
+    // avoid spilling.
+    if (targetBytes > 0 &&
+        groupingSet_->compactRows() >= static_cast<int64_t>(targetBytes)) {
+      pool()->release();
+      return;
+    }
+    // TODO: support fine-grain disk spilling based on 'targetBytes'.
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
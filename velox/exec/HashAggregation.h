@@ -22,6 +22,10 @@ namespace facebook::velox::exec {
 
 class HashAggregation : public Operator {
  public:
+  /// Runtime stat for the bytes released by compacting the variable width
+  /// memory of the accumulators. See 'aggregation_compaction_free_ratio'.
+  static inline const std::string kCompactedBytes{"compactedBytes"};
+
   HashAggregation(
       int32_t operatorId,
       DriverCtx* driverCtx,
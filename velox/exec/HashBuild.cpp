@@ -62,6 +62,9 @@ HashBuild::HashBuild(
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
       needProbedFlagSpill_{needRightSideJoin(joinType_)},
+      hybridSpillEnabled_{driverCtx->queryConfig().joinHybridSpillEnabled()},
+      hybridSpillReloadMemoryRatio_{
+          driverCtx->queryConfig().joinHybridSpillReloadMemoryRatio()},
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
@@ -203,7 +206,11 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), &spillStats_);
+        config->readBufferSize,
+        pool(),
+        &spillStats_,
+        config->asyncIoExecutor(),
+        config->readAheadPool);
     VELOX_CHECK(!restoringPartitionId_.has_value());
     restoringPartitionId_ = spillPartition->id();
     const auto numPartitionBits = config->numPartitionBits;
@@ -739,6 +746,11 @@ bool HashBuild::finishHashBuild() {
   const bool allowParallelJoinBuild =
       !otherTables.empty() && spillPartitions.empty();
 
+  bool hybridReloaded{false};
+  if (hybridSpillEnabled_ && !spillPartitions.empty()) {
+    hybridReloaded = reloadSpilledPartitions(spillPartitions);
+  }
+
   SCOPE_EXIT {
     // Make a guard to release the unused memory reservation since we have
     // finished the merged table build.
@@ -754,7 +766,7 @@ bool HashBuild::finishHashBuild() {
         std::move(otherTables),
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit,
-        allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
+        allowParallelJoinBuild ? operatorCtx_->task()->driverExecutor()
                                : nullptr);
   }
   stats_.wlock()->addRuntimeStat(
@@ -787,13 +799,140 @@ bool HashBuild::finishHashBuild() {
       std::move(table_),
       std::move(spillPartitions),
       joinHasNullKeys_,
-      std::move(tableSpillFunc));
+      std::move(tableSpillFunc),
+      hybridReloaded);
   if (canSpill()) {
     stateCleared_ = true;
   }
   return true;
 }
 
+bool HashBuild::reloadSpilledPartitions(SpillPartitionSet& spillPartitions) {
+  VELOX_CHECK(hybridSpillEnabled_);
+  VELOX_CHECK(canSpill());
+  VELOX_CHECK_NOT_NULL(spiller_);
+  VELOX_CHECK(spiller_->finalized());
+
+  std::vector<SpillPartition*> candidates;
+  candidates.reserve(spillPartitions.size());
+  for (const auto& [_, partition] : spillPartitions) {
+    candidates.push_back(partition.get());
+  }
+  // Reload the smallest partitions first to keep as many partitions in memory
+  // as possible, which minimizes the probe rows to spill.
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const SpillPartition* lhs, const SpillPartition* rhs) {
+        return lhs->size() < rhs->size();
+      });
+
+  const auto* config = spillConfig();
+  std::vector<SpillPartitionId> reloadedPartitionIds;
+  for (auto* partition : candidates) {
+    uint64_t memoryBytesToReserve =
+        partition->size() * hybridSpillReloadMemoryRatio_;
+    TestValue::adjust(
+        "facebook::velox::exec::HashBuild::reloadSpilledPartitions",
+        &memoryBytesToReserve);
+    {
+      // NOTE: this operator itself is not reclaimable as 'spiller_' has been
+      // finalized, so the reservation might only reclaim memory from the other
+      // arbitration participants.
+      Operator::ReclaimableSectionGuard guard(this);
+      if (!pool()->maybeReserve(memoryBytesToReserve)) {
+        break;
+      }
+    }
+    auto reader = partition->createUnorderedReader(
+        config->readBufferSize,
+        pool(),
+        &spillStats_,
+        config->asyncIoExecutor(),
+        config->readAheadPool);
+    RowVectorPtr input;
+    while (reader->nextBatch(input)) {
+      storeSpilledRows(input);
+      // NOTE: a partition might have spill files of both the serialized and
+      // the columnar table rows so we don't reuse 'input' across batches.
+      input.reset();
+    }
+    reloadedPartitionIds.push_back(partition->id());
+  }
+  if (reloadedPartitionIds.empty()) {
+    return false;
+  }
+
+  for (const auto& partitionId : reloadedPartitionIds) {
+    spillPartitions.erase(partitionId);
+  }
+  stats_.wlock()->addRuntimeStat(
+      kHybridReloadedPartitions,
+      RuntimeCounter(reloadedPartitionIds.size()));
+  return true;
+}
+
+void HashBuild::storeSpilledRows(const RowVectorPtr& input) {
+  std::vector<char*> newRows;
+  if (isSerializedRowSpillInput(input)) {
+    storeSerializedRows(input, newRows);
+  } else {
+    storeColumnarRows(input, newRows);
+  }
+  analyzeStoredKeys(newRows);
+}
+
+void HashBuild::storeColumnarRows(
+    const RowVectorPtr& input,
+    std::vector<char*>& newRows) {
+  auto* rows = table_->rows();
+  const auto nextOffset = rows->nextOffset();
+  const auto numInput = input->size();
+
+  const auto numColumns = rows->columnTypes().size();
+  std::vector<DecodedVector> decodedColumns(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    decodedColumns[i].decode(*input->childAt(i)->loadedVector());
+  }
+  FlatVector<bool>* probedFlagVector{nullptr};
+  if (needProbedFlagSpill_) {
+    probedFlagVector =
+        input->childAt(spillProbedFlagChannel_)->asFlatVector<bool>();
+    VELOX_CHECK_NOT_NULL(probedFlagVector);
+  }
+  newRows.resize(numInput);
+  for (auto row = 0; row < numInput; ++row) {
+    char* newRow = rows->newRow();
+    if (nextOffset) {
+      *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+    }
+    for (auto i = 0; i < numColumns; ++i) {
+      rows->store(decodedColumns[i], row, newRow, i);
+    }
+    if (probedFlagVector != nullptr && probedFlagVector->valueAt(row)) {
+      rows->setProbedFlag(&newRow, 1);
+    }
+    newRows[row] = newRow;
+  }
+}
+
+void HashBuild::analyzeStoredKeys(std::vector<char*>& newRows) {
+  // Runs the keys through the VectorHashers as addInput() does so that the
+  // table can still pick the array or normalized key hash mode.
+  auto* rows = table_->rows();
+  const auto& hashers = table_->hashers();
+  for (auto i = 0; i < hashers.size() && analyzeKeys_; ++i) {
+    const auto column = rows->columnAt(i);
+    hashers[i]->analyze(
+        newRows.data(),
+        newRows.size(),
+        column.offset(),
+        column.nullByte(),
+        column.nullMask());
+    analyzeKeys_ = hashers[i]->mayUseValueIds();
+  }
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -887,7 +1026,11 @@ void HashBuild::processSpillInput() {
   checkRunning();
 
   while (spillInputReader_->nextBatch(spillInput_)) {
-    addInput(std::move(spillInput_));
+    if (isSerializedRowSpillInput(spillInput_)) {
+      addSerializedRowSpillInput(std::move(spillInput_));
+    } else {
+      addInput(std::move(spillInput_));
+    }
     if (!isRunning()) {
       return;
     }
@@ -900,6 +1043,83 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+bool HashBuild::isSerializedRowSpillInput(const RowVectorPtr& input) const {
+  return spillConfig()->rowFormatEnabled &&
+      input->type() == HashBuildSpiller::serializedRowType();
+}
+
+void HashBuild::storeSerializedRows(
+    const RowVectorPtr& input,
+    std::vector<char*>& newRows) {
+  const auto* serializedRows =
+      input->childAt(0)->loadedVector()->asFlatVector<StringView>();
+  VELOX_CHECK_NOT_NULL(serializedRows);
+
+  auto* rows = table_->rows();
+  const auto numInput = input->size();
+  newRows.resize(numInput);
+  const auto nextOffset = rows->nextOffset();
+  for (auto i = 0; i < numInput; ++i) {
+    newRows[i] = rows->newRow();
+    if (nextOffset) {
+      *reinterpret_cast<char**>(newRows[i] + nextOffset) = nullptr;
+    }
+  }
+  rows->storeSerializedRows(
+      *serializedRows, folly::Range<char**>(newRows.data(), numInput));
+  stats_.wlock()->addRuntimeStat(
+      kSerializedSpillRows, RuntimeCounter(numInput));
+}
+
+void HashBuild::addSerializedRowSpillInput(RowVectorPtr input) {
+  checkRunning();
+  VELOX_CHECK(isInputFromSpill());
+  ensureInputFits(input);
+
+  std::vector<char*> newRows;
+  storeSerializedRows(input, newRows);
+  auto* rows = table_->rows();
+  const auto numInput = newRows.size();
+  const auto& hashers = table_->hashers();
+
+  if (nullAware_ && !joinHasNullKeys_) {
+    for (auto i = 0; i < numInput && !joinHasNullKeys_; ++i) {
+      for (auto key = 0; key < hashers.size(); ++key) {
+        if (RowContainer::isNullAt(newRows[i], rows->columnAt(key))) {
+          joinHasNullKeys_ = true;
+          break;
+        }
+      }
+    }
+  }
+
+  if (spiller_ != nullptr && spiller_->spillTriggered()) {
+    // Part of the restoring partition has been spilled. Converts the rows into
+    // columns and removes them from the table so that addInput() can spill
+    // the rows of the spilled partitions and add back the others.
+    auto columnarInput =
+        BaseVector::create<RowVector>(spillType_, numInput, pool());
+    const auto& types = rows->columnTypes();
+    for (auto i = 0; i < types.size(); ++i) {
+      rows->extractColumn(
+          newRows.data(), numInput, i, columnarInput->childAt(i));
+    }
+    if (needProbedFlagSpill_) {
+      rows->extractProbedFlags(
+          newRows.data(),
+          numInput,
+          false,
+          false,
+          columnarInput->childAt(spillProbedFlagChannel_));
+    }
+    rows->eraseRows(folly::Range<char**>(newRows.data(), numInput));
+    addInput(std::move(columnarInput));
+    return;
+  }
+
+  analyzeStoredKeys(newRows);
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -1195,10 +1415,22 @@ HashBuildSpiller::HashBuildSpiller(
           parentId,
           spillConfig,
           spillStats),
-      spillProbeFlag_(needRightSideJoin(joinType)) {
+      spillProbeFlag_(needRightSideJoin(joinType)),
+      // NOTE: we don't use the serialized row layout if the spill type itself
+      // has a single column as the restore can't tell the two layouts apart
+      // and there is nothing to save in that case.
+      spillSerializedRows_(
+          spillConfig->rowFormatEnabled && rowType_->size() > 1) {
   VELOX_CHECK(container_->accumulators().empty());
 }
 
+// static
+const RowTypePtr& HashBuildSpiller::serializedRowType() {
+  static const RowTypePtr kSerializedRowType =
+      ROW({"serialized_row"}, {VARBINARY()});
+  return kSerializedRowType;
+}
+
 void HashBuildSpiller::spill() {
   spillTriggered_ = true;
   SpillerBase::spill(nullptr);
@@ -1221,6 +1453,20 @@ void HashBuildSpiller::spill(
 void HashBuildSpiller::extractSpill(
     folly::Range<char**> rows,
     facebook::velox::RowVectorPtr& resultPtr) {
+  if (spillSerializedRows_) {
+    if (resultPtr == nullptr) {
+      resultPtr = BaseVector::create<RowVector>(
+          serializedRowType(), rows.size(), memory::spillMemoryPool());
+    } else {
+      resultPtr->prepareForReuse();
+      resultPtr->resize(rows.size());
+    }
+    // NOTE: the serialized row includes the row flags so the probed flag is
+    // preserved without a separate column.
+    container_->extractSerializedRows(rows, resultPtr->childAt(0));
+    return;
+  }
+
   if (resultPtr == nullptr) {
     resultPtr = BaseVector::create<RowVector>(
         rowType_, rows.size(), memory::spillMemoryPool());
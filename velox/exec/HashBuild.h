@@ -56,6 +56,15 @@ class HashBuild final : public Operator {
   };
   static std::string stateName(State state);
 
+  /// The number of spilled partitions reloaded into the join table by hybrid
+  /// join spilling.
+  static inline const std::string kHybridReloadedPartitions{
+      "hybridReloadedPartitions"};
+
+  /// The number of spilled table rows restored from the RowContainer's
+  /// serialized row layout if the spill row format is enabled.
+  static inline const std::string kSerializedSpillRows{"serializedSpillRows"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -188,6 +197,50 @@ class HashBuild final : public Operator {
   // Invoked to process data from spill input reader on restoring.
   void processSpillInput();
 
+  // Returns true if 'input' read from the spilled data holds the table rows in
+  // the RowContainer's serialized row layout. 'HashBuildSpiller' writes these
+  // with 'HashBuildSpiller::serializedRowType()' which is also the type of the
+  // vectors read back from their spill files, so the type identifies them.
+  // NOTE: the caller must not reuse 'input' across spill files of different
+  // types.
+  bool isSerializedRowSpillInput(const RowVectorPtr& input) const;
+
+  // Invoked to add the serialized table rows in 'input' read from the spilled
+  // data. The rows are copied into the table's RowContainer as they are and
+  // the join keys are analyzed as in addInput(). If part of the restoring
+  // partition has been spilled again, the rows are converted into columns and
+  // processed by addInput() instead so that they can be routed to their spill
+  // partitions.
+  void addSerializedRowSpillInput(RowVectorPtr input);
+
+  // Copies the serialized table rows in 'input' into new rows of 'table_' and
+  // returns the new rows in 'newRows'.
+  void storeSerializedRows(
+      const RowVectorPtr& input,
+      std::vector<char*>& newRows);
+
+  // Invoked by the last hash build operator if hybrid join spilling is enabled
+  // to reload the spilled partitions from 'spillPartitions' into 'table_' as
+  // long as the memory reservation succeeds, starting from the smallest one.
+  // The reloaded partitions are removed from 'spillPartitions' so that only
+  // the probe rows of the remaining ones need to be spilled. Returns true if
+  // any partition has been reloaded.
+  bool reloadSpilledPartitions(SpillPartitionSet& spillPartitions);
+
+  // Invoked to store the spilled table rows in 'input' into 'table_' and to
+  // analyze their join keys.
+  void storeSpilledRows(const RowVectorPtr& input);
+
+  // Copies the columnar table rows in 'input' into new rows of 'table_' and
+  // returns the new rows in 'newRows'.
+  void storeColumnarRows(
+      const RowVectorPtr& input,
+      std::vector<char*>& newRows);
+
+  // Runs the join keys of 'newRows' stored in 'table_' through the table's
+  // VectorHashers while 'analyzeKeys_' is true.
+  void analyzeStoredKeys(std::vector<char*>& newRows);
+
   // Set up for null-aware and regular anti-join with filter processing.
   void setupFilterForAntiJoins(
       const folly::F14FastMap<column_index_t, column_index_t>& keyChannelMap);
@@ -219,6 +272,14 @@ class HashBuild final : public Operator {
   // not.
   const bool needProbedFlagSpill_;
 
+  // True if the last hash build operator reloads the spilled partitions which
+  // fit in memory before handing the table to the probe side.
+  const bool hybridSpillEnabled_;
+
+  // The estimated ratio of the memory needed to reload a spilled partition into
+  // the join table to its spilled file size.
+  const double hybridSpillReloadMemoryRatio_;
+
   std::shared_ptr<HashJoinBridge> joinBridge_;
 
   tsan_atomic<bool> exceededMaxSpillLevelLimit_{false};
@@ -332,6 +393,10 @@ class HashBuildSpiller : public SpillerBase {
       const common::SpillConfig* spillConfig,
       folly::Synchronized<common::SpillStats>* spillStats);
 
+  /// Returns the type of the spilled batches which hold the table rows in the
+  /// RowContainer's serialized row layout.
+  static const RowTypePtr& serializedRowType();
+
   /// Invoked to spill all the rows stored in the row container of the hash
   /// build.
   void spill();
@@ -359,6 +424,11 @@ class HashBuildSpiller : public SpillerBase {
 
   const bool spillProbeFlag_;
 
+  // If true, the table rows are spilled in the RowContainer's serialized row
+  // layout. The input rows spilled by 'spill(partitionId, spillVector)' are
+  // still written as columns.
+  const bool spillSerializedRows_;
+
   bool spillTriggered_{false};
 };
 } // namespace facebook::velox::exec
@@ -83,7 +83,10 @@ void HashJoinBridge::reclaim() {
   buildResult_->table->clear(true);
 
   appendSpilledHashTablePartitionsLocked(std::move(spillPartitionSet));
-  buildResult_->spillPartitionIds = spillPartitionIdSet;
+  // NOTE: the table might only hold part of the partitions if hybrid join
+  // spilling is enabled, and the rest have been spilled while building it.
+  buildResult_->spillPartitionIds.insert(
+      spillPartitionIdSet.begin(), spillPartitionIdSet.end());
   VELOX_CHECK(!restoringSpillPartitionId_.has_value());
 }
 
@@ -215,9 +218,12 @@ void HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys,
-    HashJoinTableSpillFunc&& tableSpillFunc) {
+    HashJoinTableSpillFunc&& tableSpillFunc,
+    bool hybridReloaded) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
-  VELOX_CHECK(table->numDistinct() == 0 || spillPartitionSet.empty());
+  VELOX_CHECK(
+      hybridReloaded || table->numDistinct() == 0 ||
+      spillPartitionSet.empty());
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -53,11 +53,15 @@ class HashJoinBridge : public JoinBridge {
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
+  /// 'hybridReloaded' is true if part of the spilled partitions have been
+  /// reloaded into 'table' by hybrid join spilling, in which case both 'table'
+  /// and 'spillPartitionSet' can be non-empty.
   void setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys,
-      HashJoinTableSpillFunc&& tableSpillFunc);
+      HashJoinTableSpillFunc&& tableSpillFunc,
+      bool hybridReloaded = false);
 
   void setHashTable(
       std::shared_ptr<wave::HashTableHolder> table,
@@ -104,7 +108,8 @@ class HashJoinBridge : public JoinBridge {
 
     /// Spilled partitions while building hash table. Since we don't support
     /// fine-grained spilling for hash table, either 'table' is empty or
-    /// 'spillPartitionIds' is empty.
+    /// 'spillPartitionIds' is empty, unless hybrid join spilling has reloaded
+    /// part of the spilled partitions into 'table'.
     SpillPartitionIdSet spillPartitionIds;
   };
 
@@ -83,6 +83,114 @@ void extractColumns(
   }
 }
 
+// Loads a build side column of the probe output from the matched table rows.
+// 'rows' holds the table row pointers for the output rows, and 'table' keeps
+// them alive. The load may run on any thread that accesses the output, so the
+// values are allocated from 'pool' which is not the operator pool.
+// 'numLoadedRows' counts the loaded rows across all loaders of an operator.
+class TableColumnLoader : public VectorLoader {
+ public:
+  TableColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      BufferPtr rows,
+      vector_size_t numRows,
+      int32_t columnIndex,
+      memory::MemoryPool* pool,
+      std::shared_ptr<std::atomic_uint64_t> numLoadedRows)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        numRows_(numRows),
+        columnIndex_(columnIndex),
+        pool_(pool),
+        numLoadedRows_(std::move(numLoadedRows)) {}
+
+ private:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    // NOTE: aggregation pushdown never applies to the probe output as the hash
+    // probe is not a filter operator.
+    VELOX_CHECK_NULL(hook, "Lazy hash probe output doesn't support value hook");
+    VELOX_CHECK_LE(resultSize, numRows_);
+    *numLoadedRows_ += rows.size();
+    auto& child = *result;
+    if (!child || !BaseVector::isVectorWritable(child) ||
+        !child->isFlatEncoding()) {
+      child = BaseVector::create(
+          table_->rows()->columnTypes()[columnIndex_], resultSize, pool_);
+    }
+    child->resize(resultSize);
+
+    const folly::Range<char* const*> tableRows(
+        rows_->as<char*>(), resultSize);
+    if (rows.size() == resultSize) {
+      table_->extractColumn(tableRows, columnIndex_, child);
+      return;
+    }
+    // Only copies out the accessed rows and sets the others to null.
+    rowNumbers_.resize(resultSize);
+    std::fill(rowNumbers_.begin(), rowNumbers_.end(), -1);
+    for (const auto row : rows) {
+      rowNumbers_[row] = row;
+    }
+    table_->extractColumn(
+        tableRows,
+        folly::Range<const vector_size_t*>(rowNumbers_.data(), resultSize),
+        columnIndex_,
+        child);
+  }
+
+  const std::shared_ptr<BaseHashTable> table_;
+  const BufferPtr rows_;
+  const vector_size_t numRows_;
+  const int32_t columnIndex_;
+  memory::MemoryPool* const pool_;
+  const std::shared_ptr<std::atomic_uint64_t> numLoadedRows_;
+  raw_vector<vector_size_t> rowNumbers_;
+};
+
+// Sets the build side columns in 'resultVectors' according to 'projections' to
+// lazy vectors which are loaded from 'rows' of 'table' on first access. The
+// row pointers are copied into 'pool' and the loaded values are allocated from
+// 'lazyPool'.
+void makeLazyColumns(
+    const std::shared_ptr<BaseHashTable>& table,
+    folly::Range<char* const*> rows,
+    folly::Range<const IdentityProjection*> projections,
+    memory::MemoryPool* pool,
+    memory::MemoryPool* lazyPool,
+    const std::shared_ptr<std::atomic_uint64_t>& numLoadedRows,
+    const std::vector<TypePtr>& resultTypes,
+    std::vector<VectorPtr>& resultVectors) {
+  VELOX_CHECK_EQ(resultTypes.size(), resultVectors.size());
+  if (projections.empty()) {
+    return;
+  }
+  // The output table rows buffer is reused across output batches, so make a
+  // copy shared by the lazy vectors of this batch.
+  const auto numRows = rows.size();
+  auto rowsBuffer = AlignedBuffer::allocate<char*>(numRows, pool);
+  std::memcpy(
+      rowsBuffer->asMutable<char*>(), rows.data(), numRows * sizeof(char*));
+  for (auto projection : projections) {
+    const auto resultChannel = projection.outputChannel;
+    VELOX_CHECK_LT(resultChannel, resultVectors.size());
+    resultVectors[resultChannel] = std::make_shared<LazyVector>(
+        lazyPool,
+        resultTypes[resultChannel],
+        numRows,
+        std::make_unique<TableColumnLoader>(
+            table,
+            rowsBuffer,
+            numRows,
+            projection.inputChannel,
+            lazyPool,
+            numLoadedRows));
+  }
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -125,6 +233,8 @@ HashProbe::HashProbe(
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
+      lazyBuildColumns_{
+          driverCtx->queryConfig().hashProbeLazyBuildColumnsEnabled()},
       probeType_(joinNode_->sources()[0]->outputType()),
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
@@ -132,6 +242,19 @@ HashProbe::HashProbe(
       filterResult_(1),
       outputTableRowsCapacity_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
+  if (lazyBuildColumns_) {
+    // Shares the async pool of the spill read-ahead if there is one.
+    lazyOutputPool_ =
+        spillConfig() != nullptr && spillConfig()->readAheadPool != nullptr
+        ? spillConfig()->readAheadPool
+        : operatorCtx_->task()->addOperatorAsyncPool(
+              planNodeId(),
+              operatorCtx_->driverCtx()->splitGroupId,
+              operatorCtx_->driverCtx()->pipelineId,
+              operatorCtx_->driverCtx()->driverId,
+              operatorType());
+    numLazyOutputRowsLoaded_ = std::make_shared<std::atomic_uint64_t>(0);
+  }
 }
 
 void HashProbe::initialize() {
@@ -288,7 +411,11 @@ void HashProbe::maybeSetupSpillInputReader(
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   restoringPartitionId_ = restoredPartitionId;
   spillInputReader_ = partition->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->asyncIoExecutor(),
+      spillConfig_->readAheadPool);
   inputSpillPartitionSet_.erase(iter);
 }
 
@@ -457,6 +584,15 @@ bool HashProbe::isSpillInput() const {
   return spillInputReader_ != nullptr;
 }
 
+void HashProbe::clearTable() {
+  // The lazy build side columns in the output of any prober may still point to
+  // the table rows. The rows are freed with the table when the last of them is
+  // released.
+  if (!table_->hasLazyOutput()) {
+    table_->clear(true);
+  }
+}
+
 void HashProbe::prepareForSpillRestore() {
   checkRunning();
   VELOX_CHECK(canSpill());
@@ -465,7 +601,7 @@ void HashProbe::prepareForSpillRestore() {
   // Reset the internal states which are relevant to the previous probe run.
   noMoreSpillInput_ = false;
   if (lastProber_) {
-    table_->clear(true);
+    clearTable();
   }
   table_.reset();
   inputSpiller_.reset();
@@ -833,6 +969,13 @@ void HashProbe::fillLeftSemiProjectMatchColumn(vector_size_t size) {
 }
 
 void HashProbe::fillOutput(vector_size_t size) {
+  if (lazyBuildColumns_ && output_ != nullptr && output_.use_count() == 1) {
+    // Lazy vectors are not reusable, so reset them to avoid allocating new
+    // flat vectors in prepareOutput() which are replaced right away.
+    for (const auto& projection : tableOutputProjections_) {
+      output_->childAt(projection.outputChannel) = nullptr;
+    }
+  }
   prepareOutput(size);
 
   for (auto [in, out] : projectedInputColumns_) {
@@ -845,6 +988,19 @@ void HashProbe::fillOutput(vector_size_t size) {
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    // The lazy columns share the table reference with those of the peer
+    // probers. See nonReclaimableState() and clearTable().
+    makeLazyColumns(
+        table_->lazyOutputReference(table_),
+        folly::Range<char* const*>(outputTableRows_->as<char*>(), size),
+        tableOutputProjections_,
+        pool(),
+        lazyOutputPool_,
+        numLazyOutputRowsLoaded_,
+        outputType_->children(),
+        output_->children());
+    numLazyOutputRows_ += size * tableOutputProjections_.size();
   } else {
     extractColumns(
         table_.get(),
@@ -1066,7 +1222,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
         } else {
           joinBridge_->probeFinished();
           if (table_ != nullptr) {
-            table_->clear(true);
+            clearTable();
           }
         }
         wakeupPeerOperators();
@@ -1759,7 +1915,10 @@ bool HashProbe::nonReclaimableState() const {
   return (state_ != ProbeOperatorState::kRunning &&
           state_ != ProbeOperatorState::kWaitForPeers) ||
       nonReclaimableSection_ || (inputSpiller_ != nullptr) ||
-      (table_ == nullptr) || (table_->numDistinct() == 0);
+      (table_ == nullptr) || (table_->numDistinct() == 0) ||
+      // The lazy build side columns in the output of this or a peer prober
+      // still point to the table rows.
+      table_->hasLazyOutput();
 }
 
 void HashProbe::ensureOutputFits() {
@@ -2012,7 +2171,11 @@ void HashProbe::maybeSetupSpillOutputReader() {
 
   spillOutputReader_ =
       spillOutputPartitionSet_.begin()->second->createUnorderedReader(
-          spillConfig_->readBufferSize, pool(), &spillStats_);
+          spillConfig_->readBufferSize,
+          pool(),
+          &spillStats_,
+          spillConfig_->asyncIoExecutor(),
+          spillConfig_->readAheadPool);
   spillOutputPartitionSet_.clear();
 }
 
@@ -2060,6 +2223,18 @@ void HashProbe::close() {
   spillOutputReader_.reset();
   clearBuffers();
 
+  if (lazyBuildColumns_ && numLazyOutputRows_ > 0) {
+    // Loads that happen after this operator is closed, e.g. in another
+    // pipeline, are not counted.
+    addRuntimeStat(
+        "lazyBuildColumnRows",
+        RuntimeCounter(static_cast<int64_t>(numLazyOutputRows_)));
+    addRuntimeStat(
+        "lazyBuildColumnRowsLoaded",
+        RuntimeCounter(static_cast<int64_t>(numLazyOutputRowsLoaded_->load())));
+    numLazyOutputRows_ = 0;
+  }
+
   // Fullfill any pending promises
   if (lastProber_) {
     wakeupPeerOperators();
@@ -288,6 +288,10 @@ class HashProbe : public Operator {
   // table from spilled data.
   void prepareForSpillRestore();
 
+  // Frees the rows of 'table_' unless a lazy build side column in the output
+  // still points to them.
+  void clearTable();
+
   // Invoked to read next batch of spilled probe inputs from disk to process.
   void addSpillInput();
 
@@ -377,6 +381,10 @@ class HashProbe : public Operator {
 
   const bool nullAware_;
 
+  // If true, the projected build side columns in the probe output are lazy
+  // vectors backed by the matched table rows.
+  const bool lazyBuildColumns_;
+
   const RowTypePtr probeType_;
 
   std::shared_ptr<HashJoinBridge> joinBridge_;
@@ -431,6 +439,16 @@ class HashProbe : public Operator {
   // Drivers of the same pipeline.
   std::shared_ptr<BaseHashTable> table_;
 
+  // Allocates the values of the lazy build side columns in the output if
+  // 'lazyBuildColumns_' is true. These are loaded by whichever thread accesses
+  // them first, which need not be the driver thread of this operator.
+  memory::MemoryPool* lazyOutputPool_{nullptr};
+
+  // The number of lazy build side column rows in the output and the number of
+  // them that have been loaded.
+  uint64_t numLazyOutputRows_{0};
+  std::shared_ptr<std::atomic_uint64_t> numLazyOutputRowsLoaded_;
+
   // Indicates whether there was no input. Used for right semi join project.
   bool noInput_{true};
 
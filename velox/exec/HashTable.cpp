@@ -43,6 +43,29 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+std::shared_ptr<BaseHashTable> BaseHashTable::lazyOutputReference(
+    const std::shared_ptr<BaseHashTable>& self) {
+  VELOX_CHECK_EQ(self.get(), this);
+  std::lock_guard<std::mutex> l(lazyOutputMutex_);
+  auto reference = lazyOutputReference_.lock();
+  if (reference == nullptr) {
+    // The deleter releases the owning reference when the last lazy column is
+    // gone. It is reset explicitly as the weak reference held by this table
+    // keeps the deleter itself alive.
+    reference = std::shared_ptr<BaseHashTable>(
+        this, [owner = self](BaseHashTable* /*unused*/) mutable {
+          owner.reset();
+        });
+    lazyOutputReference_ = reference;
+  }
+  return reference;
+}
+
+bool BaseHashTable::hasLazyOutput() const {
+  std::lock_guard<std::mutex> l(lazyOutputMutex_);
+  return !lazyOutputReference_.expired();
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
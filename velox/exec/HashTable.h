@@ -434,6 +434,28 @@ class BaseHashTable {
       int32_t columnIndex,
       const VectorPtr& result) = 0;
 
+  /// Copies the values at 'columnIndex' into 'result' for the rows at
+  /// positions in 'rowNumbers' from 'rows'. If a row number is negative or the
+  /// entry in 'rows' is null, sets corresponding row in 'result' to null.
+  virtual void extractColumn(
+      folly::Range<char* const*> rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t columnIndex,
+      const VectorPtr& result) = 0;
+
+  /// Returns a reference to this table which is held by the lazy build side
+  /// columns in the hash probe output while they point to its rows. All the
+  /// probe operators share the same reference count so hasLazyOutput() tells
+  /// if any such column is alive. 'self' is the owner of this table. The
+  /// table is kept alive until the last reference is gone.
+  std::shared_ptr<BaseHashTable> lazyOutputReference(
+      const std::shared_ptr<BaseHashTable>& self);
+
+  /// Returns true if any lazy build side column in the hash probe output still
+  /// points to the rows of this table. The rows can't be freed or spilled in
+  /// this case.
+  bool hasLazyOutput() const;
+
  protected:
   static FOLLY_ALWAYS_INLINE size_t tableSlotSize() {
     // Each slot is 8 bytes.
@@ -449,6 +471,10 @@ class BaseHashTable {
   std::unique_ptr<RowContainer> rows_;
 
   ParallelJoinBuildStats parallelJoinBuildStats_;
+
+ private:
+  mutable std::mutex lazyOutputMutex_;
+  std::weak_ptr<BaseHashTable> lazyOutputReference_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -673,6 +699,20 @@ class HashTable : public BaseHashTable {
         result);
   }
 
+  void extractColumn(
+      folly::Range<char* const*> rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t columnIndex,
+      const VectorPtr& result) override {
+    RowContainer::extractColumn(
+        rows.data(),
+        rowNumbers,
+        rows_->columnAt(columnIndex),
+        columnHasNulls_[columnIndex],
+        0,
+        result);
+  }
+
   auto& testingOtherTables() const {
     return otherTables_;
   }
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/NumaDriverExecutor.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/memory/Numa.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace facebook::velox::exec {
+namespace {
+// Starts threads that run on the CPUs of a NUMA node and prefer its memory.
+class NodeThreadFactory : public folly::NamedThreadFactory {
+ public:
+  explicit NodeThreadFactory(int32_t node)
+      : folly::NamedThreadFactory(fmt::format("Driver.node{}", node)),
+        node_(node),
+        cpus_(memory::numaNodeCpus(node)) {}
+
+  std::thread newThread(folly::Func&& func) override {
+    return folly::NamedThreadFactory::newThread(
+        [node = node_, cpus = cpus_, func = std::move(func)]() mutable {
+          bindToCpus(cpus);
+          memory::ScopedNumaNode numaNode(node);
+          func();
+        });
+  }
+
+ private:
+  static void bindToCpus(const std::vector<int32_t>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) {
+      return;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : cpus) {
+      CPU_SET(cpu, &cpuSet);
+    }
+    const auto rc =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (rc != 0) {
+      LOG(WARNING) << "Failed to bind driver thread to NUMA node CPUs: "
+                   << folly::errnoStr(rc);
+    }
+#endif
+  }
+
+  const int32_t node_;
+  const std::vector<int32_t> cpus_;
+};
+} // namespace
+
+NumaDriverExecutor::NumaDriverExecutor(int32_t threadsPerNode, int32_t numNodes)
+    : threadsPerNode_(threadsPerNode) {
+  VELOX_CHECK_GT(threadsPerNode_, 0);
+  if (numNodes == 0) {
+    numNodes = memory::numaNumNodes();
+  }
+  VELOX_CHECK_GT(numNodes, 0);
+  for (auto node = 0; node < numNodes; ++node) {
+    executors_.push_back(std::make_unique<folly::CPUThreadPoolExecutor>(
+        threadsPerNode_, std::make_shared<NodeThreadFactory>(node)));
+  }
+  nodeDrivers_.resize(numNodes, 0);
+}
+
+NumaDriverExecutor::~NumaDriverExecutor() {
+  for (auto& executor : executors_) {
+    executor->join();
+  }
+}
+
+void NumaDriverExecutor::add(folly::Func func) {
+  executors_[nextNode_++ % executors_.size()]->add(std::move(func));
+}
+
+folly::Executor* NumaDriverExecutor::nodeExecutor(int32_t node) const {
+  VELOX_CHECK_GE(node, 0);
+  VELOX_CHECK_LT(node, executors_.size());
+  return executors_[node].get();
+}
+
+int32_t NumaDriverExecutor::acquireNode(int32_t numDrivers) {
+  if (numDrivers > threadsPerNode_) {
+    return memory::kNoNumaNode;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto node =
+      std::min_element(nodeDrivers_.begin(), nodeDrivers_.end()) -
+      nodeDrivers_.begin();
+  if (nodeDrivers_[node] + numDrivers > threadsPerNode_) {
+    // The Drivers would wait for the threads of the node while other nodes
+    // may have free threads.
+    return memory::kNoNumaNode;
+  }
+  nodeDrivers_[node] += numDrivers;
+  return node;
+}
+
+void NumaDriverExecutor::releaseNode(int32_t node, int32_t numDrivers) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_LT(node, nodeDrivers_.size());
+  VELOX_CHECK_GE(nodeDrivers_[node], numDrivers);
+  nodeDrivers_[node] -= numDrivers;
+}
+
+int32_t NumaDriverExecutor::numNodeDrivers(int32_t node) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_LT(node, nodeDrivers_.size());
+  return nodeDrivers_[node];
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor for Drivers on a host with several NUMA nodes. Has a thread pool
+/// per node whose threads run on the CPUs of the node. A Task whose Drivers
+/// fit in the threads of one node is assigned the node with the fewest Drivers
+/// (see acquireNode()). Its Drivers then run only on that node and its memory
+/// pool prefers the memory of the node, so that hash tables and row containers
+/// are not accessed across the interconnect. Tasks that do not fit, and other
+/// work added through add(), are spread over all nodes.
+///
+/// To use, set as the executor of the QueryCtx and create the MemoryManager
+/// with a NUMA aware allocator.
+class NumaDriverExecutor : public folly::Executor {
+ public:
+  /// Creates a pool of 'threadsPerNode' threads for each of 'numNodes' nodes.
+  /// If 'numNodes' is 0, uses the nodes of the host.
+  explicit NumaDriverExecutor(int32_t threadsPerNode, int32_t numNodes = 0);
+
+  ~NumaDriverExecutor() override;
+
+  /// Runs 'func' on the nodes in round robin order.
+  void add(folly::Func func) override;
+
+  int32_t numNodes() const {
+    return executors_.size();
+  }
+
+  int32_t threadsPerNode() const {
+    return threadsPerNode_;
+  }
+
+  /// Returns the executor whose threads run on 'node'.
+  folly::Executor* nodeExecutor(int32_t node) const;
+
+  /// Assigns a node to a Task with 'numDrivers' concurrent Drivers. Returns
+  /// the node with the fewest assigned Drivers or kNoNumaNode if the Drivers do
+  /// not fit in the threads of that node that are not assigned to other Tasks.
+  /// A node that is returned must be released with releaseNode().
+  int32_t acquireNode(int32_t numDrivers);
+
+  /// Releases the assignment of 'numDrivers' to 'node'.
+  void releaseNode(int32_t node, int32_t numDrivers);
+
+  /// Returns the number of Drivers assigned to 'node'.
+  int32_t numNodeDrivers(int32_t node) const;
+
+ private:
+  const int32_t threadsPerNode_;
+
+  std::vector<std::unique_ptr<folly::CPUThreadPoolExecutor>> executors_;
+
+  // Next node for add().
+  std::atomic<uint32_t> nextNode_{0};
+
+  mutable std::mutex mutex_;
+  // Number of Drivers assigned to each node.
+  std::vector<int32_t> nodeDrivers_;
+};
+
+} // namespace facebook::velox::exec
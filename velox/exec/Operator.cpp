@@ -74,6 +74,26 @@ OperatorCtx::createConnectorQueryCtx(
   return connectorQueryCtx;
 }
 
+namespace {
+// Sets the read-ahead pool of 'spillConfig' if the spill IO is asynchronous.
+// The pool is an async leaf pool of the operator's plan node, so that the
+// spilled batches restored on the spill executor are charged to the query.
+std::optional<common::SpillConfig> withReadAheadPool(
+    std::optional<common::SpillConfig> spillConfig,
+    const OperatorCtx& operatorCtx) {
+  if (spillConfig.has_value() && spillConfig->asyncIoExecutor() != nullptr) {
+    const auto* driverCtx = operatorCtx.driverCtx();
+    spillConfig->readAheadPool = operatorCtx.task()->addOperatorAsyncPool(
+        operatorCtx.planNodeId(),
+        driverCtx->splitGroupId,
+        driverCtx->pipelineId,
+        driverCtx->driverId,
+        operatorCtx.operatorType());
+  }
+  return spillConfig;
+}
+} // namespace
+
 Operator::Operator(
     DriverCtx* driverCtx,
     RowTypePtr outputType,
@@ -87,7 +107,7 @@ Operator::Operator(
           operatorId,
           operatorType)),
       outputType_(std::move(outputType)),
-      spillConfig_(std::move(spillConfig)),
+      spillConfig_(withReadAheadPool(std::move(spillConfig), *operatorCtx_)),
       stats_(OperatorStats{
           operatorId,
           driverCtx->pipelineId,
@@ -59,6 +59,14 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
+  const auto& queryConfig = driverCtx->queryConfig();
+  ParallelSortConfig parallelSortConfig;
+  if (queryConfig.parallelSortMinRows() > 0) {
+    parallelSortConfig = {
+        driverCtx->task->driverExecutor(),
+        queryConfig.parallelSortMinRows(),
+        queryConfig.parallelSortParallelism()};
+  }
   sortBuffer_ = std::make_unique<SortBuffer>(
       outputType_,
       sortColumnIndices,
@@ -67,7 +75,8 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       driverCtx->prefixSortConfig(),
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      parallelSortConfig);
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -64,6 +64,13 @@ Accumulator::Accumulator(Aggregate* aggregate, TypePtr spillType)
         aggregate->destroy(groups);
       }} {
   VELOX_CHECK_NOT_NULL(aggregate);
+  if (aggregate->supportsAccumulatorRelocation()) {
+    relocateFunction_ = [aggregate](
+                            folly::Range<char**> groups,
+                            const HashStringAllocator::Relocator& relocator) {
+      aggregate->relocateAccumulators(groups, relocator);
+    };
+  }
 }
 
 Accumulator::Accumulator(
@@ -103,6 +110,17 @@ void Accumulator::destroy(folly::Range<char**> groups) {
   destroyFunction_(groups);
 }
 
+bool Accumulator::supportsRelocation() const {
+  return relocateFunction_ != nullptr;
+}
+
+void Accumulator::relocate(
+    folly::Range<char**> groups,
+    const HashStringAllocator::Relocator& relocator) {
+  VELOX_CHECK(supportsRelocation());
+  relocateFunction_(groups, relocator);
+}
+
 const TypePtr& Accumulator::spillType() const {
   return spillType_;
 }
@@ -733,7 +751,7 @@ void RowContainer::extractSerializedRows(
     size_t offset = 0;
 
     // Copy nulls and other flags.
-    ::memcpy(rawBuffer + offset, row + rowColumns_[0].nullByte(), flagBytes_);
+    ::memcpy(rawBuffer + offset, row + flagsOffset(), flagBytes_);
     offset += flagBytes_;
 
     // Copy values.
@@ -765,7 +783,7 @@ void RowContainer::storeSerializedRow(
   const auto serialized = vector.valueAt(index);
   size_t offset = 0;
 
-  ::memcpy(row + rowColumns_[0].nullByte(), serialized.data(), flagBytes_);
+  ::memcpy(row + flagsOffset(), serialized.data(), flagBytes_);
   offset += flagBytes_;
 
   RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
@@ -783,6 +801,70 @@ void RowContainer::storeSerializedRow(
   }
 }
 
+void RowContainer::storeSerializedRows(
+    const FlatVector<StringView>& vector,
+    folly::Range<char**> rows) {
+  VELOX_CHECK_LE(rows.size(), vector.size());
+
+  // A step of copying a serialized row. A fixed-width step copies 'size' bytes
+  // to 'offset' of the row. A variable-width step stores the value of
+  // 'column'.
+  struct CopyStep {
+    int32_t offset;
+    int32_t size;
+    int32_t column;
+  };
+  constexpr int32_t kFixedWidth = -1;
+
+  // The flags come first in the serialized row, then the values in column
+  // order. Merges the consecutive fixed-width copies which are also adjacent
+  // in the row.
+  std::vector<CopyStep> steps;
+  steps.push_back({flagsOffset(), flagBytes_, kFixedWidth});
+  for (auto i = 0; i < types_.size(); ++i) {
+    if (!types_[i]->isFixedWidth()) {
+      steps.push_back({0, 0, i});
+      continue;
+    }
+    const auto offset = rowColumns_[i].offset();
+    const auto size = typeKindSize(types_[i]->kind());
+    auto& last = steps.back();
+    if (last.column == kFixedWidth && last.offset + last.size == offset) {
+      last.size += size;
+    } else {
+      steps.push_back({offset, size, kFixedWidth});
+    }
+  }
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    VELOX_CHECK(!vector.isNullAt(i));
+    const auto serialized = vector.valueAt(i);
+    char* row = rows[i];
+    size_t offset = 0;
+    for (const auto& step : steps) {
+      if (step.column == kFixedWidth) {
+        ::memcpy(row + step.offset, serialized.data() + offset, step.size);
+        offset += step.size;
+      } else {
+        RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+        offset += storeVariableSizeAt(
+            serialized.data() + offset, row, step.column);
+      }
+    }
+    VELOX_DCHECK_EQ(offset, serialized.size());
+  }
+
+  if (rowColumnsStats_.empty()) {
+    // Column stats have been invalidated.
+    return;
+  }
+  for (auto i = 0; i < types_.size(); ++i) {
+    for (auto* row : rows) {
+      updateColumnStats(row, i);
+    }
+  }
+}
+
 void RowContainer::extractString(
     StringView value,
     FlatVector<StringView>* values,
@@ -988,6 +1070,53 @@ void RowContainer::clear() {
   rowColumnsStats_.resize(types_.size());
 }
 
+bool RowContainer::canCompactStringAllocator() const {
+  for (const auto& accumulator : accumulators_) {
+    if (!accumulator.supportsRelocation()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t RowContainer::compactStringAllocator() {
+  VELOX_CHECK(canCompactStringAllocator());
+  return stringAllocator_->compact(
+      [&](const HashStringAllocator::Relocator& relocator) {
+        constexpr int32_t kBatch = 1000;
+        std::vector<char*> rows(kBatch);
+        RowContainerIterator iter;
+        while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+          relocateRows(folly::Range<char**>(rows.data(), numRows), relocator);
+        }
+      });
+}
+
+void RowContainer::relocateRows(
+    folly::Range<char**> rows,
+    const HashStringAllocator::Relocator& relocator) {
+  for (auto i = 0; i < types_.size(); ++i) {
+    switch (typeKinds_[i]) {
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        relocateVariableWidthFieldsAtColumn<StringView>(i, rows, relocator);
+        break;
+      }
+      case TypeKind::ROW:
+      case TypeKind::ARRAY:
+      case TypeKind::MAP: {
+        relocateVariableWidthFieldsAtColumn<std::string_view>(
+            i, rows, relocator);
+        break;
+      }
+      default:;
+    }
+  }
+  for (auto& accumulator : accumulators_) {
+    accumulator.relocate(rows, relocator);
+  }
+}
+
 void RowContainer::setProbedFlag(char** rows, int32_t numRows) {
   for (auto i = 0; i < numRows; i++) {
     // Row may be null in case of a FULL join.
@@ -58,6 +58,15 @@ class Accumulator {
 
   void destroy(folly::Range<char**> groups);
 
+  /// Returns true if relocate() is supported.
+  bool supportsRelocation() const;
+
+  /// Moves the variable width state of the accumulators in 'groups' with
+  /// 'relocator'. See HashStringAllocator::compact().
+  void relocate(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocator& relocator);
+
  private:
   const bool isFixedSize_;
   const int32_t fixedSize_;
@@ -66,6 +75,11 @@ class Accumulator {
   const TypePtr spillType_;
   std::function<void(folly::Range<char**>, VectorPtr&)> spillExtractFunction_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
+  // Null if the accumulators cannot be relocated.
+  std::function<void(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocator& relocator)>
+      relocateFunction_;
 };
 
 using normalized_key_t = uint64_t;
@@ -410,6 +424,14 @@ class RowContainer {
       vector_size_t index,
       char* row);
 
+  /// Copies the serialized rows produced by 'extractSerializedRows' from
+  /// 'vector' into 'rows', one serialized row per row. The flags and the
+  /// fixed-width values which are adjacent in both the serialized and the row
+  /// layout are copied as one block.
+  void storeSerializedRows(
+      const FlatVector<StringView>& vector,
+      folly::Range<char**> rows);
+
   /// Copies the values at 'col' into 'result' (starting at 'resultOffset')
   /// for the 'numRows' rows pointed to by 'rows'. If a 'row' is null, sets
   /// corresponding row in 'result' to null.
@@ -791,6 +813,16 @@ class RowContainer {
   /// Resets the state to be as after construction. Frees memory for payload.
   void clear();
 
+  /// Returns true if compactStringAllocator() can relocate all the variable
+  /// width data referenced by the rows, i.e. all accumulators support
+  /// relocation.
+  bool canCompactStringAllocator() const;
+
+  /// Moves the variable width keys, dependents and accumulators of all rows
+  /// into new blocks of 'stringAllocator_' and releases the fragmented slabs
+  /// to the pool. Returns the number of bytes released.
+  int64_t compactStringAllocator();
+
   int32_t compareRows(
       const char* left,
       const char* right,
@@ -929,6 +961,12 @@ class RowContainer {
   int32_t
   storeVariableSizeAt(const char* data, char* row, column_index_t column);
 
+  // Returns the offset of the first byte of the flags (null, probed, free) in
+  // a row.
+  int32_t flagsOffset() const {
+    return nullOffsets_[0] / 8;
+  }
+
   template <TypeKind Kind>
   static void extractColumnTyped(
       const char* const* rows,
@@ -1462,6 +1500,43 @@ class RowContainer {
     }
   }
 
+  // Relocates variable-width fields at column 'column_index' of 'rows' with
+  // 'relocator'. See freeVariableWidthFieldsAtColumn() for 'FieldType'.
+  template <typename FieldType>
+  void relocateVariableWidthFieldsAtColumn(
+      size_t column_index,
+      folly::Range<char**> rows,
+      const HashStringAllocator::Relocator& relocator) {
+    static_assert(
+        std::is_same_v<FieldType, StringView> ||
+        std::is_same_v<FieldType, std::string_view>);
+
+    const auto column = columnAt(column_index);
+    for (auto row : rows) {
+      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+        continue;
+      }
+
+      auto& view = valueAt<FieldType>(row, column.offset());
+      if constexpr (std::is_same_v<FieldType, StringView>) {
+        if (view.isInline()) {
+          continue;
+        }
+      } else {
+        if (view.empty()) {
+          continue;
+        }
+      }
+      auto* header = relocator(HashStringAllocator::headerOf(view.data()));
+      view = FieldType(header->begin(), view.size());
+    }
+  }
+
+  // Relocates the variable-width fields and accumulators of 'rows'.
+  void relocateRows(
+      folly::Range<char**> rows,
+      const HashStringAllocator::Relocator& relocator);
+
   // Free any variable-width fields associated with the 'rows' and zero out
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
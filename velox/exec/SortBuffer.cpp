@@ -15,10 +15,91 @@
  */
 
 #include "SortBuffer.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
+namespace {
+using SortedRows = std::vector<char*, memory::StlAllocator<char*>>;
+
+// Runs 'numTasks' of 'task' on 'executor' and waits for them to finish. Throws
+// the error of a failed task after all of them have finished.
+void runInParallel(
+    folly::Executor* executor,
+    int32_t numTasks,
+    const std::function<void(int32_t)>& task) {
+  // Passing driver context directly to avoid cross thread access to thread
+  // local driver thread context.
+  const DriverCtx* driverCtx{nullptr};
+  if (const auto* driverThreadCtx = driverThreadContext()) {
+    driverCtx = driverThreadCtx->driverCtx();
+  }
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+  steps.reserve(numTasks);
+  // All the steps must be synced also in case of error because they hold
+  // references to the rows to sort.
+  auto sync = folly::makeGuard([&]() {
+    for (auto& step : steps) {
+      try {
+        step->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (auto i = 0; i < numTasks; ++i) {
+    steps.push_back(std::make_shared<AsyncSource<bool>>([i, &task]() {
+      task(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([driverCtx, step = steps.back()]() {
+      ScopedDriverThreadContext scopedDriverThreadContext(driverCtx);
+      step->prepare();
+    });
+  }
+  for (auto& step : steps) {
+    step->move();
+  }
+}
+
+// Merges the rows in [begins[i], ends[i]) of each sorted run 'runs[i]' into
+// 'result' in sorted order.
+void mergeSortedRuns(
+    const RowContainer* data,
+    const std::vector<CompareFlags>& compareFlags,
+    const std::vector<SortedRows>& runs,
+    const std::vector<size_t>& begins,
+    const std::vector<size_t>& ends,
+    char** result) {
+  std::vector<size_t> positions = begins;
+  // Min heap of the run indices ordered by their current rows.
+  const auto greater = [&](size_t lhs, size_t rhs) {
+    return data->compareRows(
+               runs[lhs][positions[lhs]],
+               runs[rhs][positions[rhs]],
+               compareFlags) > 0;
+  };
+  std::vector<size_t> heap;
+  heap.reserve(runs.size());
+  for (auto i = 0; i < runs.size(); ++i) {
+    if (positions[i] < ends[i]) {
+      heap.push_back(i);
+    }
+  }
+  std::make_heap(heap.begin(), heap.end(), greater);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    const auto run = heap.back();
+    *result++ = runs[run][positions[run]++];
+    if (positions[run] < ends[run]) {
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else {
+      heap.pop_back();
+    }
+  }
+}
+} // namespace
 
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
@@ -28,7 +109,8 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     common::PrefixSortConfig prefixSortConfig,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    ParallelSortConfig parallelSortConfig)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
@@ -36,6 +118,7 @@ SortBuffer::SortBuffer(
       prefixSortConfig_(prefixSortConfig),
       spillConfig_(spillConfig),
       spillStats_(spillStats),
+      parallelSortConfig_(parallelSortConfig),
       sortedRows_(0, memory::StlAllocator<char*>(*pool)) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
@@ -131,8 +214,16 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    PrefixSort::sort(
-        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    if (canParallelSort()) {
+      parallelSort();
+    } else {
+      PrefixSort::sort(
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_,
+          pool_,
+          sortedRows_);
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -310,8 +401,9 @@ void SortBuffer::ensureSortFits() {
   }
 
   // The memory for std::vector sorted rows and prefix sort required buffer.
+  // Parallel sort needs another copy of the row pointers for the sorted runs.
   uint64_t sortBufferToReserve =
-      numInputRows_ * sizeof(char*) +
+      numInputRows_ * sizeof(char*) * (canParallelSort() ? 2 : 1) +
       PrefixSort::maxRequiredBytes(
           data_.get(), sortCompareFlags_, prefixSortConfig_, pool_);
   {
@@ -329,6 +421,86 @@ void SortBuffer::ensureSortFits() {
       succinctBytes(pool_->reservedBytes()));
 }
 
+bool SortBuffer::canParallelSort() const {
+  return parallelSortConfig_.executor != nullptr &&
+      parallelSortConfig_.parallelism > 1 &&
+      parallelSortConfig_.minRows > 0 &&
+      numInputRows_ >= parallelSortConfig_.minRows &&
+      numInputRows_ >= parallelSortConfig_.parallelism;
+}
+
+void SortBuffer::parallelSort() {
+  const auto numRows = sortedRows_.size();
+  const auto runSize =
+      bits::divRoundUp(numRows, parallelSortConfig_.parallelism);
+  std::vector<SortedRows> runs;
+  for (size_t offset = 0; offset < numRows; offset += runSize) {
+    const auto end = std::min(offset + runSize, numRows);
+    runs.emplace_back(
+        sortedRows_.begin() + offset,
+        sortedRows_.begin() + end,
+        memory::StlAllocator<char*>(*pool_));
+  }
+  const auto numRuns = runs.size();
+  runInParallel(parallelSortConfig_.executor, numRuns, [&](int32_t run) {
+    PrefixSort::sort(
+        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, runs[run]);
+  });
+
+  const auto lessThan = [&](const char* lhs, const char* rhs) {
+    return data_->compareRows(lhs, rhs, sortCompareFlags_) < 0;
+  };
+  // Samples evenly from each sorted run and picks the splitters of the key
+  // ranges evenly from the sorted samples.
+  const auto numRanges = numRuns;
+  std::vector<char*> samples;
+  samples.reserve(numRuns * (numRanges - 1));
+  for (const auto& run : runs) {
+    for (auto i = 1; i < numRanges; ++i) {
+      samples.push_back(run[i * run.size() / numRanges]);
+    }
+  }
+  std::sort(samples.begin(), samples.end(), lessThan);
+  std::vector<char*> splitters;
+  splitters.reserve(numRanges - 1);
+  for (auto i = 1; i < numRanges; ++i) {
+    splitters.push_back(samples[i * samples.size() / numRanges]);
+  }
+
+  // 'rangeBounds[i][run]' is the start position of the key range 'i' in 'run'.
+  std::vector<std::vector<size_t>> rangeBounds(
+      numRanges + 1, std::vector<size_t>(numRuns, 0));
+  for (auto run = 0; run < numRuns; ++run) {
+    for (auto i = 1; i < numRanges; ++i) {
+      rangeBounds[i][run] = std::lower_bound(
+                                runs[run].begin(),
+                                runs[run].end(),
+                                splitters[i - 1],
+                                lessThan) -
+          runs[run].begin();
+    }
+    rangeBounds[numRanges][run] = runs[run].size();
+  }
+  std::vector<size_t> rangeOffsets(numRanges + 1, 0);
+  for (auto i = 0; i < numRanges; ++i) {
+    rangeOffsets[i + 1] = rangeOffsets[i];
+    for (auto run = 0; run < numRuns; ++run) {
+      rangeOffsets[i + 1] += rangeBounds[i + 1][run] - rangeBounds[i][run];
+    }
+  }
+  VELOX_CHECK_EQ(rangeOffsets.back(), numRows);
+
+  runInParallel(parallelSortConfig_.executor, numRanges, [&](int32_t range) {
+    mergeSortedRuns(
+        data_.get(),
+        sortCompareFlags_,
+        runs,
+        rangeBounds[range],
+        rangeBounds[range + 1],
+        sortedRows_.data() + rangeOffsets[range]);
+  });
+}
+
 void SortBuffer::updateEstimatedOutputRowSize() {
   const auto optionalRowSize = data_->estimateRowSize();
   if (!optionalRowSize.has_value() || optionalRowSize.value() == 0) {
@@ -488,7 +660,11 @@ void SortBuffer::prepareOutputWithSpill() {
 
   VELOX_CHECK_EQ(spillPartitionSet_.size(), 1);
   spillMerger_ = spillPartitionSet_.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->asyncIoExecutor(),
+      spillConfig_->readAheadPool);
   spillPartitionSet_.clear();
 }
 } // namespace facebook::velox::exec
@@ -27,6 +27,20 @@ namespace facebook::velox::exec {
 class SortInputSpiller;
 class SortOutputSpiller;
 
+/// Specifies the config for sorting the buffered rows in parallel.
+struct ParallelSortConfig {
+  /// The executor to sort the runs and merge the key ranges on. Parallel sort
+  /// is disabled if it is null.
+  folly::Executor* executor{nullptr};
+
+  /// Minimum number of rows to sort in parallel.
+  uint64_t minRows{0};
+
+  /// The number of sorted runs which is also the number of key ranges to merge
+  /// in parallel.
+  uint32_t parallelism{8};
+};
+
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
 /// limit.
@@ -40,7 +54,8 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       common::PrefixSortConfig prefixSortConfig,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      ParallelSortConfig parallelSortConfig = {});
 
   ~SortBuffer();
 
@@ -83,6 +98,16 @@ class SortBuffer {
 
   void updateEstimatedOutputRowSize();
 
+  // Returns true if the in-memory rows are sorted in parallel as configured by
+  // 'parallelSortConfig_'.
+  bool canParallelSort() const;
+
+  // Sorts 'sortedRows_' in parallel. The rows are split into runs which are
+  // sorted separately. Then the sorted key space is split into ranges by the
+  // splitters sampled from the sorted runs, and the rows of each range are
+  // merged from all the runs into their final positions in 'sortedRows_'.
+  void parallelSort();
+
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(vector_size_t outputBatchSize);
 
@@ -127,6 +152,8 @@ class SortBuffer {
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  const ParallelSortConfig parallelSortConfig_;
+
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
   std::vector<IdentityProjection> columnMap_;
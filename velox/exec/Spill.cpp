@@ -71,7 +71,8 @@ SpillState::SpillState(
     const std::optional<common::PrefixSortConfig>& prefixSortConfig,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -81,6 +82,7 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       prefixSortConfig_(prefixSortConfig),
       fileCreateConfig_(fileCreateConfig),
+      writeExecutor_(writeExecutor),
       pool_(pool),
       stats_(stats) {}
 
@@ -162,7 +164,8 @@ uint64_t SpillState::appendToPartition(
               fileCreateConfig_,
               updateAndCheckSpillLimitCb_,
               pool_,
-              stats_));
+              stats_,
+              writeExecutor_));
     }
   });
 
@@ -278,13 +281,20 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor,
+    memory::MemoryPool* readAheadPool) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillBatchStream::create(SpillReadFile::create(
+        fileInfo,
+        bufferSize,
+        pool,
+        spillStats,
+        readAheadExecutor,
+        readAheadPool)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -295,12 +305,19 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor,
+    memory::MemoryPool* readAheadPool) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo,
+        bufferSize,
+        pool,
+        spillStats,
+        readAheadExecutor,
+        readAheadPool)));
   }
   files_.clear();
   // Check if the partition is empty or not.
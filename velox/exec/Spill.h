@@ -453,22 +453,31 @@ class SpillPartition {
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
   /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
-  /// stats when reading data from spilled files.
+  /// stats when reading data from spilled files. If 'readAheadExecutor' and
+  /// 'readAheadPool' are set, each spill file reads and deserializes its next
+  /// batch on it ahead of the consumer. See SpillReadFile.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      memory::MemoryPool* readAheadPool = nullptr);
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file
   /// system supports async read mode, then reader allocates two buffers with
   /// one buffer prefetch ahead. 'spillStats' is provided to collect the spill
-  /// stats when reading data from spilled files.
+  /// stats when reading data from spilled files. If 'readAheadExecutor' and
+  /// 'readAheadPool' are set, each merge stream reads and deserializes its
+  /// next batch on it while the current batch is being merged. See
+  /// SpillReadFile.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr,
+      memory::MemoryPool* readAheadPool = nullptr);
 
   std::string toString() const;
 
@@ -529,7 +538,8 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set, the spill files are written
+  /// asynchronously on it.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -541,7 +551,8 @@ class SpillState {
       const std::optional<common::PrefixSortConfig>& prefixSortConfig,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr);
 
   static std::vector<SpillSortKey> makeSortingKeys(
       const std::vector<CompareFlags>& compareFlags = {});
@@ -644,6 +655,7 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   const std::optional<common::PrefixSortConfig> prefixSortConfig_;
   const std::string fileCreateConfig_;
+  folly::Executor* const writeExecutor_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -32,16 +32,20 @@ static const bool kDefaultUseLosslessTimestamp = true;
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig) {
+    const std::string& fileCreateConfig,
+    folly::Executor* executor) {
   return std::unique_ptr<SpillWriteFile>(
-      new SpillWriteFile(id, pathPrefix, fileCreateConfig));
+      new SpillWriteFile(id, pathPrefix, fileCreateConfig, executor));
 }
 
 SpillWriteFile::SpillWriteFile(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig)
-    : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
+    const std::string& fileCreateConfig,
+    folly::Executor* executor)
+    : id_(id),
+      path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)),
+      executor_(executor) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   file_ = fs->openFileForWrite(
       path_,
@@ -52,8 +56,15 @@ SpillWriteFile::SpillWriteFile(
           std::nullopt});
 }
 
+SpillWriteFile::~SpillWriteFile() {
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
+}
+
 void SpillWriteFile::finish() {
   VELOX_CHECK_NOT_NULL(file_);
+  waitForPendingWrite();
   size_ = file_->size();
   file_->close();
   file_ = nullptr;
@@ -61,17 +72,54 @@ void SpillWriteFile::finish() {
 
 uint64_t SpillWriteFile::size() const {
   if (file_ != nullptr) {
+    if (pendingWrite_ != nullptr) {
+      // The backing file is being appended on the executor, so we can't access
+      // it here. 'size_' tracks the size before the pending write.
+      return size_ + pendingWriteBytes_;
+    }
     return file_->size();
   }
   return size_;
 }
 
 uint64_t SpillWriteFile::write(std::unique_ptr<folly::IOBuf> iobuf) {
-  auto writtenBytes = iobuf->computeChainDataLength();
-  file_->append(std::move(iobuf));
+  const auto writtenBytes = iobuf->computeChainDataLength();
+  if (executor_ == nullptr) {
+    file_->append(std::move(iobuf));
+    return writtenBytes;
+  }
+
+  waitForPendingWrite();
+  size_ = file_->size();
+  pendingWriteBytes_ = writtenBytes;
+  pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+      [this, iobuf = std::shared_ptr<folly::IOBuf>(std::move(iobuf))]() {
+        uint64_t writeTimeNs{0};
+        {
+          NanosecondTimer timer(&writeTimeNs);
+          file_->append(iobuf->clone());
+        }
+        return std::make_unique<uint64_t>(writeTimeNs);
+      });
+  executor_->add([pendingWrite = pendingWrite_]() { pendingWrite->prepare(); });
   return writtenBytes;
 }
 
+void SpillWriteFile::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  pendingWriteBytes_ = 0;
+  auto writeTimeNs = pendingWrite->move();
+  VELOX_CHECK_NOT_NULL(writeTimeNs);
+  asyncWriteTimeNs_ += *writeTimeNs;
+}
+
+uint64_t SpillWriteFile::takeAsyncWriteTimeNs() {
+  return std::exchange(asyncWriteTimeNs_, 0);
+}
+
 SpillWriterBase::SpillWriterBase(
     uint64_t writeBufferSize,
     uint64_t targetFileSize,
@@ -79,12 +127,14 @@ SpillWriterBase::SpillWriterBase(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor)
     : pool_(pool),
       stats_(stats),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileCreateConfig_(fileCreateConfig),
       pathPrefix_(pathPrefix),
+      writeExecutor_(writeExecutor),
       writeBufferSize_(writeBufferSize),
       targetFileSize_(targetFileSize) {}
 
@@ -115,6 +165,11 @@ uint64_t SpillWriterBase::flush() {
   uint64_t flushTimeNs{0};
   uint64_t writeTimeNs{0};
   flushBuffer(file, writtenBytes, flushTimeNs, writeTimeNs);
+  if (writeExecutor_ != nullptr) {
+    // The driver only measures the wait for the previous write. Reports the
+    // time spent in the writes completed on the executor instead.
+    writeTimeNs = file->takeAsyncWriteTimeNs();
+  }
   updateWriteStats(writtenBytes, flushTimeNs, writeTimeNs);
   updateAndCheckSpillLimitCb_(writtenBytes);
   return writtenBytes;
@@ -128,7 +183,8 @@ SpillWriteFile* SpillWriterBase::ensureFile() {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
         fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_);
+        fileCreateConfig_,
+        writeExecutor_);
   }
   return currentFile_.get();
 }
@@ -138,6 +194,9 @@ void SpillWriterBase::closeFile() {
     return;
   }
   currentFile_->finish();
+  // Reports the time of the last asynchronous write which completes in
+  // finish().
+  updateAsyncWriteTimeStats(currentFile_->takeAsyncWriteTimeNs());
   updateSpilledFileStats(currentFile_->size());
   addFinishedFile(currentFile_.get());
   currentFile_.reset();
@@ -173,6 +232,14 @@ void SpillWriterBase::updateWriteStats(
   common::updateGlobalSpillWriteStats(spilledBytes, flushTimeNs, writeTimeNs);
 }
 
+void SpillWriterBase::updateAsyncWriteTimeStats(uint64_t writeTimeNs) {
+  if (writeTimeNs == 0) {
+    return;
+  }
+  stats_->wlock()->spillWriteTimeNanos += writeTimeNs;
+  common::updateGlobalSpillWriteTimeNs(writeTimeNs);
+}
+
 void SpillWriterBase::updateSpilledFileStats(uint64_t fileSize) {
   ++stats_->wlock()->spilledFiles;
   addThreadLocalRuntimeStat(
@@ -199,7 +266,8 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor)
     : SpillWriterBase(
           writeBufferSize,
           targetFileSize,
@@ -207,7 +275,8 @@ SpillWriter::SpillWriter(
           fileCreateConfig,
           updateAndCheckSpillLimitCb,
           pool,
-          stats),
+          stats,
+          writeExecutor),
       type_(type),
       sortingKeys_(sortingKeys),
       compressionKind_(compressionKind),
@@ -236,6 +305,15 @@ void SpillWriter::flushBuffer(
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
+  if (FOLLY_UNLIKELY(!rows->type()->equivalent(*type_))) {
+    VELOX_CHECK(
+        sortingKeys_.empty(),
+        "Sorted spill writer can't change the spill type from {} to {}",
+        type_->toString(),
+        rows->type()->toString());
+    finishFile();
+    type_ = asRowType(rows->type());
+  }
   return writeWithBufferControl([&]() {
     if (batch_ == nullptr) {
       serializer::presto::PrestoVectorSerde::PrestoOptions options = {
@@ -294,7 +372,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    memory::MemoryPool* readAheadPool) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -304,7 +384,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortingKeys,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadExecutor,
+      readAheadPool));
 }
 
 SpillReadFile::SpillReadFile(
@@ -316,7 +398,9 @@ SpillReadFile::SpillReadFile(
     const std::vector<SpillSortKey>& sortingKeys,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor,
+    memory::MemoryPool* readAheadPool)
     : id_(id),
       path_(path),
       size_(size),
@@ -328,16 +412,56 @@ SpillReadFile::SpillReadFile(
           compressionKind_,
           0.8,
           /*nullsFirst=*/true},
-      pool_(pool),
+      pool_(
+          readAheadExecutor != nullptr && readAheadPool != nullptr
+              ? readAheadPool
+              : pool),
       serde_(getNamedVectorSerde(VectorSerde::Kind::kPresto)),
-      stats_(stats) {
+      stats_(stats),
+      readAheadExecutor_(
+          readAheadPool != nullptr ? readAheadExecutor : nullptr) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   input_ = std::make_unique<common::FileInputStream>(
       std::move(file), bufferSize, pool_);
 }
 
+SpillReadFile::~SpillReadFile() {
+  if (readAhead_ != nullptr) {
+    readAhead_->close();
+  }
+}
+
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
+  if (readAhead_ == nullptr) {
+    if (!readBatch(rowVector)) {
+      return false;
+    }
+  } else {
+    auto readAhead = std::move(readAhead_);
+    auto batch = readAhead->move();
+    VELOX_CHECK_NOT_NULL(batch);
+    rowVector = std::move(*batch);
+  }
+  maybeIssueReadAhead();
+  return true;
+}
+
+void SpillReadFile::maybeIssueReadAhead() {
+  VELOX_CHECK_NULL(readAhead_);
+  if (readAheadExecutor_ == nullptr || input_->atEnd()) {
+    return;
+  }
+  readAhead_ = std::make_shared<AsyncSource<RowVectorPtr>>([this]() {
+    auto batch = std::make_unique<RowVectorPtr>();
+    VELOX_CHECK(readBatch(*batch));
+    return batch;
+  });
+  readAheadExecutor_->add(
+      [readAhead = readAhead_]() { readAhead->prepare(); });
+}
+
+bool SpillReadFile::readBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     recordSpillStats();
     return false;
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -34,28 +35,43 @@ using SpillSortKey = std::pair<column_index_t, CompareFlags>;
 
 /// Represents a spill file for writing the serialized spilled data into a disk
 /// file.
+///
+/// If 'executor' is set, write(iobuf) issues the file append asynchronously on
+/// the executor and returns immediately so that the caller can serialize the
+/// next buffer while the previous one is being written. At most one write is
+/// outstanding per file: the next write, finish() or the destructor waits for
+/// the pending one to complete.
 class SpillWriteFile {
  public:
   static std::unique_ptr<SpillWriteFile> create(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      folly::Executor* executor = nullptr);
+
+  ~SpillWriteFile();
 
   uint32_t id() const {
     return id_;
   }
 
-  /// Returns the file size in bytes.
+  /// Returns the file size in bytes. If there is an outstanding asynchronous
+  /// write, the returned size includes the bytes being written.
   uint64_t size() const;
 
   const std::string& path() const {
     return path_;
   }
 
+  /// Appends 'iobuf' to the file and returns the number of appended bytes.
   uint64_t write(std::unique_ptr<folly::IOBuf> iobuf);
 
   void write(const char* data, uint64_t bytes);
 
+  /// Returns the time spent in the asynchronous writes which have completed
+  /// since the last call, and resets it.
+  uint64_t takeAsyncWriteTimeNs();
+
   WriteFile* file() {
     return file_.get();
   }
@@ -69,16 +85,32 @@ class SpillWriteFile {
   SpillWriteFile(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      folly::Executor* executor);
+
+  // Waits for the outstanding asynchronous write to complete if there is one.
+  // Rethrows the write error if any.
+  void waitForPendingWrite();
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
   const std::string path_;
+  // If not null, the executor to run file appends asynchronously.
+  folly::Executor* const executor_;
 
   std::unique_ptr<WriteFile> file_;
   // Byte size of the backing file. Set when finishing writing.
   uint64_t size_{0};
+
+  // The outstanding asynchronous write if not null. The item is the time spent
+  // in the write.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
+  // Number of bytes of 'pendingWrite_'.
+  uint64_t pendingWriteBytes_{0};
+  // The time spent in the completed asynchronous writes which has not been
+  // reported yet.
+  uint64_t asyncWriteTimeNs_{0};
 };
 
 /// Records info of a finished spill file which is used for read.
@@ -110,7 +142,8 @@ class SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr);
 
   virtual ~SpillWriterBase() = default;
 
@@ -178,6 +211,10 @@ class SpillWriterBase {
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
+  // Invoked to add the time spent in the asynchronous writes of a spill file
+  // which is not reported by updateWriteStats().
+  void updateAsyncWriteTimeStats(uint64_t writeTimeNs);
+
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
 
@@ -189,6 +226,9 @@ class SpillWriterBase {
 
   const std::string pathPrefix_;
 
+  // If not null, the executor to write spill files asynchronously.
+  folly::Executor* const writeExecutor_;
+
   const uint64_t writeBufferSize_;
 
   const uint64_t targetFileSize_;
@@ -209,7 +249,9 @@ class SpillWriter : public SpillWriterBase {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'writeExecutor' is set, the serialized buffers
+  /// are written to the spill files asynchronously on it, which overlaps the
+  /// serialization of the next buffer with the write of the previous one.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -223,13 +265,18 @@ class SpillWriter : public SpillWriterBase {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
   /// Consecutive calls must have sorted data so that the first row of the
   /// next call is not less than the last row of the previous call.
   /// Returns the size to write.
+  ///
+  /// NOTE: an unsorted spill writer accepts 'rows' of a different type than
+  /// the previous call. It finishes the current file first as each spill file
+  /// only stores one type of data.
   uint64_t write(
       const RowVectorPtr& rows,
       const folly::Range<IndexRange*>& indices);
@@ -255,7 +302,8 @@ class SpillWriter : public SpillWriterBase {
 
   void addFinishedFile(SpillWriteFile* file) override;
 
-  const RowTypePtr type_;
+  // The type of the data written to the current file.
+  RowTypePtr type_;
 
   const std::vector<SpillSortKey> sortingKeys_;
 
@@ -269,6 +317,14 @@ class SpillWriter : public SpillWriterBase {
 /// Represents a spill file for read which turns the serialized spilled data
 /// on disk back into a sequence of spilled row vectors.
 ///
+/// If 'readAheadExecutor' and 'readAheadPool' are set, the next batch is read
+/// and deserialized on the executor while the caller processes the current
+/// one. This holds up to two deserialized batches in memory per spill file.
+/// The batches are then allocated from 'readAheadPool' instead of 'pool', as
+/// the executor thread must not allocate from an operator pool which is
+/// subject to memory arbitration and reclaim. 'readAheadPool' is a thread-safe
+/// pool of the same query, see common::SpillConfig::readAheadPool.
+///
 /// NOTE: The class will not delete spill file upon destruction, so the user
 /// needs to remove the unused spill files at some point later. For example, a
 /// query Task deletes all the generated spill files in one operation using
@@ -279,7 +335,11 @@ class SpillReadFile {
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr,
+      memory::MemoryPool* readAheadPool = nullptr);
+
+  ~SpillReadFile();
 
   uint32_t id() const {
     return id_;
@@ -310,7 +370,17 @@ class SpillReadFile {
       const std::vector<SpillSortKey>& sortingKeys,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor,
+      memory::MemoryPool* readAheadPool);
+
+  // Reads and deserializes the next batch from 'input_'. Returns false if
+  // reaches the end of the file.
+  bool readBatch(RowVectorPtr& rowVector);
+
+  // Schedules the read of the next batch on 'readAheadExecutor_' if it is set
+  // and the file has more data to read.
+  void maybeIssueReadAhead();
 
   // Invoked to record spill read stats at the end of read input.
   void recordSpillStats();
@@ -329,7 +399,11 @@ class SpillReadFile {
   memory::MemoryPool* const pool_;
   VectorSerde* const serde_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const readAheadExecutor_;
 
   std::unique_ptr<common::FileInputStream> input_;
+
+  // The read-ahead of the next batch if not null.
+  std::shared_ptr<AsyncSource<RowVectorPtr>> readAhead_;
 };
 } // namespace facebook::velox::exec
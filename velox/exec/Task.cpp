@@ -28,6 +28,7 @@
 #include "velox/exec/LocalPlanner.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/NumaDriverExecutor.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -495,6 +496,40 @@ void Task::removeSpillDirectoryIfExists() {
   }
 }
 
+void Task::maybeAssignNumaNodeLocked() {
+  numaExecutor_ = dynamic_cast<NumaDriverExecutor*>(queryCtx_->executor());
+  if (numaExecutor_ == nullptr) {
+    return;
+  }
+  // The Drivers that may run at the same time.
+  const int32_t numDrivers =
+      numDriversPerSplitGroup_ * concurrentSplitGroups_ + numDriversUngrouped_;
+  numaNode_ = numaExecutor_->acquireNode(numDrivers);
+  if (numaNode_ == memory::kNoNumaNode) {
+    return;
+  }
+  numNumaDrivers_ = numDrivers;
+  // Before the Drivers are created, so that their pools inherit the node.
+  pool_->setPreferredNumaNode(numaNode_);
+}
+
+void Task::releaseNumaNodeLocked() {
+  if (numaNode_ == memory::kNoNumaNode || numNumaDrivers_ == 0) {
+    return;
+  }
+  // The node stays set so that Drivers that are still being closed run on the
+  // same executor.
+  numaExecutor_->releaseNode(numaNode_, numNumaDrivers_);
+  numNumaDrivers_ = 0;
+}
+
+folly::Executor* Task::driverExecutor() const {
+  if (numaNode_ != memory::kNoNumaNode) {
+    return numaExecutor_->nodeExecutor(numaNode_);
+  }
+  return queryCtx_->executor();
+}
+
 uint64_t Task::driverCpuTimeSliceLimitMs() const {
   return mode_ == Task::ExecutionMode::kSerial
       ? 0
@@ -589,6 +624,30 @@ velox::memory::MemoryPool* Task::addOperatorPool(
   return childPools_.back().get();
 }
 
+velox::memory::MemoryPool* Task::addOperatorAsyncPool(
+    const core::PlanNodeId& planNodeId,
+    uint32_t splitGroupId,
+    int pipelineId,
+    uint32_t driverId,
+    const std::string& operatorType) {
+  velox::memory::MemoryPool* nodePool;
+  if (isHashJoinOperator(operatorType)) {
+    nodePool = getOrAddJoinNodePool(planNodeId, splitGroupId);
+  } else {
+    nodePool = getOrAddNodePool(planNodeId);
+  }
+  childPools_.push_back(nodePool->addLeafChild(
+      fmt::format(
+          "op.{}.{}.{}.{}.async",
+          planNodeId,
+          pipelineId,
+          driverId,
+          operatorType),
+      true,
+      createExchangeClientReclaimer()));
+  return childPools_.back().get();
+}
+
 velox::memory::MemoryPool* Task::addConnectorPoolLocked(
     const core::PlanNodeId& planNodeId,
     int pipelineId,
@@ -909,6 +968,7 @@ void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   VELOX_CHECK(drivers_.empty());
 
   concurrentSplitGroups_ = concurrentSplitGroups;
+  maybeAssignNumaNodeLocked();
   // Pre-allocates slots for maximum possible number of drivers.
   if (numDriversPerSplitGroup_ > 0) {
     drivers_.resize(numDriversPerSplitGroup_ * concurrentSplitGroups_);
@@ -2321,6 +2381,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
         0,
         "Termination time has already been set, this should only happen once.");
     taskStats_.terminationTimeMs = getCurrentTimeMs();
+    releaseNumaNodeLocked();
     if (state_ == TaskState::kCanceled || state_ == TaskState::kAborted) {
       try {
         VELOX_FAIL(
@@ -32,6 +32,7 @@
 
 namespace facebook::velox::exec {
 
+class NumaDriverExecutor;
 class OutputBufferManager;
 
 class HashJoinBridge;
@@ -156,6 +157,16 @@ class Task : public std::enable_shared_from_this<Task> {
     return queryCtx_;
   }
 
+  /// Returns the executor the Drivers of this task run on. This is the
+  /// executor of the QueryCtx unless the task is assigned a NUMA node of a
+  /// NumaDriverExecutor.
+  folly::Executor* driverExecutor() const;
+
+  /// Returns the NUMA node the Drivers of this task run on or kNoNumaNode.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   /// Returns MemoryPool used to allocate memory during execution. This instance
   /// is a child of the MemoryPool passed in the constructor.
   memory::MemoryPool* pool() const {
@@ -408,6 +419,19 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t driverId,
       const std::string& operatorType);
 
+  /// Creates new instance of MemoryPool for the allocations an operator makes
+  /// outside of its driver thread, e.g. on an executor or in the thread of a
+  /// consumer of its output. The pool has a memory reclaimer which doesn't
+  /// reclaim from the operator, so it is safe to allocate from any thread.
+  /// Stores it in the task to ensure lifetime and returns a raw pointer. Not
+  /// thread safe, e.g. must be called from the Operator's constructor.
+  velox::memory::MemoryPool* addOperatorAsyncPool(
+      const core::PlanNodeId& planNodeId,
+      uint32_t splitGroupId,
+      int pipelineId,
+      uint32_t driverId,
+      const std::string& operatorType);
+
   /// Creates new instance of MemoryPool with aggregate kind for the connector
   /// use, stores it in the task to ensure lifetime and returns a raw pointer.
   /// Not thread safe, e.g. must be called from the Operator's constructor.
@@ -850,6 +874,14 @@ class Task : public std::enable_shared_from_this<Task> {
   // Invoked to initialize the memory pool for this task on creation.
   void initTaskPool();
 
+  // Assigns a NUMA node to 'this' if the QueryCtx executor is a
+  // NumaDriverExecutor and the Drivers fit on one node. Called before the
+  // Drivers are created.
+  void maybeAssignNumaNodeLocked();
+
+  // Releases the Driver count of 'this' on the NUMA node on termination.
+  void releaseNumaNodeLocked();
+
   // Creates a scaled scan controller for a given table scan node.
   void addScaledScanControllerLocked(
       uint32_t splitGroupId,
@@ -1290,6 +1322,13 @@ class Task : public std::enable_shared_from_this<Task> {
   // The number of splits groups we run concurrently.
   uint32_t concurrentSplitGroups_{1};
 
+  // Set if the QueryCtx executor is a NumaDriverExecutor and the Drivers fit
+  // on one of its nodes.
+  NumaDriverExecutor* numaExecutor_{nullptr};
+  int32_t numaNode_{memory::kNoNumaNode};
+  // Number of Drivers accounted to 'numaNode_'.
+  int32_t numNumaDrivers_{0};
+
   // Have we already initialized stats of operators in the drivers for Grouped
   // Execution?
   bool initializedGroupedOpStats_{false};
@@ -293,7 +293,11 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->asyncIoExecutor(),
+        spillConfig_->readAheadPool);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -27,6 +27,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashAggregation.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/PrefixSort.h"
 #include "velox/exec/Values.h"
@@ -1260,6 +1261,52 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+// Verify that the accumulators of a hash aggregation are compacted when the
+// free memory in their variable width storage exceeds
+// 'aggregation_compaction_free_ratio'.
+TEST_F(AggregationTest, compactAccumulators) {
+  // The hash tables of the map_agg accumulators grow and free their old
+  // storage as distinct keys come in. 100 groups get 10'000 keys each.
+  constexpr int32_t kNumGroups = 100;
+  constexpr int32_t kBatchSize = 10'000;
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 100; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kBatchSize, [](auto row) { return row % kNumGroups; }),
+        makeFlatVector<int64_t>(
+            kBatchSize, [i](auto row) { return i * kBatchSize + row; }),
+        makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+    }));
+  }
+
+  core::PlanNodeId aggNodeId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .singleAggregation(
+                      {"c0"}, {"map_agg(c1, c2)", "sum(c2)", "count(1)"})
+                  .capturePlanNodeId(aggNodeId)
+                  .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  // Disabled by default.
+  auto task = AssertQueryBuilder(plan).assertResults(expected);
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(aggNodeId).customStats.count(
+          HashAggregation::kCompactedBytes),
+      0);
+
+  task = AssertQueryBuilder(plan)
+             .config(QueryConfig::kAggregationCompactionFreeRatio, "0.1")
+             .assertResults(expected);
+  planStats = toPlanStats(task->taskStats());
+  const auto& compactedBytes =
+      planStats.at(aggNodeId).customStats.at(HashAggregation::kCompactedBytes);
+  ASSERT_GT(compactedBytes.sum, 0);
+  ASSERT_EQ(compactedBytes.unit, RuntimeCounter::Unit::kBytes);
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -3452,6 +3452,89 @@ TEST_F(HashJoinTest, lazyVectorPartiallyLoadedInFilterAntiJoin) {
       "SELECT t.c1, t.c2 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.c0 = u.c0 AND (t.c1 > 0 AND t.c2 > 0))");
 }
 
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(5, [&](int32_t /*unused*/) {
+        return makeRowVector(
+            {"t0", "t1"},
+            {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 23; }),
+             makeFlatVector<int64_t>(1'000, folly::identity)});
+      });
+  std::vector<RowVectorPtr> buildVectors =
+      makeBatches(3, [&](int32_t /*unused*/) {
+        return makeRowVector(
+            {"u0", "u1", "u2"},
+            {makeFlatVector<int32_t>(100, [](auto row) { return row % 31; }),
+             makeFlatVector<int64_t>(
+                 100, [](auto row) { return row * 3; }, nullEvery(7)),
+             makeFlatVector<std::string>(100, [](auto row) {
+               return fmt::format("payload string {}", row);
+             })});
+      });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::string filter;
+    std::string referenceQuery;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType: {}, filter: {}", core::joinTypeName(joinType), filter);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "t1 % 17 = 0",
+       "SELECT t0, t1, u1, u2 FROM t, u WHERE t0 = u0 AND t1 % 17 = 0"},
+      {core::JoinType::kLeft,
+       "t1 % 17 = 0",
+       "SELECT t0, t1, u1, u2 FROM t LEFT JOIN u ON t0 = u0 "
+       "WHERE t1 % 17 = 0"},
+      {core::JoinType::kFull,
+       "t1 % 17 = 0 OR t1 IS NULL",
+       "SELECT t0, t1, u1, u2 FROM t FULL OUTER JOIN u ON t0 = u0 "
+       "WHERE t1 % 17 = 0 OR t1 IS NULL"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    // The filter only accesses the probe side column, so the build side
+    // columns are only loaded for the rows that pass it.
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"t0", "t1", "u1", "u2"},
+                        testData.joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .filter(testData.filter)
+                    .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(plan))
+        .config(core::QueryConfig::kHashProbeLazyBuildColumnsEnabled, "true")
+        .checkSpillStats(false)
+        .referenceQuery(testData.referenceQuery)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          auto planStats = toPlanStats(task->taskStats());
+          const auto& joinStats = planStats.at(joinNodeId).customStats;
+          const auto numRows = joinStats.at("lazyBuildColumnRows").sum;
+          ASSERT_GT(numRows, 0);
+          // At most the rows that pass the filter are loaded, which is about
+          // one in 17 of the join output.
+          const auto it = joinStats.find("lazyBuildColumnRowsLoaded");
+          const auto numLoadedRows = it == joinStats.end() ? 0 : it->second.sum;
+          ASSERT_LT(numLoadedRows * 2, numRows);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, lazyVectorPartiallyLoadedInFilterInnerJoin) {
   // Test the case where a filter loads a subset of the rows that will be output
   // from a column on the probe side.
@@ -4809,6 +4892,181 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+DEBUG_ONLY_TEST_F(HashJoinTest, spillRowFormat) {
+  struct {
+    core::JoinType joinType;
+    std::string referenceQuery;
+
+    std::string debugString() const {
+      return fmt::format("joinType: {}", core::joinTypeName(joinType));
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0"},
+      {core::JoinType::kRight,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t RIGHT JOIN u "
+       "ON t.t_k0 = u.u_k0"},
+      {core::JoinType::kFull,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t FULL OUTER JOIN u "
+       "ON t.t_k0 = u.u_k0"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    // Spills the whole table once all the build input has been received so
+    // that all the spilled rows are table rows and restored from the
+    // serialized row layout.
+    std::atomic_bool spillTriggered{false};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::HashBuild::finishHashBuild",
+        std::function<void(exec::HashBuild*)>(
+            ([&](exec::HashBuild* hashBuild) {
+              if (spillTriggered.exchange(true)) {
+                return;
+              }
+              Operator::ReclaimableSectionGuard guard(hashBuild);
+              testingRunArbitration(hashBuild->pool());
+            })));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(100, 3)
+        .buildVectors(100, 3)
+        .joinType(testData.joinType)
+        .referenceQuery(testData.referenceQuery)
+        .injectSpill(false)
+        .spillDirectory(tempDirectory->getPath())
+        .config(core::QueryConfig::kSpillRowFormatEnabled, "true")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          ASSERT_TRUE(spillTriggered);
+          const auto spilledRows = taskSpilledStats(*task).first.spilledRows;
+          ASSERT_GT(spilledRows, 0);
+          auto opStats = toOperatorStats(task->taskStats());
+          ASSERT_EQ(
+              opStats.at("HashBuild")
+                  .runtimeStats[HashBuild::kSerializedSpillRows]
+                  .sum,
+              spilledRows);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, hybridSpill) {
+  struct {
+    core::JoinType joinType;
+    std::string referenceQuery;
+
+    std::string debugString() const {
+      return fmt::format("joinType: {}", core::joinTypeName(joinType));
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0"},
+      {core::JoinType::kLeft,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t LEFT JOIN u "
+       "ON t.t_k0 = u.u_k0"},
+      {core::JoinType::kRight,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t RIGHT JOIN u "
+       "ON t.t_k0 = u.u_k0"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(100, 3)
+        .buildVectors(100, 3)
+        .joinType(testData.joinType)
+        .referenceQuery(testData.referenceQuery)
+        .config(core::QueryConfig::kJoinHybridSpillEnabled, "true")
+        .checkSpillStats(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!hasSpill) {
+            return;
+          }
+          const auto statsPair = taskSpilledStats(*task);
+          if (statsPair.first.spilledRows == 0) {
+            return;
+          }
+          // The spilled build partitions fit in memory in this test, so they
+          // are reloaded into the join table.
+          auto opStats = toOperatorStats(task->taskStats());
+          ASSERT_GT(
+              opStats.at("HashBuild")
+                  .runtimeStats[HashBuild::kHybridReloadedPartitions]
+                  .sum,
+              0);
+        })
+        .run();
+  }
+}
+
+// Verifies the hybrid spill with some spilled build partitions reloaded into
+// the join table while the others stay on disk, so that the probe side joins
+// part of its input in memory and spills the rest.
+DEBUG_ONLY_TEST_F(HashJoinTest, hybridSpillWithResidentAndSpilledPartitions) {
+  struct {
+    core::JoinType joinType;
+    std::string referenceQuery;
+
+    std::string debugString() const {
+      return fmt::format("joinType: {}", core::joinTypeName(joinType));
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0"},
+      {core::JoinType::kRight,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t RIGHT JOIN u "
+       "ON t.t_k0 = u.u_k0"},
+      {core::JoinType::kFull,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t FULL OUTER JOIN u "
+       "ON t.t_k0 = u.u_k0"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
+    auto queryPool = memory::memoryManager()->addRootPool(
+        "", kMaxBytes, memory::MemoryReclaimer::create());
+    // Only lets the first spilled partition reservation succeed, and fails the
+    // others by asking for more memory than the query pool capacity.
+    std::atomic_int numReservations{0};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::HashBuild::reloadSpilledPartitions",
+        std::function<void(uint64_t*)>([&](uint64_t* memoryBytesToReserve) {
+          if (numReservations++ > 0) {
+            *memoryBytesToReserve = 2 * kMaxBytes;
+          }
+        }));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(100, 3)
+        .buildVectors(100, 3)
+        .joinType(testData.joinType)
+        .referenceQuery(testData.referenceQuery)
+        .queryPool(std::move(queryPool))
+        .config(core::QueryConfig::kJoinHybridSpillEnabled, "true")
+        .injectSpill(true)
+        .maxSpillLevel(0)
+        .checkSpillStats(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!hasSpill || numReservations == 0) {
+            return;
+          }
+          auto opStats = toOperatorStats(task->taskStats());
+          ASSERT_EQ(
+              opStats.at("HashBuild")
+                  .runtimeStats[HashBuild::kHybridReloadedPartitions]
+                  .sum,
+              1);
+          if (numReservations > 1) {
+            // The probe rows of the partitions left on disk are spilled.
+            ASSERT_GT(taskSpilledStats(*task).second.spilledRows, 0);
+          }
+          numReservations = 0;
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, spillPartitionBitsOverlap) {
   auto builder =
       HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/NumaDriverExecutor.h"
+
+#include <folly/synchronization/Latch.h>
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/memory/Numa.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+TEST(NumaDriverExecutorTest, acquireNode) {
+  NumaDriverExecutor executor(2, 2);
+  ASSERT_EQ(executor.numNodes(), 2);
+  ASSERT_EQ(executor.threadsPerNode(), 2);
+
+  // More Drivers than threads of a node.
+  ASSERT_EQ(executor.acquireNode(3), memory::kNoNumaNode);
+
+  // The least loaded node is assigned.
+  ASSERT_EQ(executor.acquireNode(2), 0);
+  ASSERT_EQ(executor.acquireNode(1), 1);
+  ASSERT_EQ(executor.numNodeDrivers(0), 2);
+  ASSERT_EQ(executor.numNodeDrivers(1), 1);
+
+  // Node 1 has one free thread left and node 0 none.
+  ASSERT_EQ(executor.acquireNode(2), memory::kNoNumaNode);
+  ASSERT_EQ(executor.acquireNode(1), 1);
+  ASSERT_EQ(executor.acquireNode(1), memory::kNoNumaNode);
+
+  executor.releaseNode(0, 2);
+  ASSERT_EQ(executor.numNodeDrivers(0), 0);
+  ASSERT_EQ(executor.acquireNode(2), 0);
+
+  VELOX_ASSERT_THROW(executor.releaseNode(1, 3), "");
+  executor.releaseNode(1, 2);
+  executor.releaseNode(0, 2);
+  ASSERT_EQ(executor.numNodeDrivers(0), 0);
+  ASSERT_EQ(executor.numNodeDrivers(1), 0);
+}
+
+TEST(NumaDriverExecutorTest, nodeThreads) {
+  constexpr int32_t kNumNodes = 2;
+  NumaDriverExecutor executor(2, kNumNodes);
+  VELOX_ASSERT_THROW(executor.nodeExecutor(kNumNodes), "");
+
+  // The threads of a node prefer the memory of the node.
+  std::array<int32_t, kNumNodes> preferredNodes;
+  folly::Latch nodesDone(kNumNodes);
+  for (auto node = 0; node < kNumNodes; ++node) {
+    executor.nodeExecutor(node)->add([&, node]() {
+      preferredNodes[node] = memory::numaPreferredNode();
+      nodesDone.count_down();
+    });
+  }
+  nodesDone.wait();
+  for (auto node = 0; node < kNumNodes; ++node) {
+    ASSERT_EQ(preferredNodes[node], node);
+  }
+
+  // add() goes to the nodes in round robin order.
+  std::array<int32_t, 2 * kNumNodes> addNodes;
+  folly::Latch addsDone(addNodes.size());
+  for (auto i = 0; i < addNodes.size(); ++i) {
+    executor.add([&, i]() {
+      addNodes[i] = memory::numaPreferredNode();
+      addsDone.count_down();
+    });
+  }
+  addsDone.wait();
+  for (auto i = 0; i < addNodes.size(); ++i) {
+    ASSERT_EQ(addNodes[i], i % kNumNodes);
+  }
+}
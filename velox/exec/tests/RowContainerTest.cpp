@@ -1452,6 +1452,57 @@ TEST_F(RowContainerTest, columnSize) {
   }
 }
 
+TEST_F(RowContainerTest, compactStringAllocator) {
+  constexpr int32_t kNumRows = 10'000;
+  auto data = makeRowContainer({VARCHAR()}, {ARRAY(BIGINT())});
+  ASSERT_TRUE(data->canCompactStringAllocator());
+
+  auto keys = makeFlatVector<std::string>(kNumRows, [](auto row) {
+    return std::string(20 + row % 200, 'a' + row % 26);
+  });
+  auto arrays = makeArrayVector<int64_t>(
+      kNumRows,
+      [](auto row) { return row % 50; },
+      [](auto row, auto index) { return row + index; });
+  DecodedVector decodedKeys(*keys);
+  DecodedVector decodedArrays(*arrays);
+  std::vector<char*> rows;
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows.push_back(data->newRow());
+    data->store(decodedKeys, i, rows.back(), 0);
+    data->store(decodedArrays, i, rows.back(), 1);
+  }
+
+  // Erase 3 out of 4 rows to fragment the variable width data.
+  std::vector<char*> erased;
+  std::vector<char*> remaining;
+  std::vector<vector_size_t> remainingIndices;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 4 == 0) {
+      remaining.push_back(rows[i]);
+      remainingIndices.push_back(i);
+    } else {
+      erased.push_back(rows[i]);
+    }
+  }
+  data->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+
+  const auto allocatedBytes = data->allocatedBytes();
+  EXPECT_GT(data->compactStringAllocator(), 0);
+  EXPECT_LT(data->allocatedBytes(), allocatedBytes);
+  data->stringAllocator().checkConsistency();
+
+  auto indices = makeIndices(
+      remainingIndices.size(), [&](auto row) { return remainingIndices[row]; });
+  auto extractedKeys = BaseVector::create(VARCHAR(), remaining.size(), pool());
+  data->extractColumn(remaining.data(), remaining.size(), 0, extractedKeys);
+  assertEqualVectors(wrapInDictionary(indices, keys), extractedKeys);
+  auto extractedArrays =
+      BaseVector::create(ARRAY(BIGINT()), remaining.size(), pool());
+  data->extractColumn(remaining.data(), remaining.size(), 1, extractedArrays);
+  assertEqualVectors(wrapInDictionary(indices, arrays), extractedArrays);
+}
+
 TEST_F(RowContainerTest, rowSizeWithNormalizedKey) {
   auto data = makeRowContainer({SMALLINT()}, {VARCHAR()});
   data->newRow();
@@ -2107,6 +2158,74 @@ TEST_F(RowContainerTest, extractSerializedRow) {
   }
 }
 
+TEST_F(RowContainerTest, storeSerializedRows) {
+  // Hash join build layout with non-nullable keys, a probed flag and a mix of
+  // fixed and variable width dependent columns.
+  RowContainer rowContainer(
+      std::vector<TypePtr>{BIGINT(), INTEGER()}, // keyTypes
+      false, // nullableKeys
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{VARCHAR(), BIGINT(), SMALLINT()}, // dependentTypes
+      true, // hasNext
+      true, // isJoinBuild
+      true, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get());
+
+  const auto size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) { return std::string(row % 31, 'a' + row % 26); },
+          nullEvery(5)),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 3; }, nullEvery(3)),
+      makeFlatVector<int16_t>(
+          size, [](auto row) { return row % 11; }, nullEvery(4)),
+  });
+  auto rows = store(rowContainer, data);
+  for (auto i = 0; i < size; i += 2) {
+    rowContainer.setProbedFlag(rows.data() + i, 1);
+  }
+  auto expectedProbedFlags =
+      BaseVector::create<FlatVector<bool>>(BOOLEAN(), size, pool());
+  rowContainer.extractProbedFlags(
+      rows.data(), size, false, false, expectedProbedFlags);
+
+  auto serialized =
+      BaseVector::create<FlatVector<StringView>>(VARBINARY(), size, pool());
+  rowContainer.extractSerializedRows(
+      folly::Range(rows.data(), rows.size()), serialized);
+
+  rowContainer.clear();
+  rows.clear();
+  for (auto i = 0; i < size; ++i) {
+    rows.push_back(rowContainer.newRow());
+  }
+  rowContainer.storeSerializedRows(
+      *serialized, folly::Range(rows.data(), rows.size()));
+  ASSERT_EQ(rowContainer.numRows(), size);
+
+  auto copy = BaseVector::create<RowVector>(data->type(), size, pool());
+  for (auto i = 0; i < copy->childrenSize(); ++i) {
+    rowContainer.extractColumn(rows.data(), size, i, copy->childAt(i));
+  }
+  assertEqualVectors(data, copy);
+
+  auto probedFlags =
+      BaseVector::create<FlatVector<bool>>(BOOLEAN(), size, pool());
+  rowContainer.extractProbedFlags(rows.data(), size, false, false, probedFlags);
+  assertEqualVectors(expectedProbedFlags, probedFlags);
+
+  ASSERT_FALSE(rowContainer.columnHasNulls(0));
+  ASSERT_FALSE(rowContainer.columnHasNulls(1));
+  for (auto i = 2; i < copy->childrenSize(); ++i) {
+    ASSERT_TRUE(rowContainer.columnHasNulls(i));
+  }
+}
+
 DEBUG_ONLY_TEST_F(RowContainerTest, eraseAfterOomStoringString) {
   auto rowContainer = makeRowContainer({VARCHAR()}, {});
 
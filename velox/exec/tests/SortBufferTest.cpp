@@ -353,6 +353,55 @@ TEST_P(SortBufferTest, DISABLED_randomData) {
   }
 }
 
+TEST_P(SortBufferTest, parallelSort) {
+  const std::shared_ptr<memory::MemoryPool> fuzzerPool =
+      memory::memoryManager()->addLeafPool("parallelSort");
+  VectorFuzzer fuzzer({.vectorSize = 1000, .nullRatio = 0.1}, fuzzerPool.get());
+  std::vector<RowVectorPtr> inputVectors;
+  for (int i = 0; i < 5; ++i) {
+    inputVectors.push_back(fuzzer.fuzzRow(inputType_));
+  }
+
+  const auto sort = [&](ParallelSortConfig parallelSortConfig) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        pool_.get(),
+        &nonReclaimableSection_,
+        prefixSortConfig_,
+        nullptr,
+        nullptr,
+        parallelSortConfig);
+    for (const auto& input : inputVectors) {
+      sortBuffer->addInput(input);
+    }
+    sortBuffer->noMoreInput();
+    auto output = sortBuffer->getOutput(10'000);
+    EXPECT_EQ(output->size(), 5'000);
+    EXPECT_EQ(sortBuffer->getOutput(10'000), nullptr);
+    return output;
+  };
+
+  const auto expected = sort({});
+  for (const auto& parallelSortConfig :
+       {ParallelSortConfig{executor_.get(), 1, 2},
+        ParallelSortConfig{executor_.get(), 1, 7},
+        ParallelSortConfig{executor_.get(), 1'000, 16},
+        ParallelSortConfig{executor_.get(), 10'000, 4}}) {
+    SCOPED_TRACE(fmt::format(
+        "minRows: {}, parallelism: {}",
+        parallelSortConfig.minRows,
+        parallelSortConfig.parallelism));
+    const auto output = sort(parallelSortConfig);
+    // Rows with equal sort keys can be output in any order.
+    for (const auto channel : sortColumnIndices_) {
+      velox::test::assertEqualVectors(
+          expected->childAt(channel), output->childAt(channel));
+    }
+  }
+}
+
 TEST_P(SortBufferTest, batchOutput) {
   struct {
     bool triggerSpill;
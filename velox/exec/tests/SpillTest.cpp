@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -663,6 +664,102 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, asyncWriteAndReadAhead) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const std::optional<common::PrefixSortConfig> prefixSortConfig =
+      enablePrefixSort_
+      ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig())
+      : std::nullopt;
+  for (const auto targetFileSize : std::vector<uint64_t>{1, kGB}) {
+    SCOPED_TRACE(fmt::format("targetFileSize: {}", targetFileSize));
+    SpillState state(
+        [&]() -> const std::string& { return tempDir_->getPath(); },
+        updateSpilledBytesCb_,
+        "async",
+        SpillState::makeSortingKeys(std::vector<CompareFlags>(1)),
+        targetFileSize,
+        0,
+        compressionKind_,
+        prefixSortConfig,
+        pool(),
+        &spillStats_,
+        "",
+        executor.get());
+    const SpillPartitionId partitionId{0};
+    state.setPartitionSpilled(partitionId);
+    const auto prevWriteTimeNs = spillStats_.rlock()->spillWriteTimeNanos;
+
+    // Each batch holds a sorted run of consecutive values. All the batches are
+    // written into the same sorted file if 'targetFileSize' is large,
+    // otherwise each batch goes to its own file.
+    const int32_t numBatches = 10;
+    const int32_t numRowsPerBatch = 1'000;
+    for (auto i = 0; i < numBatches; ++i) {
+      state.appendToPartition(
+          partitionId,
+          makeRowVector({makeFlatVector<int64_t>(
+              numRowsPerBatch,
+              [&](auto row) { return i * numRowsPerBatch + row; })}));
+    }
+    auto spillFiles = state.finish(partitionId);
+    ASSERT_EQ(spillFiles.size(), targetFileSize == 1 ? numBatches : 1);
+    // The time spent in the asynchronous writes is reported.
+    ASSERT_GT(spillStats_.rlock()->spillWriteTimeNanos, prevWriteTimeNs);
+    uint64_t totalFileBytes{0};
+    auto fs = filesystems::getFileSystem(tempDir_->getPath(), nullptr);
+    for (const auto& spillFile : spillFiles) {
+      ASSERT_EQ(spillFile.size, fs->openFileForRead(spillFile.path)->size());
+      totalFileBytes += spillFile.size;
+    }
+    ASSERT_GT(totalFileBytes, 0);
+
+    auto readAheadPool = rootPool_->addLeafChild("readAhead");
+    SpillPartition orderedPartition(partitionId, spillFiles);
+    auto merge = orderedPartition.createOrderedReader(
+        1 << 20, pool(), &spillStats_, executor.get(), readAheadPool.get());
+    ASSERT_NE(merge, nullptr);
+    for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+
+    SpillPartition unorderedPartition(partitionId, spillFiles);
+    auto reader = unorderedPartition.createUnorderedReader(
+        1 << 20, pool(), &spillStats_, executor.get(), readAheadPool.get());
+    int64_t numRows{0};
+    RowVectorPtr batch;
+    while (reader->nextBatch(batch)) {
+      // The read-ahead batches are allocated from the read-ahead pool.
+      ASSERT_EQ(batch->pool(), readAheadPool.get());
+      numRows += batch->size();
+    }
+    ASSERT_EQ(numRows, numBatches * numRowsPerBatch);
+
+    // Destroys a reader with an outstanding read-ahead.
+    SpillPartition abandonedPartition(partitionId, spillFiles);
+    reader = abandonedPartition.createUnorderedReader(
+        1 << 20, pool(), &spillStats_, executor.get(), readAheadPool.get());
+    ASSERT_TRUE(reader->nextBatch(batch));
+    batch.reset();
+    reader.reset();
+    ASSERT_EQ(readAheadPool->usedBytes(), 0);
+
+    // Without a read-ahead pool the reads are synchronous from the caller's
+    // pool.
+    SpillPartition syncPartition(partitionId, spillFiles);
+    reader = syncPartition.createUnorderedReader(
+        1 << 20, pool(), &spillStats_, executor.get());
+    ASSERT_TRUE(reader->nextBatch(batch));
+    ASSERT_EQ(batch->pool(), pool());
+    batch.reset();
+    reader.reset();
+  }
+  executor->join();
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
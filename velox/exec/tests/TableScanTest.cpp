@@ -3849,6 +3849,81 @@ TEST_F(TableScanTest, aggregationPushdown) {
   EXPECT_EQ(0, loadedToValueHook(task));
 }
 
+TEST_F(TableScanTest, globalAggregationPushdown) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto loadedToValueHook = [](const std::shared_ptr<Task> task) {
+    auto stats =
+        task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+    auto it = stats.find("loadedToValueHook");
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  auto op = PlanBuilder()
+                .tableScan(rowType_)
+                .singleAggregation(
+                    {}, {"sum(c0)", "min(c1)", "max(c2)", "sum(c3)", "max(c4)"})
+                .planNode();
+  auto task = assertQuery(
+      op,
+      {filePath},
+      "SELECT sum(c0), min(c1), max(c2), sum(c3), max(c4) FROM tmp");
+  // 5 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(5 * 10'000, loadedToValueHook(task));
+
+  // count(x) counts the non-null values in the reader, with and without
+  // grouping keys.
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation({}, {"count(c0)", "count(c4)", "count(c5)"})
+           .planNode();
+  task = assertQuery(
+      op, {filePath}, "SELECT count(c0), count(c4), count(c5) FROM tmp");
+  // 3 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(3 * 10'000, loadedToValueHook(task));
+
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation({"c5"}, {"count(c0)", "count(c1)"})
+           .planNode();
+  task = assertQuery(
+      op, {filePath}, "SELECT c5, count(c0), count(c1) FROM tmp GROUP BY 1");
+  // 2 aggregates processing 10K rows each via pushdown. The grouping key is
+  // loaded before the aggregates run.
+  EXPECT_EQ(2 * 10'000, loadedToValueHook(task));
+
+  // Rows dropped by a remaining filter are not aggregated. The aggregates
+  // still push down through the dictionary the filter wraps the lazy columns
+  // in.
+  auto countPlan = PlanBuilder()
+                       .values(vectors)
+                       .filter("length(c5) % 2 = 0")
+                       .singleAggregation({}, {"count(1)"})
+                       .planNode();
+  const auto numPassed = AssertQueryBuilder(countPlan)
+                             .copyResults(pool())
+                             ->childAt(0)
+                             ->asFlatVector<int64_t>()
+                             ->valueAt(0);
+  ASSERT_GT(numPassed, 0);
+  ASSERT_LT(numPassed, 10'000);
+  op = PlanBuilder()
+           .startTableScan()
+           .outputType(rowType_)
+           .remainingFilter("length(c5) % 2 = 0")
+           .endTableScan()
+           .singleAggregation({}, {"sum(c0)", "count(c1)"})
+           .planNode();
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT sum(c0), count(c1) FROM tmp WHERE length(c5) % 2 = 0");
+  EXPECT_EQ(2 * numPassed, loadedToValueHook(task));
+}
+
 TEST_F(TableScanTest, decimalDisableAggregationPushdown) {
   vector_size_t size = 1'000;
   auto rowVector = makeRowVector({
@@ -20,11 +20,13 @@
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/Numa.h"
 #include "velox/common/memory/SharedArbitrator.h"
 #include "velox/common/memory/tests/SharedArbitratorTestUtil.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/exec/Cursor.h"
+#include "velox/exec/NumaDriverExecutor.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
@@ -1384,6 +1386,69 @@ DEBUG_ONLY_TEST_F(TaskTest, outputDriverFinishEarly) {
 }
 
 /// Test that we export operator stats for unfinished (running) operators.
+DEBUG_ONLY_TEST_F(TaskTest, numaNodeAssignment) {
+  auto numaExecutor = std::make_unique<NumaDriverExecutor>(2, 2);
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  const auto plan =
+      PlanBuilder().values({data}, true).project({"c0 + 1"}).planNode();
+
+  std::mutex mutex;
+  std::set<int32_t> driverNodes;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>([&](Operator* /*op*/) {
+        std::lock_guard<std::mutex> l(mutex);
+        driverNodes.insert(memory::numaPreferredNode());
+      }));
+
+  // The 2 Drivers fit on one node. They run on its threads and the task pool
+  // prefers its memory.
+  std::shared_ptr<Task> task;
+  auto result = AssertQueryBuilder(plan)
+                    .queryCtx(core::QueryCtx::create(numaExecutor.get()))
+                    .maxDrivers(2)
+                    .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 2 * data->size());
+  ASSERT_EQ(task->numaNode(), 0);
+  ASSERT_EQ(task->pool()->preferredNumaNode(), 0);
+  ASSERT_EQ(driverNodes, std::set<int32_t>{0});
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  // The Drivers are released on termination.
+  ASSERT_EQ(numaExecutor->numNodeDrivers(0), 0);
+
+  // Another task goes to the other node while the first one holds node 0.
+  ASSERT_EQ(numaExecutor->acquireNode(2), 0);
+  driverNodes.clear();
+  result = AssertQueryBuilder(plan)
+               .queryCtx(core::QueryCtx::create(numaExecutor.get()))
+               .maxDrivers(2)
+               .copyResults(pool(), task);
+  ASSERT_EQ(task->numaNode(), 1);
+  ASSERT_EQ(driverNodes, std::set<int32_t>{1});
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(numaExecutor->numNodeDrivers(1), 0);
+
+  // No node has a free thread for 2 more Drivers. The task is not assigned a
+  // node.
+  ASSERT_EQ(numaExecutor->acquireNode(1), 1);
+  result = AssertQueryBuilder(plan)
+               .queryCtx(core::QueryCtx::create(numaExecutor.get()))
+               .maxDrivers(2)
+               .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 2 * data->size());
+  ASSERT_EQ(task->numaNode(), memory::kNoNumaNode);
+  ASSERT_EQ(task->pool()->preferredNumaNode(), memory::kNoNumaNode);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(numaExecutor->numNodeDrivers(0), 2);
+  ASSERT_EQ(numaExecutor->numNodeDrivers(1), 1);
+  numaExecutor->releaseNode(0, 2);
+  numaExecutor->releaseNode(1, 1);
+  task.reset();
+  waitForAllTasksToBeDeleted();
+}
+
 DEBUG_ONLY_TEST_F(TaskTest, liveStats) {
   constexpr int32_t numBatches = 10;
   std::vector<RowVectorPtr> dataBatches;
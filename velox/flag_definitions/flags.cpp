@@ -120,6 +120,19 @@ DEFINE_bool(
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
 
+DEFINE_int64(
+    velox_memory_hugepage_align_bytes,
+    0,
+    "Contiguous allocations of at least this many bytes are mapped at a huge "
+    "page aligned address so that all of their memory can be backed by huge "
+    "pages. 0 disables the alignment");
+
+DEFINE_bool(
+    velox_memory_prefault_hugepages,
+    false,
+    "Fault in the huge pages of contiguous allocations when they are "
+    "allocated or grown instead of on first access");
+
 DEFINE_int32(
     cache_prefetch_min_pct,
     80,
@@ -83,6 +83,12 @@ class AverageAggregateBase : public exec::Aggregate {
     return sizeof(SumCount<TAccumulator>);
   }
 
+  /// The SumCount accumulators are fixed width values. Subclasses that keep
+  /// them opt in to relocation by overriding supportsAccumulatorRelocation().
+  void relocateAccumulators(
+      folly::Range<char**> /*groups*/,
+      const HashStringAllocator::Relocator& /*relocator*/) override {}
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     auto vector = (*result)->as<FlatVector<TResult>>();
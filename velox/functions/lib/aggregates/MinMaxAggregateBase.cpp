@@ -45,6 +45,10 @@ class SimpleNumericMinMaxAggregate : public SimpleNumericAggregate<T, T, T> {
     return sizeof(T);
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+
   int32_t accumulatorAlignmentSize() const override {
     if constexpr (std::is_same_v<T, int128_t>) {
       // Override 'accumulatorAlignmentSize' for UnscaledLongDecimal values as
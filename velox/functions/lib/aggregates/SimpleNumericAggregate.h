@@ -34,6 +34,13 @@ class SimpleNumericAggregate : public exec::Aggregate {
     extractValues(groups, numGroups, result);
   }
 
+  /// Subclasses whose accumulators are fixed width values opt in to
+  /// relocation by overriding supportsAccumulatorRelocation(). There is
+  /// nothing to relocate for them.
+  void relocateAccumulators(
+      folly::Range<char**> /*groups*/,
+      const HashStringAllocator::Relocator& /*relocator*/) override {}
+
  protected:
   template <typename T>
   static constexpr bool kMayPushdown = !std::is_same_v<T, int128_t> &&
@@ -163,8 +170,22 @@ class SimpleNumericAggregate : public exec::Aggregate {
       const VectorPtr& arg,
       UpdateSingle updateSingleValue,
       UpdateDuplicate updateDuplicateValues,
-      bool /*mayPushdown*/,
+      bool mayPushdown,
       TData initialValue) {
+    if constexpr (kMayPushdown<TData>) {
+      if (mayPushdown && isPushdownInput(arg) && !arg->type()->isDecimal()) {
+        velox::aggregate::SimpleCallableHook<TData, UpdateSingle> hook(
+            exec::Aggregate::offset_,
+            exec::Aggregate::nullByte_,
+            exec::Aggregate::nullMask_,
+            singleGroupRows(group, arg->size()),
+            &this->exec::Aggregate::numNulls_,
+            updateSingleValue);
+        loadWithHook(rows, arg, hook);
+        return;
+      }
+    }
+
     DecodedVector decoded(*arg, rows);
 
     // Do row by row if not all rows are selected.
@@ -198,17 +219,48 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // True if 'arg' is a lazy vector, either bare or wrapped in a dictionary
+  // without nulls, e.g. by a remaining filter of the table scan. The wrapped
+  // rows are loaded through the dictionary indices.
+  static bool isPushdownInput(const VectorPtr& arg) {
+    if (arg->isLazy()) {
+      return true;
+    }
+    return arg->encoding() == VectorEncoding::Simple::DICTIONARY &&
+        arg->rawNulls() == nullptr && arg->valueVector()->isLazy();
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
-    DecodedVector decoded(*arg, rows, false);
-    const vector_size_t* indices = decoded.indices();
     THook hook(
         exec::Aggregate::offset_,
         exec::Aggregate::nullByte_,
         exec::Aggregate::nullMask_,
         groups,
         &this->exec::Aggregate::numNulls_);
+    loadWithHook(rows, arg, hook);
+  }
+
+  // Same as pushdown() for a global aggregation that accumulates all 'rows'
+  // of the lazy 'arg' into 'group'.
+  template <typename THook>
+  void pushdownOneGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    pushdown<THook>(singleGroupRows(group, arg->size()), rows, arg);
+  }
+
+ private:
+  // Loads the selected 'rows' of the lazy 'arg' into 'hook' without
+  // materializing the values.
+  void loadWithHook(
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      ValueHook& hook) {
+    DecodedVector decoded(*arg, rows, false);
+    const vector_size_t* indices = decoded.indices();
     // The decoded vector does not really keep the info from the 'rows', except
     // for the 'upper bound' of it. In case not all rows are selected we need to
     // generate proper indices, which we 'indirect' through the ones we got from
@@ -231,7 +283,13 @@ class SimpleNumericAggregate : public exec::Aggregate {
         RowSet(indices, numIndices), &hook);
   }
 
- private:
+  // Returns 'numRows' copies of 'group'. The hooks find the group of a value
+  // by its row number.
+  char** singleGroupRows(char* group, vector_size_t numRows) {
+    pushdownGroups_.assign(numRows, group);
+    return pushdownGroups_.data();
+  }
+
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
   template <
@@ -245,6 +303,10 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  // Repeats the single group of a global aggregation once per input row so
+  // that pushdown hooks can look it up by row number.
+  std::vector<char*> pushdownGroups_;
 };
 
 } // namespace facebook::velox::functions::aggregate
@@ -41,6 +41,10 @@ class SumAggregateBase
     return sizeof(TAccumulator);
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+
   int32_t accumulatorAlignmentSize() const override {
     return 1;
   }
@@ -85,6 +89,12 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (mayPushdown && BaseAggregate::isPushdownInput(args[0])) {
+      BaseAggregate::template pushdownOneGroup<
+          facebook::velox::aggregate::SumHook<TAccumulator, Overflow>>(
+          group, rows, args[0]);
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator>(
         group,
         rows,
@@ -102,6 +102,20 @@ void ValueList::appendRange(
   }
 }
 
+void ValueList::relocate(const HashStringAllocator::Relocator& relocator) {
+  // The relocated copies keep the logical offsets of the current positions.
+  if (nullsBegin_ != nullptr) {
+    const auto offset = HashStringAllocator::offset(nullsBegin_, nullsCurrent_);
+    nullsBegin_ = relocator(nullsBegin_);
+    nullsCurrent_ = HashStringAllocator::seek(nullsBegin_, offset);
+  }
+  if (dataBegin_ != nullptr) {
+    const auto offset = HashStringAllocator::offset(dataBegin_, dataCurrent_);
+    dataBegin_ = relocator(dataBegin_);
+    dataCurrent_ = HashStringAllocator::seek(dataBegin_, offset);
+  }
+}
+
 ValueListReader::ValueListReader(ValueList& values)
     : size_{values.size()},
       lastNullsStart_{size_ % 64 == 0 ? size_ - 64 : size_ - size_ % 64},
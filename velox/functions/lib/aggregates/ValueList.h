@@ -71,6 +71,10 @@ class ValueList {
     return lastNulls_;
   }
 
+  // Moves the allocations of 'this' with 'relocator'. See
+  // HashStringAllocator::compact().
+  void relocate(const HashStringAllocator::Relocator& relocator);
+
   void free(HashStringAllocator* allocator) {
     if (size_) {
       allocator->free(nullsBegin_);
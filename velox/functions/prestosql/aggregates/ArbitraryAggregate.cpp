@@ -40,6 +40,10 @@ class ArbitraryAggregate : public SimpleNumericAggregate<T, T, T> {
     return sizeof(T);
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+
   int32_t accumulatorAlignmentSize() const override {
     return 1;
   }
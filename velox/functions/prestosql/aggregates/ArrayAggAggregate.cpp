@@ -61,6 +61,24 @@ class ArrayAggAggregate : public exec::Aggregate {
     return true;
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+
+  void relocateAccumulators(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocator& relocator) override {
+    if (clusteredInput_) {
+      // The clustered accumulators only reference the input vectors.
+      return;
+    }
+    for (auto* group : groups) {
+      if (isInitialized(group)) {
+        value<ArrayAccumulator>(group)->elements.relocate(relocator);
+      }
+    }
+  }
+
   void toIntermediate(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -22,6 +22,22 @@ using namespace facebook::velox::functions::aggregate;
 
 namespace facebook::velox::aggregate::prestosql {
 
+namespace {
+
+template <typename TInput, typename TAccumulator, typename TResult>
+class AverageAggregate
+    : public AverageAggregateBase<TInput, TAccumulator, TResult> {
+ public:
+  explicit AverageAggregate(TypePtr resultType)
+      : AverageAggregateBase<TInput, TAccumulator, TResult>(resultType) {}
+
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+};
+
+} // namespace
+
 /// Count is BIGINT() while sum and the final aggregates type depends on
 /// the input types:
 ///       INPUT TYPE    |     SUM             |     AVG
@@ -84,10 +100,10 @@ void registerAverageAggregate(
           switch (inputType->kind()) {
             case TypeKind::SMALLINT:
               return std::make_unique<
-                  AverageAggregateBase<int16_t, double, double>>(resultType);
+                  AverageAggregate<int16_t, double, double>>(resultType);
             case TypeKind::INTEGER:
               return std::make_unique<
-                  AverageAggregateBase<int32_t, double, double>>(resultType);
+                  AverageAggregate<int32_t, double, double>>(resultType);
             case TypeKind::BIGINT: {
               if (inputType->isShortDecimal()) {
                 return std::make_unique<DecimalAverageAggregateBase<int64_t>>(
@@ -95,10 +111,10 @@ void registerAverageAggregate(
               }
               if (inputType->isIntervalDayTime()) {
                 return std::make_unique<
-                    AverageAggregateBase<int64_t, double, int64_t>>(resultType);
+                    AverageAggregate<int64_t, double, int64_t>>(resultType);
               }
               return std::make_unique<
-                  AverageAggregateBase<int64_t, double, double>>(resultType);
+                  AverageAggregate<int64_t, double, double>>(resultType);
             }
             case TypeKind::HUGEINT: {
               if (inputType->isLongDecimal()) {
@@ -109,10 +125,10 @@ void registerAverageAggregate(
             }
             case TypeKind::REAL:
               return std::make_unique<
-                  AverageAggregateBase<float, double, float>>(resultType);
+                  AverageAggregate<float, double, float>>(resultType);
             case TypeKind::DOUBLE:
               return std::make_unique<
-                  AverageAggregateBase<double, double, double>>(resultType);
+                  AverageAggregate<double, double, double>>(resultType);
             default:
               VELOX_FAIL(
                   "Unknown input type for {} aggregation {}",
@@ -124,11 +140,11 @@ void registerAverageAggregate(
           switch (resultType->kind()) {
             case TypeKind::REAL:
               return std::make_unique<
-                  AverageAggregateBase<int64_t, double, float>>(resultType);
+                  AverageAggregate<int64_t, double, float>>(resultType);
             case TypeKind::DOUBLE:
             case TypeKind::ROW:
               return std::make_unique<
-                  AverageAggregateBase<int64_t, double, double>>(resultType);
+                  AverageAggregate<int64_t, double, double>>(resultType);
             case TypeKind::BIGINT:
               return std::make_unique<DecimalAverageAggregateBase<int64_t>>(
                   resultType);
@@ -35,6 +35,10 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     return sizeof(int64_t);
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return true;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     BaseAggregate::doExtractValues(groups, numGroups, result, [&](char* group) {
@@ -46,12 +50,18 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char** groups,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
       return;
     }
 
+    if (mayPushdown && canPushdown(args[0])) {
+      BaseAggregate::pushdown<velox::aggregate::CountHook>(
+          groups, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -85,12 +95,18 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       addToGroup(group, rows.countSelected());
       return;
     }
 
+    if (mayPushdown && canPushdown(args[0])) {
+      BaseAggregate::pushdownOneGroup<velox::aggregate::CountHook>(
+          group, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -143,6 +159,28 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
   }
 
  private:
+  // True if the non-null values of the lazy 'arg' can be counted by the
+  // column reader without materializing them.
+  static bool canPushdown(const VectorPtr& arg) {
+    if (!BaseAggregate::isPushdownInput(arg)) {
+      return false;
+    }
+    switch (arg->typeKind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
@@ -33,6 +33,9 @@ template <
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct MapAccumulator {
+  /// True if relocate() is supported.
+  static constexpr bool kRelocatable = true;
+
   // Value is the index of the corresponding entry in 'values'.
   folly::F14FastMap<
       T,
@@ -104,6 +107,14 @@ struct MapAccumulator {
     }
   }
 
+  /// Moves the allocations of 'this' with 'relocator'. 'keys' is rebuilt in
+  /// new blocks. See HashStringAllocator::compact().
+  void relocate(const HashStringAllocator::Relocator& relocator) {
+    auto relocatedKeys = keys;
+    keys.swap(relocatedKeys);
+    values.relocate(relocator);
+  }
+
   void free(HashStringAllocator& allocator) {
     std::destroy_at(&keys);
     values.free(&allocator);
@@ -112,6 +123,9 @@ struct MapAccumulator {
 
 /// Maintains a map with string keys.
 struct StringViewMapAccumulator {
+  /// The keys in 'strings' are not relocatable.
+  static constexpr bool kRelocatable = false;
+
   /// A set of unique StringViews pointing to storage managed by 'strings'.
   MapAccumulator<StringView> base;
 
@@ -159,6 +173,9 @@ struct StringViewMapAccumulator {
 
 /// Maintains a map with keys of type array, map or struct.
 struct ComplexTypeMapAccumulator {
+  /// The keys in 'serializedKeys' are not relocatable.
+  static constexpr bool kRelocatable = false;
+
   /// A set of pointers to values stored in AddressableNonNullValueList.
   MapAccumulator<
       AddressableNonNullValueList::Entry,
@@ -259,6 +276,8 @@ template <TypeKind Kind>
 struct CustomComparisonMapAccumulator {
   using NativeType = typename TypeTraits<Kind>::NativeType;
 
+  static constexpr bool kRelocatable = true;
+
   struct Hash {
     const TypePtr& type;
 
@@ -323,6 +342,10 @@ struct CustomComparisonMapAccumulator {
     base.extractValues(mapValues, offset, mapSize, indices);
   }
 
+  void relocate(const HashStringAllocator::Relocator& relocator) {
+    base.relocate(relocator);
+  }
+
   void free(HashStringAllocator& allocator) {
     base.free(allocator);
   }
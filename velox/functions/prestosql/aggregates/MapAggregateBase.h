@@ -35,6 +35,24 @@ class MapAggregateBase : public exec::Aggregate {
     return false;
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    return AccumulatorType::kRelocatable;
+  }
+
+  void relocateAccumulators(
+      folly::Range<char**> groups,
+      const HashStringAllocator::Relocator& relocator) override {
+    if constexpr (AccumulatorType::kRelocatable) {
+      for (auto* group : groups) {
+        if (isInitialized(group)) {
+          value<AccumulatorType>(group)->relocate(relocator);
+        }
+      }
+    } else {
+      exec::Aggregate::relocateAccumulators(groups, relocator);
+    }
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     auto mapVector = (*result)->as<MapVector>();
@@ -174,5 +174,49 @@ TEST_F(MapAccumulatorTest, rows) {
   test<ComplexType>(values, keys);
 }
 
+TEST_F(MapAccumulatorTest, relocate) {
+  auto keys = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto values = makeFlatVector<std::string>(
+      1'000, [](auto row) { return std::string(row % 100, 'x'); });
+  auto otherValues = makeFlatVector<std::string>(
+      1'000, [](auto row) { return std::string(100, 'y'); });
+
+  // Interleave the allocations of two accumulators and drop one of them to
+  // fragment the allocator.
+  MapAccumulator<int64_t> accumulator{keys->type(), allocator()};
+  std::optional<MapAccumulator<int64_t>> other;
+  other.emplace(keys->type(), allocator());
+  DecodedVector decodedKeys(*keys);
+  DecodedVector decodedValues(*values);
+  DecodedVector decodedOtherValues(*otherValues);
+  for (auto i = 0; i < keys->size(); ++i) {
+    accumulator.insert(decodedKeys, decodedValues, i, *allocator());
+    other->insert(decodedKeys, decodedOtherValues, i, *allocator());
+  }
+  other->values.free(allocator());
+  other.reset();
+
+  const auto freedBytes = allocator()->compact(
+      [&](const auto& relocator) { accumulator.relocate(relocator); });
+  EXPECT_GT(freedBytes, 0);
+
+  auto mapKeys = BaseVector::create(keys->type(), accumulator.size(), pool());
+  auto mapValues =
+      BaseVector::create(values->type(), accumulator.size(), pool());
+  accumulator.extract(mapKeys, mapValues, 0);
+  test::assertEqualVectors(
+      makeMapVector({0}, keys, values), makeMapVector({0}, mapKeys, mapValues));
+
+  // Appends after the relocation continue the relocated values.
+  auto moreKeys =
+      makeFlatVector<int64_t>(100, [](auto row) { return 1'000 + row; });
+  DecodedVector decodedMoreKeys(*moreKeys);
+  for (auto i = 0; i < moreKeys->size(); ++i) {
+    accumulator.insert(decodedMoreKeys, decodedValues, i, *allocator());
+  }
+  ASSERT_EQ(accumulator.size(), 1'100);
+  allocator()->checkConsistency();
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::prestosql
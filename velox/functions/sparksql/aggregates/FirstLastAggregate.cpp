@@ -55,6 +55,11 @@ class FirstLastAggregateBase
     return 1;
   }
 
+  bool supportsAccumulatorRelocation() const override {
+    // Non-numeric values are kept in a SingleValueAccumulator.
+    return numeric;
+  }
+
   void extractValues(char** groups, int32_t numGroups, VectorPtr* result)
       override {
     if constexpr (numeric) {